@@ -0,0 +1,389 @@
+#ifndef ATOMIC_BIT_STRING_H
+#define ATOMIC_BIT_STRING_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "bit_string.h"
+
+/**
+ * Fixed size bit string whose bits are set and reset atomically by concurrent threads without locks, i.e. a visited
+ * set shared by the workers of a parallel graph traversal. <br>
+ * The bits are stored in std::atomic<uint64_t> words, word i holds the bits [64 * i, 64 * (i + 1)) as a word of
+ * @a BitOrder (the same word as bit_string::get_bits(64 * i, 64)), so fetch_or() and fetch_and() update up to 64 bits
+ * of a word with a single atomic instruction.
+ *
+ * Every operation takes a std::memory_order, seq_cst by default as std::atomic. relaxed is enough to only collect
+ * bits, acquire / release are needed when the bits publish other data.
+ *
+ * @example atomic_bit_string visited(number_of_nodes);
+ *          if (!visited.test_and_set(node, std::memory_order_relaxed))
+ *              queue.push(node);
+ */
+template<typename BitOrder>
+class basic_atomic_bit_string {
+
+public:
+
+    static const uint32_t WORD_BITS = 64;
+
+private:
+
+    std::unique_ptr<std::atomic<uint64_t>[]> m_words;
+    uint32_t m_size_in_bits = 0;
+
+    static uint64_t bit_mask(uint32_t position);
+
+    static std::memory_order load_order(std::memory_order order);
+
+    void check_position(uint32_t position) const;
+
+    void check_word_index(uint32_t word_index) const;
+
+public:
+
+    explicit basic_atomic_bit_string(uint32_t number_of_bits = 0);
+
+    explicit basic_atomic_bit_string(const basic_bit_string<BitOrder>& bits);
+
+    basic_atomic_bit_string(basic_atomic_bit_string&& other) noexcept;
+
+    basic_atomic_bit_string& operator =(basic_atomic_bit_string&& other) noexcept;
+
+/*===================================================================================================================*/
+
+    bool test(uint32_t position, std::memory_order order = std::memory_order_seq_cst) const;
+
+    void set(uint32_t position, std::memory_order order = std::memory_order_seq_cst);
+
+    void reset(uint32_t position, std::memory_order order = std::memory_order_seq_cst);
+
+    bool test_and_set(uint32_t position, std::memory_order order = std::memory_order_seq_cst);
+
+    bool test_and_reset(uint32_t position, std::memory_order order = std::memory_order_seq_cst);
+
+/*===================================================================================================================*/
+
+    uint64_t load_word(uint32_t word_index, std::memory_order order = std::memory_order_seq_cst) const;
+
+    uint64_t fetch_or(uint32_t word_index, uint64_t mask, std::memory_order order = std::memory_order_seq_cst);
+
+    uint64_t fetch_and(uint32_t word_index, uint64_t mask, std::memory_order order = std::memory_order_seq_cst);
+
+/*===================================================================================================================*/
+
+    uint32_t count(std::memory_order order = std::memory_order_seq_cst) const;
+
+    uint32_t count(uint32_t first_word, uint32_t last_word, std::memory_order order = std::memory_order_seq_cst) const;
+
+    void clear(std::memory_order order = std::memory_order_seq_cst);
+
+    basic_bit_string<BitOrder> to_bit_string(std::memory_order order = std::memory_order_seq_cst) const;
+
+/*===================================================================================================================*/
+
+    uint32_t size() const;
+
+    uint32_t number_of_words() const;
+};
+
+typedef basic_atomic_bit_string<msb_first> atomic_bit_string;
+typedef basic_atomic_bit_string<lsb_first> lsb_atomic_bit_string;
+
+
+/**
+ * Construct a string of @a number_of_bits zeros
+ */
+template<typename BitOrder>
+basic_atomic_bit_string<BitOrder>::basic_atomic_bit_string(uint32_t number_of_bits)
+        : m_words(new std::atomic<uint64_t>[(uint64_t(number_of_bits) + WORD_BITS - 1) / WORD_BITS]),
+          m_size_in_bits(number_of_bits) {
+    clear(std::memory_order_relaxed);
+}
+
+/**
+ * Construct a string with a copy of @a bits
+ */
+template<typename BitOrder>
+basic_atomic_bit_string<BitOrder>::basic_atomic_bit_string(const basic_bit_string<BitOrder>& bits)
+        : basic_atomic_bit_string(bits.size()) {
+    for (uint32_t i = 0; i < number_of_words(); ++i) {
+        const uint32_t position = i * WORD_BITS;
+        const uint32_t number_of_bits = bits.size() - position < WORD_BITS ? bits.size() - position : WORD_BITS;
+        m_words[i].store(BitOrder::from_value(bits.get_bits(position, number_of_bits), number_of_bits),
+                         std::memory_order_relaxed);
+    }
+}
+
+template<typename BitOrder>
+basic_atomic_bit_string<BitOrder>::basic_atomic_bit_string(basic_atomic_bit_string&& other) noexcept
+        : m_words(std::move(other.m_words)), m_size_in_bits(other.m_size_in_bits) {
+    other.m_size_in_bits = 0;
+}
+
+template<typename BitOrder>
+basic_atomic_bit_string<BitOrder>&
+basic_atomic_bit_string<BitOrder>::operator =(basic_atomic_bit_string&& other) noexcept {
+    m_words = std::move(other.m_words);
+    m_size_in_bits = other.m_size_in_bits;
+    other.m_size_in_bits = 0;
+    return *this;
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------- Single Bits -----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return The bit at @a position
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+bool basic_atomic_bit_string<BitOrder>::test(uint32_t position, std::memory_order order) const {
+    check_position(position);
+    return m_words[position / WORD_BITS].load(order) & bit_mask(position);
+}
+
+/**
+ * Set the bit at @a position to 1 with an atomic OR
+ *
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+void basic_atomic_bit_string<BitOrder>::set(uint32_t position, std::memory_order order) {
+    check_position(position);
+    m_words[position / WORD_BITS].fetch_or(bit_mask(position), order);
+}
+
+/**
+ * Set the bit at @a position to 0 with an atomic AND
+ *
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+void basic_atomic_bit_string<BitOrder>::reset(uint32_t position, std::memory_order order) {
+    check_position(position);
+    m_words[position / WORD_BITS].fetch_and(~bit_mask(position), order);
+}
+
+/**
+ * Set the bit at @a position to 1 and return its previous value, only one of the threads setting the same bit
+ * concurrently gets false. <br>
+ * The bit is read first and the atomic OR is skipped if it is already set, so threads testing bits which are set
+ * (the common case of a visited set) share the cache line instead of taking its ownership in turns.
+ *
+ * @return The bit before the call
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+bool basic_atomic_bit_string<BitOrder>::test_and_set(uint32_t position, std::memory_order order) {
+    check_position(position);
+    std::atomic<uint64_t>& word = m_words[position / WORD_BITS];
+    const uint64_t mask = bit_mask(position);
+    if (word.load(load_order(order)) & mask)
+        return true;
+    return word.fetch_or(mask, order) & mask;
+}
+
+/**
+ * Set the bit at @a position to 0 and return its previous value, only one of the threads resetting the same bit
+ * concurrently gets true.
+ *
+ * @return The bit before the call
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+bool basic_atomic_bit_string<BitOrder>::test_and_reset(uint32_t position, std::memory_order order) {
+    check_position(position);
+    std::atomic<uint64_t>& word = m_words[position / WORD_BITS];
+    const uint64_t mask = bit_mask(position);
+    if (!(word.load(load_order(order)) & mask))
+        return false;
+    return word.fetch_and(~mask, order) & mask;
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------------- Words --------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return The bits [64 * word_index, 64 * (word_index + 1)) as a word of @a BitOrder, bits after size() are zeros
+ * @throw std::out_of_range if @a word_index is greater than or equal number_of_words()
+ */
+template<typename BitOrder>
+uint64_t basic_atomic_bit_string<BitOrder>::load_word(uint32_t word_index, std::memory_order order) const {
+    check_word_index(word_index);
+    return m_words[word_index].load(order);
+}
+
+/**
+ * Set the bits of a word selected by @a mask with a single atomic OR
+ *
+ * @param word_index Index of the word, it holds the bits [64 * word_index, 64 * (word_index + 1))
+ * @param mask Word of @a BitOrder, i.e. BitOrder::delay(BitOrder::head_mask_64(1), 3) selects the 4th bit of the word
+ * @return The word before the call
+ * @throw std::out_of_range if @a word_index is greater than or equal number_of_words()
+ * @throw std::out_of_range if @a mask selects bits after size()
+ */
+template<typename BitOrder>
+uint64_t basic_atomic_bit_string<BitOrder>::fetch_or(uint32_t word_index, uint64_t mask, std::memory_order order) {
+    check_word_index(word_index);
+    const uint32_t bits_in_word = m_size_in_bits - word_index * WORD_BITS;
+    if (bits_in_word < WORD_BITS && (mask & ~BitOrder::head_mask_64(bits_in_word))) {
+        throw std::out_of_range("mask selects bits after the end of atomic_bit_string of size " +
+                                std::to_string(m_size_in_bits));
+    }
+    return m_words[word_index].fetch_or(mask, order);
+}
+
+/**
+ * Keep only the bits of a word selected by @a mask with a single atomic AND, the others are reset
+ *
+ * @param word_index Index of the word, it holds the bits [64 * word_index, 64 * (word_index + 1))
+ * @param mask Word of @a BitOrder
+ * @return The word before the call
+ * @throw std::out_of_range if @a word_index is greater than or equal number_of_words()
+ */
+template<typename BitOrder>
+uint64_t basic_atomic_bit_string<BitOrder>::fetch_and(uint32_t word_index, uint64_t mask, std::memory_order order) {
+    check_word_index(word_index);
+    return m_words[word_index].fetch_and(mask, order);
+}
+
+
+/*===================================================================================================================*/
+/*--------------------------------------------------- Bulk ----------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * Count the bits set to 1, it may run concurrently with modifications. <br>
+ * Every word is loaded atomically, but not all at the same time, so bits changed during the count may or may not be
+ * counted.
+ *
+ * @return Number of bits set to 1
+ */
+template<typename BitOrder>
+uint32_t basic_atomic_bit_string<BitOrder>::count(std::memory_order order) const {
+    return number_of_words() ? count(0, number_of_words(), order) : 0;
+}
+
+/**
+ * Count the bits set to 1 in the words [first_word, last_word), to split the count between threads
+ *
+ * @throw std::out_of_range if the range exceeds number_of_words()
+ */
+template<typename BitOrder>
+uint32_t basic_atomic_bit_string<BitOrder>::count(uint32_t first_word, uint32_t last_word,
+                                                  std::memory_order order) const {
+    if (first_word > last_word || last_word > number_of_words()) {
+        throw std::out_of_range("range of words [" + std::to_string(first_word) + ", " + std::to_string(last_word) +
+                                ") is out of range of " + std::to_string(number_of_words()) + " words");
+    }
+    uint64_t ones = 0;
+    for (uint32_t i = first_word; i < last_word; ++i) {
+        ones += scalar_kernels::popcount_64(m_words[i].load(order));
+    }
+    return uint32_t(ones);
+}
+
+/**
+ * Reset all bits, word by word
+ */
+template<typename BitOrder>
+void basic_atomic_bit_string<BitOrder>::clear(std::memory_order order) {
+    for (uint32_t i = 0; i < number_of_words(); ++i) {
+        m_words[i].store(0, order);
+    }
+}
+
+/**
+ * @return A %bit_string with a copy of the bits, loaded word by word as count()
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_atomic_bit_string<BitOrder>::to_bit_string(std::memory_order order) const {
+    basic_bit_string<BitOrder> bits;
+    bits.reserve(m_size_in_bits);
+    for (uint32_t i = 0; i < number_of_words(); ++i) {
+        const uint32_t position = i * WORD_BITS;
+        const uint32_t number_of_bits = m_size_in_bits - position < WORD_BITS ? m_size_in_bits - position : WORD_BITS;
+        bits.append_uint_64(BitOrder::to_value(m_words[i].load(order), number_of_bits), number_of_bits);
+    }
+    return bits;
+}
+
+
+/*===================================================================================================================*/
+/*-------------------------------------------------- Capacity -------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+template<typename BitOrder>
+uint32_t basic_atomic_bit_string<BitOrder>::size() const {
+    return m_size_in_bits;
+}
+
+template<typename BitOrder>
+uint32_t basic_atomic_bit_string<BitOrder>::number_of_words() const {
+    return uint32_t((uint64_t(m_size_in_bits) + WORD_BITS - 1) / WORD_BITS);
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------- Private Helpers ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return Mask of the bit at @a position in its word
+ */
+template<typename BitOrder>
+uint64_t basic_atomic_bit_string<BitOrder>::bit_mask(uint32_t position) {
+    return BitOrder::delay(BitOrder::head_mask_64(1), position % WORD_BITS);
+}
+
+/**
+ * @return Order of the load which precedes a read-modify-write with @a order, as a load can not be a release
+ */
+template<typename BitOrder>
+std::memory_order basic_atomic_bit_string<BitOrder>::load_order(std::memory_order order) {
+    switch (order) {
+        case std::memory_order_release:
+            return std::memory_order_relaxed;
+        case std::memory_order_acq_rel:
+            return std::memory_order_acquire;
+        default:
+            return order;
+    }
+}
+
+/**
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+void basic_atomic_bit_string<BitOrder>::check_position(uint32_t position) const {
+    if (position >= m_size_in_bits) {
+        throw std::out_of_range("position " + std::to_string(position) +
+                                " is out of range of atomic_bit_string of size " + std::to_string(m_size_in_bits));
+    }
+}
+
+/**
+ * @throw std::out_of_range if @a word_index is greater than or equal number_of_words()
+ */
+template<typename BitOrder>
+void basic_atomic_bit_string<BitOrder>::check_word_index(uint32_t word_index) const {
+    if (word_index >= number_of_words()) {
+        throw std::out_of_range("word " + std::to_string(word_index) + " is out of range of " +
+                                std::to_string(number_of_words()) + " words");
+    }
+}
+
+#endif //ATOMIC_BIT_STRING_H
@@ -3,69 +3,72 @@
 
 #include "bit_iterator_base.h"
 
-class bit_iterator : public bit_iterator_base {
+template<typename BitOrder>
+class basic_bit_iterator : public bit_iterator_base<BitOrder> {
 
 public:
 
     using iterator_category = std::random_access_iterator_tag;
     using difference_type = long long;
     using value_type = bool;
-    using pointer = bit_reference *;
-    using reference = bit_reference;
+    using pointer = basic_bit_reference<BitOrder> *;
+    using reference = basic_bit_reference<BitOrder>;
 
-    bit_iterator() : bit_iterator_base(0, nullptr) {}
+    basic_bit_iterator() : bit_iterator_base<BitOrder>(0, nullptr) {}
 
-    bit_iterator(uint64_t position, uint8_t * data) : bit_iterator_base(position, data) {}
+    basic_bit_iterator(uint64_t position, uint8_t * data) : bit_iterator_base<BitOrder>(position, data) {}
 
-    bit_iterator& operator ++() {
-        bit_iterator_base::increment();
+    basic_bit_iterator& operator ++() {
+        bit_iterator_base<BitOrder>::increment();
         return *this;
     }
 
-    bit_iterator operator ++(int) {
+    basic_bit_iterator operator ++(int) {
 
-        bit_iterator temp = *this;
-        bit_iterator_base::increment();
+        basic_bit_iterator temp = *this;
+        bit_iterator_base<BitOrder>::increment();
         return temp;
     }
 
-    bit_iterator& operator --() {
-        bit_iterator_base::decrement();
+    basic_bit_iterator& operator --() {
+        bit_iterator_base<BitOrder>::decrement();
         return *this;
     }
 
-    bit_iterator operator --(int) {
+    basic_bit_iterator operator --(int) {
 
-        bit_iterator temp = *this;
-        bit_iterator_base::decrement();
+        basic_bit_iterator temp = *this;
+        bit_iterator_base<BitOrder>::decrement();
         return temp;
     }
 
-    bit_iterator& operator +=(const difference_type diff) {
-        bit_iterator_base::increment(diff);
+    basic_bit_iterator& operator +=(const difference_type diff) {
+        bit_iterator_base<BitOrder>::increment(diff);
         return *this;
     }
 
-    bit_iterator operator +(const difference_type diff) {
-        bit_iterator temp = *this;
+    basic_bit_iterator operator +(const difference_type diff) {
+        basic_bit_iterator temp = *this;
         return temp += diff;
     }
 
-    bit_iterator& operator -=(const difference_type diff) {
-        bit_iterator_base::decrement(diff);
+    basic_bit_iterator& operator -=(const difference_type diff) {
+        bit_iterator_base<BitOrder>::decrement(diff);
         return *this;
     }
 
-    bit_iterator operator -(const difference_type diff) {
-        bit_iterator temp = *this;
+    basic_bit_iterator operator -(const difference_type diff) {
+        basic_bit_iterator temp = *this;
         return temp -= diff;
     }
 
-    bit_reference operator *() {
-        return bit_reference(get_position() , m_data);
+    basic_bit_reference<BitOrder> operator *() {
+        return basic_bit_reference<BitOrder>(this->get_position() , this->m_data);
     }
 
 
 };
 
+typedef basic_bit_iterator<msb_first> bit_iterator;
+
 #endif //BIT_ITERATOR_H
@@ -6,8 +6,7 @@
 
 #include "bit_reference.h"
 
-#define UINT_3_MAX 7 // 2^3 - 1 , max of 3 bits unsigned integer
-
+template<typename BitOrder>
 class bit_iterator_base {
 
 protected:
@@ -20,7 +19,7 @@ protected:
     bit_iterator_base(uint64_t position, uint8_t * data) : m_data(data) {
         const uint32_t BYTE = 8;
         m_array_index = position / BYTE;
-        m_bit_index = BYTE - position % BYTE - 1;
+        m_bit_index = BitOrder::bit_shift(position % BYTE);
     }
 
     void increment(int steps = 1) {
@@ -33,7 +32,7 @@ protected:
 
     int64_t get_position() const {
         const uint32_t BYTE = 8;
-        return m_array_index * BYTE + (UINT_3_MAX - m_bit_index);
+        return m_array_index * BYTE + BitOrder::bit_shift(m_bit_index);
     }
 
     void set_position(int64_t position) {
@@ -41,7 +40,7 @@ protected:
             throw std::out_of_range("Position is negative");
         const uint32_t BYTE = 8;
         m_array_index = position / BYTE;
-        m_bit_index = UINT_3_MAX - position % BYTE;
+        m_bit_index = BitOrder::bit_shift(position % BYTE);
     }
 
 public:
@@ -78,6 +77,4 @@ public:
 
 };
 
-#undef UINT_3_MAX
-
 #endif //BIT_ITERATOR_BASE_H
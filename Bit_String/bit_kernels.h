@@ -0,0 +1,1114 @@
+#ifndef BIT_KERNELS_H
+#define BIT_KERNELS_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "cpu_features.h"
+
+#ifdef BIT_STRING_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * Table of bulk kernels working on raw byte buffers of a %bit_string (bits are stored MSB first in each byte).
+ *
+ * Each kernel has a scalar, SSE4.2, AVX2 and AVX-512 variant. The best variant supported by the running CPU is
+ * selected once on first use, so one binary can run on any x86-64 machine without compiling with -march=native.
+ * The selected level can be lowered with the environment variable @a BIT_STRING_SIMD_LEVEL
+ * ("scalar", "sse4.2", "avx2" or "avx512") or at runtime with force_level().
+ */
+struct bit_kernels {
+
+    simd_level level;
+
+    // dst[i] = dst[i] op src[i] for i in [0, length)
+    void (*bitwise_and)(uint8_t* dst, const uint8_t* src, uint64_t length);
+    void (*bitwise_or)(uint8_t* dst, const uint8_t* src, uint64_t length);
+    void (*bitwise_xor)(uint8_t* dst, const uint8_t* src, uint64_t length);
+
+    // dst[i] = ~dst[i] for i in [0, length)
+    void (*bitwise_not)(uint8_t* dst, uint64_t length);
+
+    // Number of set bits in src[0, length)
+    uint64_t (*popcount)(const uint8_t* src, uint64_t length);
+
+    // dst[i] = (src[i] << shift) | (src[i + 1] >> (8 - shift)) for i in [0, length), shift in [1, 7]
+    // Reads src[0, length], so it is safe to use in place (dst <= src)
+    void (*shift_copy)(uint8_t* dst, const uint8_t* src, uint64_t length, uint32_t shift);
+
+    // Packs 8 * length chars of '0' and '1' into length bytes, returns false if any other char is found
+    bool (*parse)(uint8_t* dst, const char* chars, uint64_t length);
+
+    // Expands length bytes into 8 * length chars of one and zero
+    void (*format)(char* dst, const uint8_t* src, uint64_t length, char one, char zero);
+
+    // True if a[0, length) equals b[0, length)
+    bool (*equal)(const uint8_t* a, const uint8_t* b, uint64_t length);
+
+    // Reverses the order of all the 8 * length bits of data[0, length) in place
+    void (*reverse)(uint8_t* data, uint64_t length);
+
+    // First index i in [0, length) where the pair of bytes (data[i], data[i + 1]) equals any of the 8 pairs
+    // (pairs[2k], pairs[2k + 1]), or length if there is none. Reads data[0, length]
+    uint64_t (*find_any_pair)(const uint8_t* data, uint64_t length, const uint8_t* pairs);
+
+    // Bits of value where mask is 1, packed into the low bits in the same order (pext)
+    uint64_t (*extract_bits)(uint64_t value, uint64_t mask);
+
+    // Low bits of value scattered in order to the positions where mask is 1 (pdep)
+    uint64_t (*deposit_bits)(uint64_t value, uint64_t mask);
+
+    // distances[j] = number of set bits in query[0, length) ^ fingerprints[j * length, (j + 1) * length)
+    // for j in [0, count)
+    void (*hamming_distances)(const uint8_t* query, const uint8_t* fingerprints, uint64_t count, uint64_t length,
+                              uint32_t* distances);
+
+    static const bit_kernels& get();
+
+    static simd_level detected_level();
+
+    static simd_level active_level();
+
+    static simd_level force_level(simd_level level);
+
+private:
+
+    static const bit_kernels& kernels_for(simd_level level);
+
+    static std::atomic<const bit_kernels*>& active();
+};
+
+
+/*====================================================================================================================*/
+/*-------------------------------------------------- Scalar Kernels --------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * Portable kernels working on 64-bit words, used on CPUs without SSE4.2 and on non x86 architectures.
+ */
+struct scalar_kernels {
+
+    // Little endian load and store, compilers merge them into a single move on little endian CPUs
+    static uint64_t load_64(const void* src) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(src);
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | bytes[i];
+        }
+        return value;
+    }
+
+    static void store_64(void* dst, uint64_t value) {
+        uint8_t* bytes = static_cast<uint8_t*>(dst);
+        for (int i = 0; i < 8; ++i, value >>= 8) {
+            bytes[i] = uint8_t(value);
+        }
+    }
+
+    static uint64_t popcount_64(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(value);
+#else
+        value = value - ((value >> 1) & 0x5555555555555555ull);
+        value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+        value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return (value * 0x0101010101010101ull) >> 56;
+#endif
+    }
+
+    /**
+     * @return The number of zero bits above the most significant set bit, 64 if @a value is 0
+     */
+    static uint32_t leading_zeros_64(uint64_t value) {
+        if (value == 0)
+            return 64;
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(value);
+#else
+        uint32_t count = 0;
+        for (; !(value & 0x8000000000000000ull); value <<= 1) {
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    /**
+     * @return The number of zero bits below the least significant set bit, 64 if @a value is 0
+     */
+    static uint32_t trailing_zeros_64(uint64_t value) {
+        if (value == 0)
+            return 64;
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(value);
+#else
+        return popcount_64((value & (0 - value)) - 1);
+#endif
+    }
+
+    /**
+     * Packs the 8 chars loaded (little endian) in @a chars into one byte, the first char becomes the MSB
+     * @return False if any char is not '0' or '1'
+     */
+    static bool parse_8(uint64_t chars, uint8_t& byte) {
+        if ((chars & 0xFEFEFEFEFEFEFEFEull) != 0x3030303030303030ull)
+            return false;
+        // Move bit 0 of char i into bit (63 - i), then take the high byte
+        byte = ((chars & 0x0101010101010101ull) * 0x8040201008040201ull) >> 56;
+        return true;
+    }
+
+    /**
+     * Expands @a byte into 8 chars (little endian), the MSB becomes the first char
+     */
+    static uint64_t format_8(uint8_t byte, uint64_t ones, uint64_t zeros) {
+        uint64_t bits = (byte * 0x0101010101010101ull) & 0x0102040810204080ull;
+        uint64_t mask = (((bits + 0x7F7F7F7F7F7F7F7Full) & 0x8080808080808080ull) >> 7) * 0xFF;
+        return (mask & ones) | (~mask & zeros);
+    }
+
+    static void bitwise_and(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            store_64(dst + i, load_64(dst + i) & load_64(src + i));
+        }
+        for (; i < length; ++i) {
+            dst[i] &= src[i];
+        }
+    }
+
+    static void bitwise_or(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            store_64(dst + i, load_64(dst + i) | load_64(src + i));
+        }
+        for (; i < length; ++i) {
+            dst[i] |= src[i];
+        }
+    }
+
+    static void bitwise_xor(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            store_64(dst + i, load_64(dst + i) ^ load_64(src + i));
+        }
+        for (; i < length; ++i) {
+            dst[i] ^= src[i];
+        }
+    }
+
+    static void bitwise_not(uint8_t* dst, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            store_64(dst + i, ~load_64(dst + i));
+        }
+        for (; i < length; ++i) {
+            dst[i] = ~dst[i];
+        }
+    }
+
+    static uint64_t popcount(const uint8_t* src, uint64_t length) {
+        uint64_t count = 0;
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            count += popcount_64(load_64(src + i));
+        }
+        for (; i < length; ++i) {
+            count += popcount_64(src[i]);
+        }
+        return count;
+    }
+
+    static uint64_t xor_popcount(const uint8_t* a, const uint8_t* b, uint64_t length) {
+        uint64_t count = 0;
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            count += popcount_64(load_64(a + i) ^ load_64(b + i));
+        }
+        for (; i < length; ++i) {
+            count += popcount_64(a[i] ^ b[i]);
+        }
+        return count;
+    }
+
+    static void hamming_distances(const uint8_t* query, const uint8_t* fingerprints, uint64_t count, uint64_t length,
+                                  uint32_t* distances) {
+        for (uint64_t j = 0; j < count; ++j) {
+            distances[j] = xor_popcount(query, fingerprints + j * length, length);
+        }
+    }
+
+    static void shift_copy(uint8_t* dst, const uint8_t* src, uint64_t length, uint32_t shift) {
+        for (uint64_t i = 0; i < length; ++i) {
+            dst[i] = uint8_t(src[i] << shift) | uint8_t(src[i + 1] >> (8 - shift));
+        }
+    }
+
+    static bool parse(uint8_t* dst, const char* chars, uint64_t length) {
+        for (uint64_t i = 0; i < length; ++i) {
+            if (!parse_8(load_64(chars + i * 8), dst[i]))
+                return false;
+        }
+        return true;
+    }
+
+    static void format(char* dst, const uint8_t* src, uint64_t length, char one, char zero) {
+        const uint64_t ones = uint8_t(one) * 0x0101010101010101ull;
+        const uint64_t zeros = uint8_t(zero) * 0x0101010101010101ull;
+        for (uint64_t i = 0; i < length; ++i) {
+            store_64(dst + i * 8, format_8(src[i], ones, zeros));
+        }
+    }
+
+    static bool equal(const uint8_t* a, const uint8_t* b, uint64_t length) {
+        return memcmp(a, b, length) == 0;
+    }
+
+    static uint64_t find_any_pair(const uint8_t* data, uint64_t length, const uint8_t* pairs) {
+        for (uint64_t i = 0; i < length; ++i) {
+            for (int k = 0; k < 16; k += 2) {
+                if (data[i] == pairs[k] && data[i + 1] == pairs[k + 1])
+                    return i;
+            }
+        }
+        return length;
+    }
+
+    /**
+     * Moves byte i to byte (7 - i)
+     */
+    static uint64_t byte_swap_64(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(value);
+#else
+        value = ((value >> 8) & 0x00FF00FF00FF00FFull) | ((value & 0x00FF00FF00FF00FFull) << 8);
+        value = ((value >> 16) & 0x0000FFFF0000FFFFull) | ((value & 0x0000FFFF0000FFFFull) << 16);
+        return (value >> 32) | (value << 32);
+#endif
+    }
+
+    /**
+     * Moves bit i to bit (63 - i), i.e. reverses the byte order and the bits of every byte
+     */
+    static uint64_t reverse_64(uint64_t value) {
+        value = ((value >> 1) & 0x5555555555555555ull) | ((value & 0x5555555555555555ull) << 1);
+        value = ((value >> 2) & 0x3333333333333333ull) | ((value & 0x3333333333333333ull) << 2);
+        value = ((value >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((value & 0x0F0F0F0F0F0F0F0Full) << 4);
+        return byte_swap_64(value);
+    }
+
+    static void reverse(uint8_t* data, uint64_t length) {
+        // Swap the reversed words from both ends, then the reversed bytes in the middle
+        uint64_t i = 0;
+        for (; i + 16 <= length - i; i += 8) {
+            const uint64_t front = load_64(data + i);
+            const uint64_t back = load_64(data + length - i - 8);
+            store_64(data + i, reverse_64(back));
+            store_64(data + length - i - 8, reverse_64(front));
+        }
+        for (uint64_t j = length - i; i < j; ++i, --j) {
+            const uint8_t front = data[i];
+            data[i] = uint8_t(reverse_64(data[j - 1]) >> 56);
+            data[j - 1] = uint8_t(reverse_64(front) >> 56);
+        }
+    }
+
+    static uint64_t extract_bits(uint64_t value, uint64_t mask) {
+        uint64_t result = 0;
+        for (uint64_t bit = 1; mask != 0; bit <<= 1) {
+            if (value & mask & (0 - mask)) // Lowest set bit of the mask
+                result |= bit;
+            mask &= mask - 1;
+        }
+        return result;
+    }
+
+    static uint64_t deposit_bits(uint64_t value, uint64_t mask) {
+        uint64_t result = 0;
+        for (uint64_t bit = 1; mask != 0; bit <<= 1) {
+            if (value & bit)
+                result |= mask & (0 - mask);
+            mask &= mask - 1;
+        }
+        return result;
+    }
+};
+
+#ifdef BIT_STRING_X86
+
+/*====================================================================================================================*/
+/*-------------------------------------------------- SSE4.2 Kernels --------------------------------------------------*/
+/*====================================================================================================================*/
+
+#define BIT_STRING_SSE4_2 BIT_STRING_TARGET("sse4.2,popcnt")
+
+struct sse4_2_kernels {
+
+    /**
+     * POPCNT of a 64-bit word, as two 32-bit POPCNT on 32-bit x86
+     */
+    BIT_STRING_SSE4_2 static uint64_t popcount_64(uint64_t word) {
+#ifdef BIT_STRING_X86_64
+        return _mm_popcnt_u64(word);
+#else
+        return _mm_popcnt_u32(uint32_t(word)) + _mm_popcnt_u32(uint32_t(word >> 32));
+#endif
+    }
+
+    BIT_STRING_SSE4_2 static void bitwise_and(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i*) (dst + i));
+            __m128i b = _mm_loadu_si128((const __m128i*) (src + i));
+            _mm_storeu_si128((__m128i*) (dst + i), _mm_and_si128(a, b));
+        }
+        scalar_kernels::bitwise_and(dst + i, src + i, length - i);
+    }
+
+    BIT_STRING_SSE4_2 static void bitwise_or(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i*) (dst + i));
+            __m128i b = _mm_loadu_si128((const __m128i*) (src + i));
+            _mm_storeu_si128((__m128i*) (dst + i), _mm_or_si128(a, b));
+        }
+        scalar_kernels::bitwise_or(dst + i, src + i, length - i);
+    }
+
+    BIT_STRING_SSE4_2 static void bitwise_xor(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i*) (dst + i));
+            __m128i b = _mm_loadu_si128((const __m128i*) (src + i));
+            _mm_storeu_si128((__m128i*) (dst + i), _mm_xor_si128(a, b));
+        }
+        scalar_kernels::bitwise_xor(dst + i, src + i, length - i);
+    }
+
+    BIT_STRING_SSE4_2 static void bitwise_not(uint8_t* dst, uint64_t length) {
+        const __m128i ones = _mm_set1_epi8(-1);
+        uint64_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i*) (dst + i));
+            _mm_storeu_si128((__m128i*) (dst + i), _mm_xor_si128(a, ones));
+        }
+        scalar_kernels::bitwise_not(dst + i, length - i);
+    }
+
+    BIT_STRING_SSE4_2 static uint64_t popcount(const uint8_t* src, uint64_t length) {
+        uint64_t count = 0;
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            count += popcount_64(scalar_kernels::load_64(src + i));
+        }
+        for (; i < length; ++i) {
+            count += _mm_popcnt_u32(src[i]);
+        }
+        return count;
+    }
+
+    BIT_STRING_SSE4_2 static uint64_t xor_popcount(const uint8_t* a, const uint8_t* b, uint64_t length) {
+        uint64_t count = 0;
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            count += popcount_64(scalar_kernels::load_64(a + i) ^ scalar_kernels::load_64(b + i));
+        }
+        for (; i < length; ++i) {
+            count += _mm_popcnt_u32(a[i] ^ b[i]);
+        }
+        return count;
+    }
+
+    BIT_STRING_SSE4_2 static void hamming_distances(const uint8_t* query, const uint8_t* fingerprints, uint64_t count,
+                                                    uint64_t length, uint32_t* distances) {
+        for (uint64_t j = 0; j < count; ++j) {
+            distances[j] = xor_popcount(query, fingerprints + j * length, length);
+        }
+    }
+
+    BIT_STRING_SSE4_2 static void shift_copy(uint8_t* dst, const uint8_t* src, uint64_t length, uint32_t shift) {
+        const __m128i left = _mm_cvtsi32_si128(shift);
+        const __m128i right = _mm_cvtsi32_si128(8 - shift);
+        const __m128i high_mask = _mm_set1_epi8(char(0xFF << shift));
+        const __m128i low_mask = _mm_set1_epi8(char(0xFF >> (8 - shift)));
+        uint64_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            __m128i current = _mm_loadu_si128((const __m128i*) (src + i));
+            __m128i next = _mm_loadu_si128((const __m128i*) (src + i + 1));
+            __m128i high = _mm_and_si128(_mm_sll_epi16(current, left), high_mask);
+            __m128i low = _mm_and_si128(_mm_srl_epi16(next, right), low_mask);
+            _mm_storeu_si128((__m128i*) (dst + i), _mm_or_si128(high, low));
+        }
+        scalar_kernels::shift_copy(dst + i, src + i, length - i, shift);
+    }
+
+    BIT_STRING_SSE4_2 static bool parse(uint8_t* dst, const char* chars, uint64_t length) {
+        // Reverse each group of 8 chars, so movemask puts the first char of each group in the MSB of its byte
+        const __m128i reverse = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        const __m128i not_bit_mask = _mm_set1_epi8(char(0xFE));
+        const __m128i zero_char = _mm_set1_epi8('0');
+        uint64_t i = 0;
+        for (; i + 2 <= length; i += 2) {
+            __m128i str = _mm_loadu_si128((const __m128i*) (chars + i * 8));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(str, not_bit_mask), zero_char)) != 0xFFFF)
+                return false;
+            __m128i bits = _mm_slli_epi64(_mm_shuffle_epi8(str, reverse), 7);
+            uint16_t packed = _mm_movemask_epi8(bits);
+            memcpy(dst + i, &packed, sizeof(packed));
+        }
+        return scalar_kernels::parse(dst + i, chars + i * 8, length - i);
+    }
+
+    BIT_STRING_SSE4_2 static void format(char* dst, const uint8_t* src, uint64_t length, char one, char zero) {
+        const __m128i spread = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+        const __m128i bit_masks = _mm_setr_epi8(char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+                                                char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+        const __m128i ones = _mm_set1_epi8(one);
+        const __m128i zeros = _mm_set1_epi8(zero);
+        uint64_t i = 0;
+        for (; i + 2 <= length; i += 2) {
+            uint16_t pair;
+            memcpy(&pair, src + i, sizeof(pair));
+            __m128i bytes = _mm_shuffle_epi8(_mm_cvtsi32_si128(pair), spread);
+            __m128i is_set = _mm_cmpeq_epi8(_mm_and_si128(bytes, bit_masks), bit_masks);
+            _mm_storeu_si128((__m128i*) (dst + i * 8), _mm_blendv_epi8(zeros, ones, is_set));
+        }
+        scalar_kernels::format(dst + i * 8, src + i, length - i, one, zero);
+    }
+
+    BIT_STRING_SSE4_2 static bool equal(const uint8_t* a, const uint8_t* b, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i*) (a + i));
+            __m128i y = _mm_loadu_si128((const __m128i*) (b + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xFFFF)
+                return false;
+        }
+        return scalar_kernels::equal(a + i, b + i, length - i);
+    }
+
+    /**
+     * Uses the string compare instruction PCMPESTRI in "equal any" mode on 16-bit words, once for the pairs
+     * starting at even offsets and once for the pairs starting at odd offsets
+     */
+    BIT_STRING_SSE4_2 static uint64_t find_any_pair(const uint8_t* data, uint64_t length, const uint8_t* pairs) {
+        const int mode = _SIDD_UWORD_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT;
+        const __m128i needles = _mm_loadu_si128((const __m128i*) pairs);
+        uint64_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            int even = _mm_cmpestri(needles, 8, _mm_loadu_si128((const __m128i*) (data + i)), 8, mode);
+            int odd = _mm_cmpestri(needles, 8, _mm_loadu_si128((const __m128i*) (data + i + 1)), 8, mode);
+            if (even < 8 || odd < 8)
+                return i + (2 * even < 2 * odd + 1 ? 2 * even : 2 * odd + 1);
+        }
+        return i + scalar_kernels::find_any_pair(data + i, length - i, pairs);
+    }
+
+    /**
+     * Reverses the 16 bytes of @a value and the bits of every byte, the bits are reversed with a nibble lookup table
+     */
+    BIT_STRING_SSE4_2 static __m128i reverse_128(__m128i value) {
+        const __m128i reversed_low = _mm_setr_epi8(0x00, char(0x80), 0x40, char(0xC0), 0x20, char(0xA0), 0x60,
+                                                   char(0xE0), 0x10, char(0x90), 0x50, char(0xD0), 0x30, char(0xB0),
+                                                   0x70, char(0xF0));
+        const __m128i reversed_high = _mm_setr_epi8(0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+                                                    0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF);
+        const __m128i byte_order = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+        __m128i low = _mm_and_si128(value, nibble_mask);
+        __m128i high = _mm_and_si128(_mm_srli_epi16(value, 4), nibble_mask);
+        __m128i bits = _mm_or_si128(_mm_shuffle_epi8(reversed_low, low), _mm_shuffle_epi8(reversed_high, high));
+        return _mm_shuffle_epi8(bits, byte_order);
+    }
+
+    BIT_STRING_SSE4_2 static void reverse(uint8_t* data, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 32 <= length - i; i += 16) {
+            __m128i front = _mm_loadu_si128((const __m128i*) (data + i));
+            __m128i back = _mm_loadu_si128((const __m128i*) (data + length - i - 16));
+            _mm_storeu_si128((__m128i*) (data + i), reverse_128(back));
+            _mm_storeu_si128((__m128i*) (data + length - i - 16), reverse_128(front));
+        }
+        scalar_kernels::reverse(data + i, length - 2 * i);
+    }
+};
+
+#undef BIT_STRING_SSE4_2
+
+/*====================================================================================================================*/
+/*--------------------------------------------------- AVX2 Kernels ---------------------------------------------------*/
+/*====================================================================================================================*/
+
+#define BIT_STRING_AVX2 BIT_STRING_TARGET("avx2,popcnt")
+
+struct avx2_kernels {
+
+    BIT_STRING_AVX2 static void bitwise_and(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i*) (dst + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*) (src + i));
+            _mm256_storeu_si256((__m256i*) (dst + i), _mm256_and_si256(a, b));
+        }
+        sse4_2_kernels::bitwise_and(dst + i, src + i, length - i);
+    }
+
+    BIT_STRING_AVX2 static void bitwise_or(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i*) (dst + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*) (src + i));
+            _mm256_storeu_si256((__m256i*) (dst + i), _mm256_or_si256(a, b));
+        }
+        sse4_2_kernels::bitwise_or(dst + i, src + i, length - i);
+    }
+
+    BIT_STRING_AVX2 static void bitwise_xor(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i*) (dst + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*) (src + i));
+            _mm256_storeu_si256((__m256i*) (dst + i), _mm256_xor_si256(a, b));
+        }
+        sse4_2_kernels::bitwise_xor(dst + i, src + i, length - i);
+    }
+
+    BIT_STRING_AVX2 static void bitwise_not(uint8_t* dst, uint64_t length) {
+        const __m256i ones = _mm256_set1_epi8(-1);
+        uint64_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i*) (dst + i));
+            _mm256_storeu_si256((__m256i*) (dst + i), _mm256_xor_si256(a, ones));
+        }
+        sse4_2_kernels::bitwise_not(dst + i, length - i);
+    }
+
+    /**
+     * Number of set bits in each byte of @a bytes, using a nibble lookup table (Mula's algorithm)
+     */
+    BIT_STRING_AVX2 static __m256i popcount_bytes(__m256i bytes) {
+        const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+        __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(bytes, low_nibble));
+        __m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_nibble));
+        return _mm256_add_epi8(low, high);
+    }
+
+    BIT_STRING_AVX2 static uint64_t sum_64(__m256i counts) {
+        uint64_t lanes[4];
+        _mm256_storeu_si256((__m256i*) lanes, counts);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    BIT_STRING_AVX2 static uint64_t popcount(const uint8_t* src, uint64_t length) {
+        __m256i total = _mm256_setzero_si256();
+        uint64_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i counts = popcount_bytes(_mm256_loadu_si256((const __m256i*) (src + i)));
+            total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+        }
+        return sum_64(total) + sse4_2_kernels::popcount(src + i, length - i);
+    }
+
+    BIT_STRING_AVX2 static uint64_t xor_popcount(const uint8_t* a, const uint8_t* b, uint64_t length) {
+        __m256i total = _mm256_setzero_si256();
+        uint64_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) (a + i)),
+                                         _mm256_loadu_si256((const __m256i*) (b + i)));
+            total = _mm256_add_epi64(total, _mm256_sad_epu8(popcount_bytes(x), _mm256_setzero_si256()));
+        }
+        return sum_64(total) + sse4_2_kernels::xor_popcount(a + i, b + i, length - i);
+    }
+
+    BIT_STRING_AVX2 static void hamming_distances(const uint8_t* query, const uint8_t* fingerprints, uint64_t count,
+                                                  uint64_t length, uint32_t* distances) {
+        if (length < 32) { // The nibble lookup only pays off for long fingerprints, POPCNT is faster otherwise
+            sse4_2_kernels::hamming_distances(query, fingerprints, count, length, distances);
+            return;
+        }
+        for (uint64_t j = 0; j < count; ++j) {
+            distances[j] = xor_popcount(query, fingerprints + j * length, length);
+        }
+    }
+
+    BIT_STRING_AVX2 static void shift_copy(uint8_t* dst, const uint8_t* src, uint64_t length, uint32_t shift) {
+        const __m128i left = _mm_cvtsi32_si128(shift);
+        const __m128i right = _mm_cvtsi32_si128(8 - shift);
+        const __m256i high_mask = _mm256_set1_epi8(char(0xFF << shift));
+        const __m256i low_mask = _mm256_set1_epi8(char(0xFF >> (8 - shift)));
+        uint64_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i current = _mm256_loadu_si256((const __m256i*) (src + i));
+            __m256i next = _mm256_loadu_si256((const __m256i*) (src + i + 1));
+            __m256i high = _mm256_and_si256(_mm256_sll_epi16(current, left), high_mask);
+            __m256i low = _mm256_and_si256(_mm256_srl_epi16(next, right), low_mask);
+            _mm256_storeu_si256((__m256i*) (dst + i), _mm256_or_si256(high, low));
+        }
+        sse4_2_kernels::shift_copy(dst + i, src + i, length - i, shift);
+    }
+
+    BIT_STRING_AVX2 static bool parse(uint8_t* dst, const char* chars, uint64_t length) {
+        const __m256i reverse = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        const __m256i not_bit_mask = _mm256_set1_epi8(char(0xFE));
+        const __m256i zero_char = _mm256_set1_epi8('0');
+        uint64_t i = 0;
+        for (; i + 4 <= length; i += 4) {
+            __m256i str = _mm256_loadu_si256((const __m256i*) (chars + i * 8));
+            __m256i valid = _mm256_cmpeq_epi8(_mm256_and_si256(str, not_bit_mask), zero_char);
+            if (uint32_t(_mm256_movemask_epi8(valid)) != 0xFFFFFFFFu)
+                return false;
+            __m256i bits = _mm256_slli_epi64(_mm256_shuffle_epi8(str, reverse), 7);
+            uint32_t packed = _mm256_movemask_epi8(bits);
+            memcpy(dst + i, &packed, sizeof(packed));
+        }
+        return sse4_2_kernels::parse(dst + i, chars + i * 8, length - i);
+    }
+
+    BIT_STRING_AVX2 static void format(char* dst, const uint8_t* src, uint64_t length, char one, char zero) {
+        // After broadcasting 4 bytes into every lane, lane k (16 chars) needs bytes 2k and 2k + 1
+        const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                                2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+        const __m256i bit_masks = _mm256_set1_epi64x(0x0102040810204080ll);
+        const __m256i ones = _mm256_set1_epi8(one);
+        const __m256i zeros = _mm256_set1_epi8(zero);
+        uint64_t i = 0;
+        for (; i + 4 <= length; i += 4) {
+            uint32_t quad;
+            memcpy(&quad, src + i, sizeof(quad));
+            __m256i bytes = _mm256_shuffle_epi8(_mm256_set1_epi32(int(quad)), spread);
+            __m256i is_set = _mm256_cmpeq_epi8(_mm256_and_si256(bytes, bit_masks), bit_masks);
+            _mm256_storeu_si256((__m256i*) (dst + i * 8), _mm256_blendv_epi8(zeros, ones, is_set));
+        }
+        sse4_2_kernels::format(dst + i * 8, src + i, length - i, one, zero);
+    }
+
+    BIT_STRING_AVX2 static bool equal(const uint8_t* a, const uint8_t* b, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i x = _mm256_loadu_si256((const __m256i*) (a + i));
+            __m256i y = _mm256_loadu_si256((const __m256i*) (b + i));
+            if (uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y))) != 0xFFFFFFFFu)
+                return false;
+        }
+        return sse4_2_kernels::equal(a + i, b + i, length - i);
+    }
+
+    BIT_STRING_AVX2 static uint64_t find_any_pair(const uint8_t* data, uint64_t length, const uint8_t* pairs) {
+        __m256i needles[8];
+        for (int k = 0; k < 8; ++k) {
+            int16_t pair;
+            memcpy(&pair, pairs + 2 * k, sizeof(pair));
+            needles[k] = _mm256_set1_epi16(pair);
+        }
+        uint64_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i even = _mm256_loadu_si256((const __m256i*) (data + i));
+            __m256i odd = _mm256_loadu_si256((const __m256i*) (data + i + 1));
+            __m256i even_found = _mm256_cmpeq_epi16(even, needles[0]);
+            __m256i odd_found = _mm256_cmpeq_epi16(odd, needles[0]);
+            for (int k = 1; k < 8; ++k) {
+                even_found = _mm256_or_si256(even_found, _mm256_cmpeq_epi16(even, needles[k]));
+                odd_found = _mm256_or_si256(odd_found, _mm256_cmpeq_epi16(odd, needles[k]));
+            }
+            // Byte 2t of each mask is the pair starting at 2t (even) and 2t + 1 (odd)
+            uint32_t mask = (uint32_t(_mm256_movemask_epi8(even_found)) & 0x55555555u) |
+                            ((uint32_t(_mm256_movemask_epi8(odd_found)) & 0x55555555u) << 1);
+            if (mask != 0)
+                return i + scalar_kernels::trailing_zeros_64(mask);
+        }
+        return i + sse4_2_kernels::find_any_pair(data + i, length - i, pairs);
+    }
+
+    BIT_STRING_AVX2 static __m256i reverse_256(__m256i value) {
+        const __m256i reversed_low = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+                0x00, char(0x80), 0x40, char(0xC0), 0x20, char(0xA0), 0x60, char(0xE0),
+                0x10, char(0x90), 0x50, char(0xD0), 0x30, char(0xB0), 0x70, char(0xF0)));
+        const __m256i reversed_high = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+                0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF));
+        const __m256i byte_order = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+                15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+        const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+        __m256i low = _mm256_and_si256(value, nibble_mask);
+        __m256i high = _mm256_and_si256(_mm256_srli_epi16(value, 4), nibble_mask);
+        __m256i bits = _mm256_or_si256(_mm256_shuffle_epi8(reversed_low, low),
+                                       _mm256_shuffle_epi8(reversed_high, high));
+        // Reverse the bytes of each 128-bit lane, then swap the lanes
+        return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(bits, byte_order), 0x4E);
+    }
+
+    BIT_STRING_AVX2 static void reverse(uint8_t* data, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 64 <= length - i; i += 32) {
+            __m256i front = _mm256_loadu_si256((const __m256i*) (data + i));
+            __m256i back = _mm256_loadu_si256((const __m256i*) (data + length - i - 32));
+            _mm256_storeu_si256((__m256i*) (data + i), reverse_256(back));
+            _mm256_storeu_si256((__m256i*) (data + length - i - 32), reverse_256(front));
+        }
+        sse4_2_kernels::reverse(data + i, length - 2 * i);
+    }
+};
+
+#undef BIT_STRING_AVX2
+
+/*====================================================================================================================*/
+/*------------------------------------------------- AVX-512 Kernels --------------------------------------------------*/
+/*====================================================================================================================*/
+
+#define BIT_STRING_AVX512 BIT_STRING_TARGET("avx512f,avx512bw,avx2,popcnt")
+
+struct avx512_kernels {
+
+    BIT_STRING_AVX512 static void bitwise_and(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 64 <= length; i += 64) {
+            __m512i a = _mm512_loadu_si512(dst + i);
+            __m512i b = _mm512_loadu_si512(src + i);
+            _mm512_storeu_si512(dst + i, _mm512_and_si512(a, b));
+        }
+        avx2_kernels::bitwise_and(dst + i, src + i, length - i);
+    }
+
+    BIT_STRING_AVX512 static void bitwise_or(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 64 <= length; i += 64) {
+            __m512i a = _mm512_loadu_si512(dst + i);
+            __m512i b = _mm512_loadu_si512(src + i);
+            _mm512_storeu_si512(dst + i, _mm512_or_si512(a, b));
+        }
+        avx2_kernels::bitwise_or(dst + i, src + i, length - i);
+    }
+
+    BIT_STRING_AVX512 static void bitwise_xor(uint8_t* dst, const uint8_t* src, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 64 <= length; i += 64) {
+            __m512i a = _mm512_loadu_si512(dst + i);
+            __m512i b = _mm512_loadu_si512(src + i);
+            _mm512_storeu_si512(dst + i, _mm512_xor_si512(a, b));
+        }
+        avx2_kernels::bitwise_xor(dst + i, src + i, length - i);
+    }
+
+    BIT_STRING_AVX512 static void bitwise_not(uint8_t* dst, uint64_t length) {
+        const __m512i ones = _mm512_set1_epi8(-1);
+        uint64_t i = 0;
+        for (; i + 64 <= length; i += 64) {
+            __m512i a = _mm512_loadu_si512(dst + i);
+            _mm512_storeu_si512(dst + i, _mm512_xor_si512(a, ones));
+        }
+        avx2_kernels::bitwise_not(dst + i, length - i);
+    }
+
+    /**
+     * Sum of the 8 64-bit elements of @a counts. _mm512_reduce_add_epi64 is not used, it raises -Wuninitialized
+     * warnings from the GCC headers
+     */
+    BIT_STRING_AVX512 static uint64_t sum_64(__m512i counts) {
+        uint64_t lanes[8];
+        _mm512_storeu_si512(lanes, counts);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+    }
+
+    /**
+     * Uses the VPOPCNTQ instruction, only selected on CPUs supporting AVX512_VPOPCNTDQ
+     */
+    BIT_STRING_TARGET("avx512f,avx512bw,avx512vpopcntdq,avx2,popcnt")
+    static uint64_t popcount(const uint8_t* src, uint64_t length) {
+        __m512i total = _mm512_setzero_si512();
+        uint64_t i = 0;
+        for (; i + 64 <= length; i += 64) {
+            total = _mm512_add_epi64(total, _mm512_popcnt_epi64(_mm512_loadu_si512(src + i)));
+        }
+        return sum_64(total) + avx2_kernels::popcount(src + i, length - i);
+    }
+
+    /**
+     * Uses the VPOPCNTQ instruction, only selected on CPUs supporting AVX512_VPOPCNTDQ. <br>
+     * 64-bit fingerprints are compared 8 at a time, longer ones 64 bytes at a time with a masked load for the tail.
+     */
+    BIT_STRING_TARGET("avx512f,avx512bw,avx512vpopcntdq,avx2,popcnt")
+    static void hamming_distances(const uint8_t* query, const uint8_t* fingerprints, uint64_t count,
+                                  uint64_t length, uint32_t* distances) {
+        uint64_t j = 0;
+        if (length == 8) {
+            int64_t query_word;
+            memcpy(&query_word, query, sizeof(query_word));
+            const __m512i queries = _mm512_set1_epi64(query_word);
+            for (; j + 8 <= count; j += 8) {
+                __m512i x = _mm512_xor_si512(_mm512_loadu_si512(fingerprints + j * 8), queries);
+                const __m256i counts = _mm512_maskz_cvtepi64_epi32(0xFF, _mm512_popcnt_epi64(x));
+                _mm256_storeu_si256((__m256i*) (distances + j), counts);
+            }
+        }
+
+        const uint64_t tail = length % 64;
+        const __mmask64 tail_mask = tail ? ~0ull >> (64 - tail) : 0;
+        for (; j < count; ++j) {
+            const uint8_t* fingerprint = fingerprints + j * length;
+            __m512i total = _mm512_setzero_si512();
+            uint64_t i = 0;
+            for (; i + 64 <= length; i += 64) {
+                __m512i x = _mm512_xor_si512(_mm512_loadu_si512(query + i), _mm512_loadu_si512(fingerprint + i));
+                total = _mm512_add_epi64(total, _mm512_popcnt_epi64(x));
+            }
+            if (tail) {
+                __m512i x = _mm512_xor_si512(_mm512_maskz_loadu_epi8(tail_mask, query + i),
+                                             _mm512_maskz_loadu_epi8(tail_mask, fingerprint + i));
+                total = _mm512_add_epi64(total, _mm512_popcnt_epi64(x));
+            }
+            distances[j] = sum_64(total);
+        }
+    }
+
+    BIT_STRING_AVX512 static void shift_copy(uint8_t* dst, const uint8_t* src, uint64_t length, uint32_t shift) {
+        const __m128i left = _mm_cvtsi32_si128(shift);
+        const __m128i right = _mm_cvtsi32_si128(8 - shift);
+        const __m512i high_mask = _mm512_set1_epi8(char(0xFF << shift));
+        const __m512i low_mask = _mm512_set1_epi8(char(0xFF >> (8 - shift)));
+        uint64_t i = 0;
+        for (; i + 64 <= length; i += 64) {
+            __m512i current = _mm512_loadu_si512(src + i);
+            __m512i next = _mm512_loadu_si512(src + i + 1);
+            __m512i high = _mm512_and_si512(_mm512_sll_epi16(current, left), high_mask);
+            __m512i low = _mm512_and_si512(_mm512_srl_epi16(next, right), low_mask);
+            _mm512_storeu_si512(dst + i, _mm512_or_si512(high, low));
+        }
+        avx2_kernels::shift_copy(dst + i, src + i, length - i, shift);
+    }
+
+    BIT_STRING_AVX512 static bool parse(uint8_t* dst, const char* chars, uint64_t length) {
+        // Bytes 7, 6, ..., 0, 15, 14, ..., 8 of every 128-bit lane
+        const __m512i reverse = _mm512_set_epi64(0x08090A0B0C0D0E0Fll, 0x0001020304050607ll,
+                                                 0x08090A0B0C0D0E0Fll, 0x0001020304050607ll,
+                                                 0x08090A0B0C0D0E0Fll, 0x0001020304050607ll,
+                                                 0x08090A0B0C0D0E0Fll, 0x0001020304050607ll);
+        const __m512i not_bit_mask = _mm512_set1_epi8(char(0xFE));
+        const __m512i zero_char = _mm512_set1_epi8('0');
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            __m512i str = _mm512_loadu_si512(chars + i * 8);
+            if (_mm512_cmpneq_epi8_mask(_mm512_and_si512(str, not_bit_mask), zero_char) != 0)
+                return false;
+            uint64_t packed = _mm512_test_epi8_mask(_mm512_shuffle_epi8(str, reverse), _mm512_set1_epi8(1));
+            memcpy(dst + i, &packed, sizeof(packed));
+        }
+        return avx2_kernels::parse(dst + i, chars + i * 8, length - i);
+    }
+
+    BIT_STRING_AVX512 static void format(char* dst, const uint8_t* src, uint64_t length, char one, char zero) {
+        // After broadcasting 8 bytes into every 64-bit element, lane k (16 chars) needs bytes 2k and 2k + 1
+        const __m512i spread = _mm512_set_epi64(0x0707070707070707ll, 0x0606060606060606ll,
+                                                0x0505050505050505ll, 0x0404040404040404ll,
+                                                0x0303030303030303ll, 0x0202020202020202ll,
+                                                0x0101010101010101ll, 0x0000000000000000ll);
+        const __m512i bit_masks = _mm512_set1_epi64(0x0102040810204080ll);
+        const __m512i ones = _mm512_set1_epi8(one);
+        const __m512i zeros = _mm512_set1_epi8(zero);
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            uint64_t octet;
+            memcpy(&octet, src + i, sizeof(octet));
+            __m512i bytes = _mm512_shuffle_epi8(_mm512_set1_epi64(int64_t(octet)), spread);
+            __mmask64 is_set = _mm512_test_epi8_mask(bytes, bit_masks);
+            _mm512_storeu_si512(dst + i * 8, _mm512_mask_blend_epi8(is_set, zeros, ones));
+        }
+        avx2_kernels::format(dst + i * 8, src + i, length - i, one, zero);
+    }
+
+    BIT_STRING_AVX512 static bool equal(const uint8_t* a, const uint8_t* b, uint64_t length) {
+        uint64_t i = 0;
+        for (; i + 64 <= length; i += 64) {
+            __m512i x = _mm512_loadu_si512(a + i);
+            __m512i y = _mm512_loadu_si512(b + i);
+            if (_mm512_cmpneq_epi8_mask(x, y) != 0)
+                return false;
+        }
+        return avx2_kernels::equal(a + i, b + i, length - i);
+    }
+
+    BIT_STRING_AVX512 static uint64_t find_any_pair(const uint8_t* data, uint64_t length, const uint8_t* pairs) {
+        __m512i needles[8];
+        for (int k = 0; k < 8; ++k) {
+            int16_t pair;
+            memcpy(&pair, pairs + 2 * k, sizeof(pair));
+            needles[k] = _mm512_set1_epi16(pair);
+        }
+        uint64_t i = 0;
+        for (; i + 64 <= length; i += 64) {
+            __m512i even = _mm512_loadu_si512(data + i);
+            __m512i odd = _mm512_loadu_si512(data + i + 1);
+            __mmask32 even_found = _mm512_cmpeq_epi16_mask(even, needles[0]);
+            __mmask32 odd_found = _mm512_cmpeq_epi16_mask(odd, needles[0]);
+            for (int k = 1; k < 8; ++k) {
+                even_found |= _mm512_cmpeq_epi16_mask(even, needles[k]);
+                odd_found |= _mm512_cmpeq_epi16_mask(odd, needles[k]);
+            }
+            if ((even_found | odd_found) == 0)
+                continue;
+            // Spread the word masks to byte masks, byte 2t is the pair starting at 2t (even) and 2t + 1 (odd)
+            uint64_t mask = (_mm512_movepi8_mask(_mm512_movm_epi16(even_found)) & 0x5555555555555555ull) |
+                            ((_mm512_movepi8_mask(_mm512_movm_epi16(odd_found)) & 0x5555555555555555ull) << 1);
+            return i + scalar_kernels::trailing_zeros_64(mask);
+        }
+        return i + avx2_kernels::find_any_pair(data + i, length - i, pairs);
+    }
+};
+
+#undef BIT_STRING_AVX512
+
+/*====================================================================================================================*/
+/*--------------------------------------------------- BMI2 Kernels ---------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * Selected with the AVX2 and AVX-512 levels on CPUs supporting BMI2
+ */
+struct bmi2_kernels {
+
+    /**
+     * PEXT, as one 32-bit PEXT per half on 32-bit x86
+     */
+    BIT_STRING_TARGET("bmi2") static uint64_t extract_bits(uint64_t value, uint64_t mask) {
+#ifdef BIT_STRING_X86_64
+        return _pext_u64(value, mask);
+#else
+        const uint64_t low = _pext_u32(uint32_t(value), uint32_t(mask));
+        const uint64_t high = _pext_u32(uint32_t(value >> 32), uint32_t(mask >> 32));
+        return low | (high << scalar_kernels::popcount_64(uint32_t(mask)));
+#endif
+    }
+
+    /**
+     * PDEP, as one 32-bit PDEP per half on 32-bit x86
+     */
+    BIT_STRING_TARGET("bmi2") static uint64_t deposit_bits(uint64_t value, uint64_t mask) {
+#ifdef BIT_STRING_X86_64
+        return _pdep_u64(value, mask);
+#else
+        const uint64_t low = _pdep_u32(uint32_t(value), uint32_t(mask));
+        const uint64_t high = _pdep_u32(uint32_t(value >> scalar_kernels::popcount_64(uint32_t(mask))),
+                                        uint32_t(mask >> 32));
+        return low | (high << 32);
+#endif
+    }
+};
+
+#endif // BIT_STRING_X86
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------------- Dispatch -----------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * @return The kernels of the active SIMD level, selected on first use.
+ */
+inline const bit_kernels& bit_kernels::get() {
+    return *active().load(std::memory_order_acquire);
+}
+
+
+/**
+ * @return The most capable SIMD level supported by the running CPU
+ */
+inline simd_level bit_kernels::detected_level() {
+    return cpu_features::get().max_simd_level();
+}
+
+
+/**
+ * @return The SIMD level of the kernels in use
+ */
+inline simd_level bit_kernels::active_level() {
+    return get().level;
+}
+
+
+/**
+ * Force using the kernels of @a level instead of the detected level, i.e. for testing or benchmarking.
+ *
+ * @param level The requested level, lowered to the detected level if the CPU does not support it
+ * @return The level actually used
+ */
+inline simd_level bit_kernels::force_level(simd_level level) {
+    if (level > detected_level())
+        level = detected_level();
+    active().store(&kernels_for(level), std::memory_order_release);
+    return level;
+}
+
+
+inline std::atomic<const bit_kernels*>& bit_kernels::active() {
+    static std::atomic<const bit_kernels*> kernels(nullptr);
+    static bool initialized = [] {
+        simd_level level = detected_level();
+        const char* requested = getenv("BIT_STRING_SIMD_LEVEL");
+        if (requested != nullptr && cpu_features::parse_level(requested, level) && level > detected_level())
+            level = detected_level();
+        kernels.store(&kernels_for(level), std::memory_order_release);
+        return true;
+    }();
+    (void) initialized;
+    return kernels;
+}
+
+
+inline const bit_kernels& bit_kernels::kernels_for(simd_level level) {
+    static const bit_kernels scalar = {
+            simd_level::scalar, scalar_kernels::bitwise_and, scalar_kernels::bitwise_or,
+            scalar_kernels::bitwise_xor, scalar_kernels::bitwise_not, scalar_kernels::popcount,
+            scalar_kernels::shift_copy, scalar_kernels::parse, scalar_kernels::format, scalar_kernels::equal,
+            scalar_kernels::reverse, scalar_kernels::find_any_pair, scalar_kernels::extract_bits,
+            scalar_kernels::deposit_bits, scalar_kernels::hamming_distances
+    };
+#ifdef BIT_STRING_X86
+    static const bit_kernels sse4_2 = {
+            simd_level::sse4_2, sse4_2_kernels::bitwise_and, sse4_2_kernels::bitwise_or,
+            sse4_2_kernels::bitwise_xor, sse4_2_kernels::bitwise_not, sse4_2_kernels::popcount,
+            sse4_2_kernels::shift_copy, sse4_2_kernels::parse, sse4_2_kernels::format, sse4_2_kernels::equal,
+            sse4_2_kernels::reverse, sse4_2_kernels::find_any_pair, scalar_kernels::extract_bits,
+            scalar_kernels::deposit_bits, sse4_2_kernels::hamming_distances
+    };
+    const bool bmi2 = cpu_features::get().bmi2;
+    static const bit_kernels avx2 = {
+            simd_level::avx2, avx2_kernels::bitwise_and, avx2_kernels::bitwise_or,
+            avx2_kernels::bitwise_xor, avx2_kernels::bitwise_not, avx2_kernels::popcount,
+            avx2_kernels::shift_copy, avx2_kernels::parse, avx2_kernels::format, avx2_kernels::equal,
+            avx2_kernels::reverse, avx2_kernels::find_any_pair,
+            bmi2 ? bmi2_kernels::extract_bits : scalar_kernels::extract_bits,
+            bmi2 ? bmi2_kernels::deposit_bits : scalar_kernels::deposit_bits,
+            avx2_kernels::hamming_distances
+    };
+    static const bit_kernels avx512 = {
+            simd_level::avx512, avx512_kernels::bitwise_and, avx512_kernels::bitwise_or,
+            avx512_kernels::bitwise_xor, avx512_kernels::bitwise_not,
+            cpu_features::get().avx512vpopcntdq ? avx512_kernels::popcount : avx2_kernels::popcount,
+            avx512_kernels::shift_copy, avx512_kernels::parse, avx512_kernels::format, avx512_kernels::equal,
+            avx2_kernels::reverse, avx512_kernels::find_any_pair,
+            bmi2 ? bmi2_kernels::extract_bits : scalar_kernels::extract_bits,
+            bmi2 ? bmi2_kernels::deposit_bits : scalar_kernels::deposit_bits,
+            cpu_features::get().avx512vpopcntdq ? avx512_kernels::hamming_distances : avx2_kernels::hamming_distances
+    };
+
+    switch (level) {
+        case simd_level::avx512:
+            return avx512;
+        case simd_level::avx2:
+            return avx2;
+        case simd_level::sse4_2:
+            return sse4_2;
+        default:
+            return scalar;
+    }
+#else
+    (void) level;
+    return scalar;
+#endif
+}
+
+#endif //BIT_KERNELS_H
@@ -0,0 +1,943 @@
+#ifndef BIT_MATRIX_H
+#define BIT_MATRIX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bit_string.h"
+
+template<typename BitOrder>
+class basic_bit_matrix;
+
+/**
+ * Read only view of a row of a %basic_bit_matrix, it has the interface of a const %basic_bit_string over the bits
+ * of the row in the matrix. <br>
+ * The view is invalidated when the matrix is destroyed or reallocated.
+ */
+template<typename BitOrder>
+class basic_const_bit_row {
+
+public:
+
+    typedef basic_bit_string<BitOrder> string_type;
+    typedef typename string_type::const_iterator const_iterator;
+
+    static const uint32_t BYTE = 8;
+
+protected:
+
+    friend class basic_bit_matrix<BitOrder>;
+
+    uint8_t* m_data = nullptr;
+    uint32_t m_size_in_bits = 0;
+
+    basic_const_bit_row(const uint8_t* data, uint32_t size_in_bits);
+
+    void check_position(uint32_t position) const;
+
+    void check_same_size(uint32_t size_in_bits) const;
+
+    void check_field(uint32_t position, uint32_t number_of_bits) const;
+
+    static uint64_t load_word(const uint8_t* data, uint64_t position);
+
+public:
+
+    bool at(uint32_t position) const;
+
+    bool operator [](uint32_t position) const;
+
+    uint64_t get_bits(uint32_t position, uint32_t number_of_bits) const;
+
+    uint32_t count() const;
+
+    string_type to_bit_string() const;
+
+    bool operator ==(const basic_const_bit_row& other) const;
+
+    bool operator ==(const string_type& bits) const;
+
+    bool operator !=(const basic_const_bit_row& other) const;
+
+    bool operator !=(const string_type& bits) const;
+
+    const uint8_t* data() const;
+
+    const_iterator begin() const;
+
+    const_iterator end() const;
+
+    uint32_t size() const;
+
+    uint32_t length() const;
+
+    uint32_t size_in_bytes() const;
+};
+
+
+/**
+ * Mutable view of a row of a %basic_bit_matrix, the row is modified in place with the interface of a
+ * %basic_bit_string. <br>
+ * A view is not assignable from a row to avoid confusion between rebinding it and copying bits, use assign().
+ */
+template<typename BitOrder>
+class basic_bit_row : public basic_const_bit_row<BitOrder> {
+
+    friend class basic_bit_matrix<BitOrder>;
+
+    typedef basic_const_bit_row<BitOrder> base;
+
+    basic_bit_row(uint8_t* data, uint32_t size_in_bits);
+
+public:
+
+    typedef basic_bit_string<BitOrder> string_type;
+    typedef typename string_type::reference reference;
+    typedef typename string_type::iterator iterator;
+
+    using base::at;
+    using base::operator [];
+    using base::begin;
+    using base::end;
+
+    basic_bit_row& operator =(const basic_bit_row&) = delete;
+
+    reference at(uint32_t position);
+
+    reference operator [](uint32_t position);
+
+    void set(uint32_t position, bool bit = true);
+
+    void reset(uint32_t position);
+
+    void flip(uint32_t position);
+
+    void set();
+
+    void reset();
+
+    void set_bits(uint32_t position, uint32_t number_of_bits, uint64_t value);
+
+    void assign(const basic_const_bit_row<BitOrder>& other);
+
+    void assign(const string_type& bits);
+
+    basic_bit_row& operator &=(const basic_const_bit_row<BitOrder>& other);
+
+    basic_bit_row& operator |=(const basic_const_bit_row<BitOrder>& other);
+
+    basic_bit_row& operator ^=(const basic_const_bit_row<BitOrder>& other);
+
+    basic_bit_row& operator &=(const string_type& bits);
+
+    basic_bit_row& operator |=(const string_type& bits);
+
+    basic_bit_row& operator ^=(const string_type& bits);
+
+    uint8_t* data();
+
+    iterator begin();
+
+    iterator end();
+};
+
+
+/**
+ * Dense two dimensional matrix of bits, the rows are stored one after the other in a single buffer, every row
+ * starting at a 64-bit word. <br>
+ * Rows are accessed as %basic_bit_string like views with row(), columns are gathered a word at a time, and the
+ * matrix is transposed by blocks of 64 x 64 bits: a block is 64 words (one from each row), transposed in registers
+ * in 6 rounds of masked swaps, so the transpose costs O(rows * columns / 64 * 6) word operations instead of a
+ * load and a store per bit.
+ *
+ * The padding bits of every row (after number_of_columns()) are always zeros, and a spare word after the last row
+ * allows reading 64 bits from any position of a row.
+ *
+ * @example bit_matrix features(users, 1024);
+ *          features.row(user).set(feature);
+ *          bit_matrix by_feature = features.transposed();  // Every row is now a column of features
+ *          uint32_t users_with_feature = by_feature.row(feature).count();
+ */
+template<typename BitOrder>
+class basic_bit_matrix {
+
+public:
+
+    typedef basic_bit_string<BitOrder> string_type;
+    typedef basic_bit_row<BitOrder> row_type;
+    typedef basic_const_bit_row<BitOrder> const_row_type;
+
+    static const uint32_t BYTE = 8;
+    static const uint32_t WORD_BITS = 64;
+
+private:
+
+    std::vector<uint64_t> m_words;
+    uint32_t m_rows = 0;
+    uint32_t m_columns = 0;
+    uint32_t m_row_words = 0;
+
+    uint8_t* row_data(uint32_t row);
+
+    const uint8_t* row_data(uint32_t row) const;
+
+    void check_row(uint32_t row) const;
+
+    void check_position(uint32_t row, uint32_t column) const;
+
+    static void transpose_block(uint64_t* block);
+
+public:
+
+    basic_bit_matrix() = default;
+
+    basic_bit_matrix(uint32_t number_of_rows, uint32_t number_of_columns, bool value = false);
+
+    static basic_bit_matrix from_rows(const std::vector<string_type>& rows);
+
+    static basic_bit_matrix identity(uint32_t n);
+
+/*===================================================================================================================*/
+
+    row_type row(uint32_t row);
+
+    const_row_type row(uint32_t row) const;
+
+    row_type operator [](uint32_t row);
+
+    const_row_type operator [](uint32_t row) const;
+
+    bool at(uint32_t row, uint32_t column) const;
+
+    void set(uint32_t row, uint32_t column, bool bit = true);
+
+    void reset(uint32_t row, uint32_t column);
+
+    void flip(uint32_t row, uint32_t column);
+
+    void swap_rows(uint32_t a, uint32_t b);
+
+    string_type column(uint32_t column) const;
+
+    basic_bit_matrix column_slice(uint32_t first, uint32_t count) const;
+
+    basic_bit_matrix transposed() const;
+
+/*===================================================================================================================*/
+
+    uint64_t count() const;
+
+    bool operator ==(const basic_bit_matrix& other) const;
+
+    bool operator !=(const basic_bit_matrix& other) const;
+
+    bool empty() const;
+
+    uint32_t number_of_rows() const;
+
+    uint32_t number_of_columns() const;
+
+    uint32_t words_per_row() const;
+};
+
+typedef basic_const_bit_row<msb_first> const_bit_row;
+typedef basic_bit_row<msb_first> bit_row;
+typedef basic_bit_matrix<msb_first> bit_matrix;
+
+typedef basic_const_bit_row<lsb_first> lsb_const_bit_row;
+typedef basic_bit_row<lsb_first> lsb_bit_row;
+typedef basic_bit_matrix<lsb_first> lsb_bit_matrix;
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------- Const Row -------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+template<typename BitOrder>
+basic_const_bit_row<BitOrder>::basic_const_bit_row(const uint8_t* data, uint32_t size_in_bits)
+        : m_data(const_cast<uint8_t*>(data)), m_size_in_bits(size_in_bits) {}
+
+/**
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+bool basic_const_bit_row<BitOrder>::at(uint32_t position) const {
+    check_position(position);
+    return (*this)[position];
+}
+
+template<typename BitOrder>
+bool basic_const_bit_row<BitOrder>::operator [](uint32_t position) const {
+    return (m_data[position / BYTE] >> BitOrder::bit_shift(position % BYTE)) & 1u;
+}
+
+/**
+ * @return The field of @a number_of_bits (0 to 64) bits starting at @a position as an integer, as
+ * basic_bit_string::get_bits()
+ * @throw std::length_error if @a number_of_bits is greater than 64
+ * @throw std::out_of_range if the field exceeds size()
+ */
+template<typename BitOrder>
+uint64_t basic_const_bit_row<BitOrder>::get_bits(uint32_t position, uint32_t number_of_bits) const {
+    check_field(position, number_of_bits);
+    if (number_of_bits == 0)
+        return 0;
+    return BitOrder::to_value(load_word(m_data, position), number_of_bits);
+}
+
+/**
+ * @return Number of bits set to 1
+ */
+template<typename BitOrder>
+uint32_t basic_const_bit_row<BitOrder>::count() const {
+    return uint32_t(bit_kernels::get().popcount(m_data, size_in_bytes()));
+}
+
+/**
+ * @return A copy of the bits of the row
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_const_bit_row<BitOrder>::to_bit_string() const {
+    string_type bits(m_size_in_bits, false);
+    if (m_size_in_bits)
+        memcpy(&bits.at_byte(0), m_data, size_in_bytes());
+    return bits;
+}
+
+template<typename BitOrder>
+bool basic_const_bit_row<BitOrder>::operator ==(const basic_const_bit_row& other) const {
+    return m_size_in_bits == other.m_size_in_bits && bit_kernels::get().equal(m_data, other.m_data, size_in_bytes());
+}
+
+template<typename BitOrder>
+bool basic_const_bit_row<BitOrder>::operator ==(const string_type& bits) const {
+    if (m_size_in_bits != bits.size())
+        return false;
+    bits.fill_extra_bits_with_zeros();
+    return bit_kernels::get().equal(m_data, bits.data(), size_in_bytes());
+}
+
+template<typename BitOrder>
+bool basic_const_bit_row<BitOrder>::operator !=(const basic_const_bit_row& other) const {
+    return !(*this == other);
+}
+
+template<typename BitOrder>
+bool basic_const_bit_row<BitOrder>::operator !=(const string_type& bits) const {
+    return !(*this == bits);
+}
+
+template<typename BitOrder>
+const uint8_t* basic_const_bit_row<BitOrder>::data() const {
+    return m_data;
+}
+
+template<typename BitOrder>
+typename basic_const_bit_row<BitOrder>::const_iterator basic_const_bit_row<BitOrder>::begin() const {
+    return const_iterator(0, m_data);
+}
+
+template<typename BitOrder>
+typename basic_const_bit_row<BitOrder>::const_iterator basic_const_bit_row<BitOrder>::end() const {
+    return const_iterator(m_size_in_bits, m_data);
+}
+
+template<typename BitOrder>
+uint32_t basic_const_bit_row<BitOrder>::size() const {
+    return m_size_in_bits;
+}
+
+template<typename BitOrder>
+uint32_t basic_const_bit_row<BitOrder>::length() const {
+    return m_size_in_bits;
+}
+
+template<typename BitOrder>
+uint32_t basic_const_bit_row<BitOrder>::size_in_bytes() const {
+    return (m_size_in_bits + BYTE - 1) / BYTE;
+}
+
+/**
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+void basic_const_bit_row<BitOrder>::check_position(uint32_t position) const {
+    if (position >= m_size_in_bits) {
+        throw std::out_of_range("Position " + std::to_string(position) + " is out of range of row of size " +
+                                std::to_string(m_size_in_bits));
+    }
+}
+
+/**
+ * @throw std::length_error if @a size_in_bits is not size()
+ */
+template<typename BitOrder>
+void basic_const_bit_row<BitOrder>::check_same_size(uint32_t size_in_bits) const {
+    if (m_size_in_bits != size_in_bits) {
+        throw std::length_error("row sizes do not match " + std::to_string(m_size_in_bits) + " and " +
+                                std::to_string(size_in_bits));
+    }
+}
+
+/**
+ * @throw std::length_error if @a number_of_bits is greater than 64
+ * @throw std::out_of_range if the field exceeds size()
+ */
+template<typename BitOrder>
+void basic_const_bit_row<BitOrder>::check_field(uint32_t position, uint32_t number_of_bits) const {
+    if (number_of_bits > sizeof(uint64_t) * BYTE) {
+        throw std::length_error("number_of_bits Must be between 0 and " + std::to_string(sizeof(uint64_t) * BYTE));
+    }
+    if (uint64_t(position) + number_of_bits > m_size_in_bits) {
+        throw std::out_of_range("Range [" + std::to_string(position) + ", " +
+                                std::to_string(uint64_t(position) + number_of_bits) + ") is out of range of size " +
+                                std::to_string(m_size_in_bits));
+    }
+}
+
+/**
+ * @return The 64 bits starting at @a position of a row, it reads 9 bytes which is safe thanks to the spare word
+ * after the last row of the matrix
+ */
+template<typename BitOrder>
+uint64_t basic_const_bit_row<BitOrder>::load_word(const uint8_t* data, uint64_t position) {
+    const uint32_t word_bits = sizeof(uint64_t) * BYTE;
+    const uint8_t* bytes = data + position / BYTE;
+    const uint32_t shift = position % BYTE;
+    const uint64_t word = BitOrder::skip(BitOrder::load_64(bytes), shift);
+    if (shift == 0)
+        return word;
+    return word | BitOrder::delay(BitOrder::from_value(bytes[sizeof(uint64_t)], BYTE), word_bits - shift);
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------------- Row ----------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+template<typename BitOrder>
+basic_bit_row<BitOrder>::basic_bit_row(uint8_t* data, uint32_t size_in_bits) : base(data, size_in_bits) {}
+
+/**
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+typename basic_bit_row<BitOrder>::reference basic_bit_row<BitOrder>::at(uint32_t position) {
+    base::check_position(position);
+    return reference(position, this->m_data);
+}
+
+template<typename BitOrder>
+typename basic_bit_row<BitOrder>::reference basic_bit_row<BitOrder>::operator [](uint32_t position) {
+    return reference(position, this->m_data);
+}
+
+/**
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+void basic_bit_row<BitOrder>::set(uint32_t position, bool bit) {
+    at(position) = bit;
+}
+
+/**
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+void basic_bit_row<BitOrder>::reset(uint32_t position) {
+    at(position) = false;
+}
+
+/**
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+void basic_bit_row<BitOrder>::flip(uint32_t position) {
+    base::check_position(position);
+    this->m_data[position / base::BYTE] ^= uint8_t(1u << BitOrder::bit_shift(position % base::BYTE));
+}
+
+/**
+ * Set all the bits of the row, the padding bits stay zeros
+ */
+template<typename BitOrder>
+void basic_bit_row<BitOrder>::set() {
+    if (this->m_size_in_bits == 0)
+        return;
+    memset(this->m_data, 0xFF, this->size_in_bytes());
+    const uint32_t extra_bits = this->m_size_in_bits % base::BYTE;
+    if (extra_bits)
+        this->m_data[this->size_in_bytes() - 1] = BitOrder::head_mask(extra_bits);
+}
+
+template<typename BitOrder>
+void basic_bit_row<BitOrder>::reset() {
+    memset(this->m_data, 0, this->size_in_bytes());
+}
+
+/**
+ * Overwrite the field of @a number_of_bits (0 to 64) bits starting at @a position with the least significant bits
+ * of @a value, as basic_bit_string::set_bits()
+ * @throw std::length_error if @a number_of_bits is greater than 64
+ * @throw std::out_of_range if the field exceeds size()
+ */
+template<typename BitOrder>
+void basic_bit_row<BitOrder>::set_bits(uint32_t position, uint32_t number_of_bits, uint64_t value) {
+    base::check_field(position, number_of_bits);
+    if (number_of_bits == 0)
+        return;
+
+    // The 8 bytes starting at byte (and the 9th one) are inside the matrix thanks to its spare word, the bits
+    // outside of the field are stored back unchanged
+    const uint32_t word_bits = sizeof(uint64_t) * base::BYTE;
+    uint8_t* data = this->m_data + position / base::BYTE;
+    const uint32_t shift = position % base::BYTE;
+    const uint64_t field_word = BitOrder::from_value(value, number_of_bits);
+    const uint64_t mask = BitOrder::delay(BitOrder::head_mask_64(number_of_bits), shift);
+    BitOrder::store_64(data, (BitOrder::load_64(data) & ~mask) | (BitOrder::delay(field_word, shift) & mask));
+
+    if (shift + number_of_bits > word_bits) {
+        const uint8_t spill_mask = BitOrder::head_mask(shift + number_of_bits - word_bits);
+        const uint8_t spill = BitOrder::head_byte(BitOrder::skip(field_word, word_bits - shift));
+        data[sizeof(uint64_t)] = (data[sizeof(uint64_t)] & ~spill_mask) | (spill & spill_mask);
+    }
+}
+
+/**
+ * Copy the bits of @a other into this row
+ * @throw std::length_error if the sizes do not match
+ */
+template<typename BitOrder>
+void basic_bit_row<BitOrder>::assign(const basic_const_bit_row<BitOrder>& other) {
+    base::check_same_size(other.size());
+    memmove(this->m_data, other.data(), this->size_in_bytes());
+}
+
+/**
+ * Copy @a bits into this row
+ * @throw std::length_error if the sizes do not match
+ */
+template<typename BitOrder>
+void basic_bit_row<BitOrder>::assign(const string_type& bits) {
+    base::check_same_size(bits.size());
+    bits.fill_extra_bits_with_zeros();
+    memcpy(this->m_data, bits.data(), this->size_in_bytes());
+}
+
+/**
+ * @throw std::length_error if the sizes do not match
+ */
+template<typename BitOrder>
+basic_bit_row<BitOrder>& basic_bit_row<BitOrder>::operator &=(const basic_const_bit_row<BitOrder>& other) {
+    base::check_same_size(other.size());
+    bit_kernels::get().bitwise_and(this->m_data, other.data(), this->size_in_bytes());
+    return *this;
+}
+
+/**
+ * @throw std::length_error if the sizes do not match
+ */
+template<typename BitOrder>
+basic_bit_row<BitOrder>& basic_bit_row<BitOrder>::operator |=(const basic_const_bit_row<BitOrder>& other) {
+    base::check_same_size(other.size());
+    bit_kernels::get().bitwise_or(this->m_data, other.data(), this->size_in_bytes());
+    return *this;
+}
+
+/**
+ * @throw std::length_error if the sizes do not match
+ */
+template<typename BitOrder>
+basic_bit_row<BitOrder>& basic_bit_row<BitOrder>::operator ^=(const basic_const_bit_row<BitOrder>& other) {
+    base::check_same_size(other.size());
+    bit_kernels::get().bitwise_xor(this->m_data, other.data(), this->size_in_bytes());
+    return *this;
+}
+
+/**
+ * @throw std::length_error if the sizes do not match
+ */
+template<typename BitOrder>
+basic_bit_row<BitOrder>& basic_bit_row<BitOrder>::operator &=(const string_type& bits) {
+    base::check_same_size(bits.size());
+    bit_kernels::get().bitwise_and(this->m_data, bits.data(), this->size_in_bytes());
+    return *this;
+}
+
+/**
+ * @throw std::length_error if the sizes do not match
+ */
+template<typename BitOrder>
+basic_bit_row<BitOrder>& basic_bit_row<BitOrder>::operator |=(const string_type& bits) {
+    base::check_same_size(bits.size());
+    bits.fill_extra_bits_with_zeros();
+    bit_kernels::get().bitwise_or(this->m_data, bits.data(), this->size_in_bytes());
+    return *this;
+}
+
+/**
+ * @throw std::length_error if the sizes do not match
+ */
+template<typename BitOrder>
+basic_bit_row<BitOrder>& basic_bit_row<BitOrder>::operator ^=(const string_type& bits) {
+    base::check_same_size(bits.size());
+    bits.fill_extra_bits_with_zeros();
+    bit_kernels::get().bitwise_xor(this->m_data, bits.data(), this->size_in_bytes());
+    return *this;
+}
+
+template<typename BitOrder>
+uint8_t* basic_bit_row<BitOrder>::data() {
+    return this->m_data;
+}
+
+template<typename BitOrder>
+typename basic_bit_row<BitOrder>::iterator basic_bit_row<BitOrder>::begin() {
+    return iterator(0, this->m_data);
+}
+
+template<typename BitOrder>
+typename basic_bit_row<BitOrder>::iterator basic_bit_row<BitOrder>::end() {
+    return iterator(this->m_size_in_bits, this->m_data);
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------ Constructors , Factory methods -----------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @param value The value of all the bits
+ * @throw std::length_error if the matrix exceeds the maximum number of words of a std::vector
+ */
+template<typename BitOrder>
+basic_bit_matrix<BitOrder>::basic_bit_matrix(uint32_t number_of_rows, uint32_t number_of_columns, bool value)
+        : m_rows(number_of_rows), m_columns(number_of_columns),
+          m_row_words(uint32_t((uint64_t(number_of_columns) + WORD_BITS - 1) / WORD_BITS)) {
+    m_words.assign(uint64_t(m_rows) * m_row_words + 1, 0);
+    if (value) {
+        for (uint32_t r = 0; r < m_rows; ++r) {
+            row(r).set();
+        }
+    }
+}
+
+/**
+ * @param rows The rows of the matrix, all of the same size
+ * @throw std::length_error if the rows do not have the same size
+ */
+template<typename BitOrder>
+basic_bit_matrix<BitOrder> basic_bit_matrix<BitOrder>::from_rows(const std::vector<string_type>& rows) {
+    basic_bit_matrix matrix(uint32_t(rows.size()), rows.empty() ? 0 : rows[0].size());
+    for (uint32_t r = 0; r < matrix.m_rows; ++r) {
+        matrix.row(r).assign(rows[r]);
+    }
+    return matrix;
+}
+
+/**
+ * @return The @a n x @a n matrix with ones on the diagonal
+ */
+template<typename BitOrder>
+basic_bit_matrix<BitOrder> basic_bit_matrix<BitOrder>::identity(uint32_t n) {
+    basic_bit_matrix matrix(n, n);
+    for (uint32_t i = 0; i < n; ++i) {
+        matrix.row(i)[i] = true;
+    }
+    return matrix;
+}
+
+
+/*===================================================================================================================*/
+/*--------------------------------------------------- Data Access ---------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return A view of the bits of @a row
+ * @throw std::out_of_range if @a row is greater than or equal number_of_rows()
+ */
+template<typename BitOrder>
+basic_bit_row<BitOrder> basic_bit_matrix<BitOrder>::row(uint32_t row) {
+    check_row(row);
+    return row_type(row_data(row), m_columns);
+}
+
+/**
+ * @copydoc row(uint32_t)
+ */
+template<typename BitOrder>
+basic_const_bit_row<BitOrder> basic_bit_matrix<BitOrder>::row(uint32_t row) const {
+    check_row(row);
+    return const_row_type(row_data(row), m_columns);
+}
+
+/**
+ * @return A view of the bits of @a row, @a row is not checked
+ */
+template<typename BitOrder>
+basic_bit_row<BitOrder> basic_bit_matrix<BitOrder>::operator [](uint32_t row) {
+    return row_type(row_data(row), m_columns);
+}
+
+/**
+ * @copydoc operator[](uint32_t)
+ */
+template<typename BitOrder>
+basic_const_bit_row<BitOrder> basic_bit_matrix<BitOrder>::operator [](uint32_t row) const {
+    return const_row_type(row_data(row), m_columns);
+}
+
+/**
+ * @throw std::out_of_range if @a row or @a column is out of range
+ */
+template<typename BitOrder>
+bool basic_bit_matrix<BitOrder>::at(uint32_t row, uint32_t column) const {
+    check_position(row, column);
+    return (*this)[row][column];
+}
+
+/**
+ * @throw std::out_of_range if @a row or @a column is out of range
+ */
+template<typename BitOrder>
+void basic_bit_matrix<BitOrder>::set(uint32_t row, uint32_t column, bool bit) {
+    check_position(row, column);
+    (*this)[row][column] = bit;
+}
+
+/**
+ * @throw std::out_of_range if @a row or @a column is out of range
+ */
+template<typename BitOrder>
+void basic_bit_matrix<BitOrder>::reset(uint32_t row, uint32_t column) {
+    set(row, column, false);
+}
+
+/**
+ * @throw std::out_of_range if @a row or @a column is out of range
+ */
+template<typename BitOrder>
+void basic_bit_matrix<BitOrder>::flip(uint32_t row, uint32_t column) {
+    check_position(row, column);
+    (*this)[row].flip(column);
+}
+
+/**
+ * Exchange the bits of the rows @a a and @a b
+ * @throw std::out_of_range if @a a or @a b is greater than or equal number_of_rows()
+ */
+template<typename BitOrder>
+void basic_bit_matrix<BitOrder>::swap_rows(uint32_t a, uint32_t b) {
+    check_row(a);
+    check_row(b);
+    uint64_t* first = m_words.data() + uint64_t(a) * m_row_words;
+    std::swap_ranges(first, first + m_row_words, m_words.data() + uint64_t(b) * m_row_words);
+}
+
+/**
+ * Gather the bit @a column of every row, 64 rows at a time into a word
+ *
+ * @return The bits of @a column, one for each row
+ * @throw std::out_of_range if @a column is greater than or equal number_of_columns()
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_matrix<BitOrder>::column(uint32_t column) const {
+    if (column >= m_columns) {
+        throw std::out_of_range("Column " + std::to_string(column) + " is out of range of matrix of " +
+                                std::to_string(m_columns) + " columns");
+    }
+
+    const uint8_t* data = row_data(0) + column / BYTE;
+    const uint32_t shift = BitOrder::bit_shift(column % BYTE);
+    const uint64_t stride = uint64_t(m_row_words) * sizeof(uint64_t);
+
+    string_type bits;
+    bits.reserve(m_rows);
+    for (uint32_t first = 0; first < m_rows; first += WORD_BITS) {
+        const uint32_t length = m_rows - first < WORD_BITS ? m_rows - first : WORD_BITS;
+        uint64_t word = 0;
+        for (uint32_t i = 0; i < length; ++i) {
+            const uint32_t bit = (data[(first + i) * stride] >> shift) & 1u;
+            word |= BitOrder::delay(BitOrder::head_mask_64(bit), i);
+        }
+        bits.append_uint_64(BitOrder::to_value(word, length), length);
+    }
+    return bits;
+}
+
+/**
+ * @return The matrix of the @a count columns starting at @a first, copied a word at a time from every row
+ * @throw std::out_of_range if the columns exceed number_of_columns()
+ */
+template<typename BitOrder>
+basic_bit_matrix<BitOrder> basic_bit_matrix<BitOrder>::column_slice(uint32_t first, uint32_t count) const {
+    if (uint64_t(first) + count > m_columns) {
+        throw std::out_of_range("Columns [" + std::to_string(first) + ", " + std::to_string(uint64_t(first) + count) +
+                                ") are out of range of matrix of " + std::to_string(m_columns) + " columns");
+    }
+
+    basic_bit_matrix slice(m_rows, count);
+    const uint32_t extra_bits = count % WORD_BITS;
+    for (uint32_t r = 0; r < m_rows; ++r) {
+        const uint8_t* source = row_data(r);
+        uint8_t* destination = slice.row_data(r);
+        for (uint32_t k = 0; k < slice.m_row_words; ++k) {
+            uint64_t word = const_row_type::load_word(source, uint64_t(first) + uint64_t(k) * WORD_BITS);
+            if (k + 1 == slice.m_row_words && extra_bits)
+                word &= BitOrder::head_mask_64(extra_bits);
+            BitOrder::store_64(destination + k * sizeof(uint64_t), word);
+        }
+    }
+    return slice;
+}
+
+/**
+ * Transpose by blocks of 64 x 64 bits, the word k of 64 rows is loaded, transposed in place and stored as the word
+ * of 64 rows of the result. Blocks on the edges are padded with zero rows, whose words are not stored back.
+ *
+ * @return The number_of_columns() x number_of_rows() matrix whose bit (i, j) is the bit (j, i) of this matrix
+ */
+template<typename BitOrder>
+basic_bit_matrix<BitOrder> basic_bit_matrix<BitOrder>::transposed() const {
+    basic_bit_matrix result(m_columns, m_rows);
+    uint64_t block[WORD_BITS];
+
+    for (uint32_t first_row = 0; first_row < m_rows; first_row += WORD_BITS) {
+        const uint32_t rows = m_rows - first_row < WORD_BITS ? m_rows - first_row : WORD_BITS;
+        const uint32_t result_word = first_row / WORD_BITS;
+
+        for (uint32_t k = 0; k < m_row_words; ++k) {
+            for (uint32_t i = 0; i < rows; ++i) {
+                block[i] = BitOrder::load_64(row_data(first_row + i) + k * sizeof(uint64_t));
+            }
+            for (uint32_t i = rows; i < WORD_BITS; ++i) {
+                block[i] = 0;
+            }
+
+            transpose_block(block);
+
+            const uint32_t first_column = k * WORD_BITS;
+            const uint32_t columns = m_columns - first_column < WORD_BITS ? m_columns - first_column : WORD_BITS;
+            for (uint32_t j = 0; j < columns; ++j) {
+                BitOrder::store_64(result.row_data(first_column + j) + result_word * sizeof(uint64_t), block[j]);
+            }
+        }
+    }
+    return result;
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------------ Other ------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return Number of bits set to 1
+ */
+template<typename BitOrder>
+uint64_t basic_bit_matrix<BitOrder>::count() const {
+    return bit_kernels::get().popcount(reinterpret_cast<const uint8_t*>(m_words.data()),
+                                       uint64_t(m_rows) * m_row_words * sizeof(uint64_t));
+}
+
+template<typename BitOrder>
+bool basic_bit_matrix<BitOrder>::operator ==(const basic_bit_matrix& other) const {
+    return m_rows == other.m_rows && m_columns == other.m_columns && m_words == other.m_words;
+}
+
+template<typename BitOrder>
+bool basic_bit_matrix<BitOrder>::operator !=(const basic_bit_matrix& other) const {
+    return !(*this == other);
+}
+
+template<typename BitOrder>
+bool basic_bit_matrix<BitOrder>::empty() const {
+    return m_rows == 0 || m_columns == 0;
+}
+
+template<typename BitOrder>
+uint32_t basic_bit_matrix<BitOrder>::number_of_rows() const {
+    return m_rows;
+}
+
+template<typename BitOrder>
+uint32_t basic_bit_matrix<BitOrder>::number_of_columns() const {
+    return m_columns;
+}
+
+/**
+ * @return Number of 64-bit words between the starts of two consecutive rows
+ */
+template<typename BitOrder>
+uint32_t basic_bit_matrix<BitOrder>::words_per_row() const {
+    return m_row_words;
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------- Private Helpers ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+template<typename BitOrder>
+uint8_t* basic_bit_matrix<BitOrder>::row_data(uint32_t row) {
+    return reinterpret_cast<uint8_t*>(m_words.data() + uint64_t(row) * m_row_words);
+}
+
+template<typename BitOrder>
+const uint8_t* basic_bit_matrix<BitOrder>::row_data(uint32_t row) const {
+    return reinterpret_cast<const uint8_t*>(m_words.data() + uint64_t(row) * m_row_words);
+}
+
+/**
+ * @throw std::out_of_range if @a row is greater than or equal number_of_rows()
+ */
+template<typename BitOrder>
+void basic_bit_matrix<BitOrder>::check_row(uint32_t row) const {
+    if (row >= m_rows) {
+        throw std::out_of_range("Row " + std::to_string(row) + " is out of range of matrix of " +
+                                std::to_string(m_rows) + " rows");
+    }
+}
+
+/**
+ * @throw std::out_of_range if @a row or @a column is out of range
+ */
+template<typename BitOrder>
+void basic_bit_matrix<BitOrder>::check_position(uint32_t row, uint32_t column) const {
+    check_row(row);
+    if (column >= m_columns) {
+        throw std::out_of_range("Column " + std::to_string(column) + " is out of range of matrix of " +
+                                std::to_string(m_columns) + " columns");
+    }
+}
+
+/**
+ * Transpose in place the 64 x 64 bits of @a block, whose word i is the row i. <br>
+ * Round j swaps the j x j sub blocks above and below the diagonal of every 2j x 2j block: the last j bits of the
+ * rows k with (k & j) == 0 with the first j bits of the rows k + j.
+ */
+template<typename BitOrder>
+void basic_bit_matrix<BitOrder>::transpose_block(uint64_t* block) {
+    uint64_t mask = ~BitOrder::head_mask_64(WORD_BITS / 2);  // The last half of every 2j bits
+    for (uint32_t j = WORD_BITS / 2; j != 0; j /= 2, mask ^= BitOrder::skip(mask, j)) {
+        for (uint32_t first = 0; first < WORD_BITS; first += 2 * j) {
+            for (uint32_t k = first; k < first + j; ++k) {
+                const uint64_t swapped = (block[k] ^ BitOrder::delay(block[k + j], j)) & mask;
+                block[k] ^= swapped;
+                block[k + j] ^= BitOrder::skip(swapped, j);
+            }
+        }
+    }
+}
+
+#endif //BIT_MATRIX_H
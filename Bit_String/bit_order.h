@@ -0,0 +1,246 @@
+#ifndef BIT_ORDER_H
+#define BIT_ORDER_H
+
+#include <cstdint>
+#include <cstring>
+
+#include "bit_kernels.h"
+
+/**
+ * Bit order policies of basic_bit_string, its iterators and references. <br>
+ * A policy maps the position of a bit to its place inside a byte, and defines the 64-bit words used by the word at
+ * a time algorithms: the word of 8 bytes holds the bits in the order of their positions, starting at the first bit
+ * of the first byte. So moving the bits of a word towards the start is skip(), towards the end is delay(), and the
+ * first n bits of a word as an integer are to_value(), whatever the order is.
+ *
+ * The bulk operations (shift_copy, parse and format) have the same contract as the ones of bit_kernels.
+ */
+
+
+/**
+ * The first bit of a byte is its most significant bit, i.e. [1000 0000] is stored as 0x80. <br>
+ * Integers are stored most significant bit first, and the words are loaded as big endian integers.
+ * This is the natural order of network protocols and of printed binary numbers.
+ */
+struct msb_first {
+
+    static const uint32_t BYTE = 8;
+
+    /**
+     * @return Shift of the bit at @a index (0 to 7) of a byte, it is also the inverse mapping from shift to index
+     */
+    static constexpr uint32_t bit_shift(uint32_t index) {
+        return BYTE - 1 - index;
+    }
+
+    /**
+     * @return Mask of the first @a number_of_bits (0 to 8) bits of a byte
+     */
+    static constexpr uint8_t head_mask(uint32_t number_of_bits) {
+        return uint8_t(0xFF00 >> number_of_bits);
+    }
+
+    /**
+     * @return Mask of the first @a number_of_bits (0 to 64) bits of a word
+     */
+    static uint64_t head_mask_64(uint32_t number_of_bits) {
+        return number_of_bits ? ~uint64_t(0) << (64 - number_of_bits) : 0;
+    }
+
+    /**
+     * @return @a bits moved @a number_of_bits (0 to size - 1) towards the start, the first bits are dropped
+     */
+    template<typename Word>
+    static Word skip(Word bits, uint32_t number_of_bits) {
+        return Word(bits << number_of_bits);
+    }
+
+    /**
+     * @return @a bits moved @a number_of_bits (0 to size - 1) towards the end, the last bits are dropped
+     */
+    template<typename Word>
+    static Word delay(Word bits, uint32_t number_of_bits) {
+        return Word(bits >> number_of_bits);
+    }
+
+    /**
+     * @return The first @a number_of_bits (1 to 64) bits of @a word as an integer
+     */
+    static uint64_t to_value(uint64_t word, uint32_t number_of_bits) {
+        return word >> (64 - number_of_bits);
+    }
+
+    /**
+     * @return A word whose first @a number_of_bits (1 to 64) bits are the low bits of @a value, the others are zeros
+     */
+    static uint64_t from_value(uint64_t value, uint32_t number_of_bits) {
+        return value << (64 - number_of_bits);
+    }
+
+    /**
+     * @return The first 8 bits of @a word as they are stored in a byte
+     */
+    static uint8_t head_byte(uint64_t word) {
+        return uint8_t(word >> 56);
+    }
+
+    /**
+     * @return Index of the first set bit of @a word, 64 if there is none
+     */
+    static uint32_t first_one(uint64_t word) {
+        return scalar_kernels::leading_zeros_64(word);
+    }
+
+    /**
+     * @return Index of the last set bit of @a word, @a word must not be 0
+     */
+    static uint32_t last_one(uint64_t word) {
+        return 63 - scalar_kernels::trailing_zeros_64(word);
+    }
+
+    /**
+     * @return The 8 bytes at @a data as a big endian integer, i.e. data[0] is the most significant byte
+     */
+    static uint64_t load_64(const uint8_t* data) {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        value = __builtin_bswap64(value);
+#elif defined(_MSC_VER)
+        value = _byteswap_uint64(value);
+#elif !defined(__BYTE_ORDER__)
+        value = 0;
+        for (uint32_t i = 0; i < sizeof(value); ++i) {
+            value = (value << BYTE) | data[i];
+        }
+#endif
+        return value;
+    }
+
+    /**
+     * Store @a value at @a data as 8 big endian bytes, i.e. data[0] is the most significant byte
+     */
+    static void store_64(uint8_t* data, uint64_t value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        value = __builtin_bswap64(value);
+#elif defined(_MSC_VER)
+        value = _byteswap_uint64(value);
+#elif !defined(__BYTE_ORDER__)
+        for (uint32_t i = sizeof(value); i > 0; --i) {
+            data[i - 1] = uint8_t(value);
+            value >>= BYTE;
+        }
+        return;
+#endif
+        memcpy(data, &value, sizeof(value));
+    }
+
+    static void shift_copy(uint8_t* dst, const uint8_t* src, uint64_t length, uint32_t shift) {
+        bit_kernels::get().shift_copy(dst, src, length, shift);
+    }
+
+    static bool parse(uint8_t* dst, const char* chars, uint64_t length) {
+        return bit_kernels::get().parse(dst, chars, length);
+    }
+
+    static void format(char* dst, const uint8_t* src, uint64_t length, char one, char zero) {
+        bit_kernels::get().format(dst, src, length, one, zero);
+    }
+};
+
+
+/**
+ * The first bit of a byte is its least significant bit, i.e. [1000 0000] is stored as 0x01. <br>
+ * Integers are stored least significant bit first, and the words are plain little endian loads, so a field is read
+ * with a load, a shift and a mask. This is the order of DEFLATE and of most hardware registers.
+ *
+ * The SIMD kernels of bit_kernels are written for msb_first, the bulk operations here are 64-bit word loops.
+ */
+struct lsb_first {
+
+    static const uint32_t BYTE = 8;
+
+    static constexpr uint32_t bit_shift(uint32_t index) {
+        return index;
+    }
+
+    static constexpr uint8_t head_mask(uint32_t number_of_bits) {
+        return uint8_t(~(0xFF << number_of_bits));
+    }
+
+    static uint64_t head_mask_64(uint32_t number_of_bits) {
+        return number_of_bits ? ~uint64_t(0) >> (64 - number_of_bits) : 0;
+    }
+
+    template<typename Word>
+    static Word skip(Word bits, uint32_t number_of_bits) {
+        return Word(bits >> number_of_bits);
+    }
+
+    template<typename Word>
+    static Word delay(Word bits, uint32_t number_of_bits) {
+        return Word(bits << number_of_bits);
+    }
+
+    static uint64_t to_value(uint64_t word, uint32_t number_of_bits) {
+        return word & head_mask_64(number_of_bits);
+    }
+
+    static uint64_t from_value(uint64_t value, uint32_t number_of_bits) {
+        return value & head_mask_64(number_of_bits);
+    }
+
+    static uint8_t head_byte(uint64_t word) {
+        return uint8_t(word);
+    }
+
+    static uint32_t first_one(uint64_t word) {
+        return scalar_kernels::trailing_zeros_64(word);
+    }
+
+    static uint32_t last_one(uint64_t word) {
+        return 63 - scalar_kernels::leading_zeros_64(word);
+    }
+
+    static uint64_t load_64(const uint8_t* data) {
+        return scalar_kernels::load_64(data);
+    }
+
+    static void store_64(uint8_t* data, uint64_t value) {
+        scalar_kernels::store_64(data, value);
+    }
+
+    static void shift_copy(uint8_t* dst, const uint8_t* src, uint64_t length, uint32_t shift) {
+        uint64_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            store_64(dst + i, (load_64(src + i) >> shift) | (uint64_t(src[i + 8]) << (64 - shift)));
+        }
+        for (; i < length; ++i) {
+            dst[i] = uint8_t(src[i] >> shift) | uint8_t(src[i + 1] << (BYTE - shift));
+        }
+    }
+
+    static bool parse(uint8_t* dst, const char* chars, uint64_t length) {
+        for (uint64_t i = 0; i < length; ++i) {
+            const uint64_t word = scalar_kernels::load_64(chars + i * BYTE);
+            if ((word & 0xFEFEFEFEFEFEFEFEull) != 0x3030303030303030ull)
+                return false;
+            // Move bit 0 of char i into bit (56 + i), then take the high byte
+            dst[i] = ((word & 0x0101010101010101ull) * 0x0102040810204080ull) >> 56;
+        }
+        return true;
+    }
+
+    static void format(char* dst, const uint8_t* src, uint64_t length, char one, char zero) {
+        const uint64_t ones = uint8_t(one) * 0x0101010101010101ull;
+        const uint64_t zeros = uint8_t(zero) * 0x0101010101010101ull;
+        for (uint64_t i = 0; i < length; ++i) {
+            // Keep bit i of the byte in char i, then turn every char into 0x00 or 0xFF
+            const uint64_t bits = (src[i] * 0x0101010101010101ull) & 0x8040201008040201ull;
+            const uint64_t mask = (((bits + 0x7F7F7F7F7F7F7F7Full) & 0x8080808080808080ull) >> 7) * 0xFF;
+            scalar_kernels::store_64(dst + i * BYTE, (mask & ones) | (~mask & zeros));
+        }
+    }
+};
+
+#endif //BIT_ORDER_H
@@ -0,0 +1,208 @@
+#ifndef BIT_READER_H
+#define BIT_READER_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "bit_string.h"
+
+/**
+ * Sequential reader over a %basic_bit_string, for decoding streams of variable length codes. <br>
+ * peek() returns the next 64 bits as a single word of @a BitOrder, so a decoder finds the length of a code with a
+ * count of leading zeros (BitOrder::first_one) and extracts its fields with shifts, then consumes it with skip().
+ *
+ * The reader keeps a pointer to the %bit_string, which must outlive it and must not be modified while reading.
+ *
+ * @example bit_reader reader(bits);
+ *          uint64_t tag = reader.read_bits(4);
+ */
+template<typename BitOrder>
+class basic_bit_reader {
+
+    const basic_bit_string<BitOrder>* m_bits;
+    uint32_t m_position;
+
+public:
+
+    static const uint32_t WORD_BITS = 64;
+
+    explicit basic_bit_reader(const basic_bit_string<BitOrder>& bits, uint32_t position = 0);
+
+    uint32_t position() const;
+
+    uint32_t remaining() const;
+
+    bool at_end() const;
+
+    void seek(uint32_t position);
+
+    uint64_t peek() const;
+
+    void skip(uint32_t number_of_bits);
+
+    bool read_bit();
+
+    uint64_t read_bits(uint32_t number_of_bits);
+
+    template<typename Decode>
+    uint64_t decode_buffered(uint64_t count, Decode decode);
+
+    const basic_bit_string<BitOrder>& bits() const;
+};
+
+typedef basic_bit_reader<msb_first> bit_reader;
+typedef basic_bit_reader<lsb_first> lsb_bit_reader;
+
+
+/**
+ * @param bits The %bit_string to read
+ * @param position Index of the first bit to read
+ * @throw std::out_of_range if @a position is greater than bits.size()
+ */
+template<typename BitOrder>
+basic_bit_reader<BitOrder>::basic_bit_reader(const basic_bit_string<BitOrder>& bits, uint32_t position)
+        : m_bits(&bits), m_position(0) {
+    seek(position);
+}
+
+/**
+ * @return Index of the next bit to read
+ */
+template<typename BitOrder>
+uint32_t basic_bit_reader<BitOrder>::position() const {
+    return m_position;
+}
+
+/**
+ * @return Number of bits left to read
+ */
+template<typename BitOrder>
+uint32_t basic_bit_reader<BitOrder>::remaining() const {
+    return m_bits->size() - m_position;
+}
+
+/**
+ * @return true if all bits were read
+ */
+template<typename BitOrder>
+bool basic_bit_reader<BitOrder>::at_end() const {
+    return m_position == m_bits->size();
+}
+
+/**
+ * Move the reader to @a position
+ *
+ * @throw std::out_of_range if @a position is greater than bits().size()
+ */
+template<typename BitOrder>
+void basic_bit_reader<BitOrder>::seek(uint32_t position) {
+    m_bits->check_position(position);
+    m_position = position;
+}
+
+/**
+ * @return The next 64 bits as a word of @a BitOrder without consuming them, the bits after the end are zeros <br>
+ * i.e. for msb_first the next bit is the most significant bit of the word, for lsb_first the least significant one
+ */
+template<typename BitOrder>
+uint64_t basic_bit_reader<BitOrder>::peek() const {
+    const uint64_t word = m_bits->load_word(m_position);
+    const uint32_t left = remaining();
+    return left >= WORD_BITS ? word : word & BitOrder::head_mask_64(left);
+}
+
+/**
+ * Consume @a number_of_bits bits
+ *
+ * @throw std::out_of_range if less than @a number_of_bits bits are left
+ */
+template<typename BitOrder>
+void basic_bit_reader<BitOrder>::skip(uint32_t number_of_bits) {
+    m_bits->check_range(m_position, number_of_bits);
+    m_position += number_of_bits;
+}
+
+/**
+ * Read a single bit
+ *
+ * @throw std::out_of_range if all bits were read
+ */
+template<typename BitOrder>
+bool basic_bit_reader<BitOrder>::read_bit() {
+    const bool bit = BitOrder::to_value(peek(), 1);
+    skip(1);
+    return bit;
+}
+
+/**
+ * Read a field of @a number_of_bits, the same as bits().get_bits(position(), number_of_bits) and then skipping it
+ *
+ * @param number_of_bits Size of the field, between 0 and 64
+ * @return The field, right aligned
+ * @throw std::length_error if number_of_bits is greater than 64
+ * @throw std::out_of_range if less than @a number_of_bits bits are left
+ */
+template<typename BitOrder>
+uint64_t basic_bit_reader<BitOrder>::read_bits(uint32_t number_of_bits) {
+    m_bits->check_field_size(number_of_bits);
+    if (number_of_bits == 0)
+        return 0;
+    const uint64_t value = BitOrder::to_value(peek(), number_of_bits);
+    skip(number_of_bits);
+    return value;
+}
+
+/**
+ * Decode up to @a count codes with @a decode from a bit buffer, then move the reader after the decoded codes. <br>
+ * The buffer is refilled without branches by an unaligned load of 8 bytes, so it always holds at least 56 bits of
+ * the stream and there is no bounds check per code. It stops before the last 8 bytes of the stream, the remaining
+ * codes must be read with peek() and skip().
+ *
+ * @param count Maximum number of codes to decode
+ * @param decode Called as decode(buffer, available, index) for the index-th code (from 0), where the first
+ *               @a available bits of @a buffer are the next bits of the stream, it returns the length of the code
+ *               or 0 if it can not be decoded from these bits
+ * @return Number of codes decoded, the first code not decoded is at position()
+ * @throw std::out_of_range if the last decoded code ends after the end of the stream
+ */
+template<typename BitOrder>
+template<typename Decode>
+uint64_t basic_bit_reader<BitOrder>::decode_buffered(uint64_t count, Decode decode) {
+    const uint32_t BYTE = 8;
+    const uint8_t* data = m_bits->m_data;
+    const uint8_t* end = data + m_bits->size_in_bytes();
+
+    // The buffer holds the bits [next * 8 - available, next * 8) of the stream in its first available bits
+    const uint8_t* next = data + m_position / BYTE;
+    uint64_t buffer = 0;
+    uint32_t available = 0;
+    uint32_t skipped = m_position % BYTE;
+
+    uint64_t i = 0;
+    for (; i < count && next + sizeof(uint64_t) <= end; ++i) {
+        buffer |= BitOrder::delay(BitOrder::load_64(next), available);
+        next += (WORD_BITS - 1 - available) / BYTE;
+        available |= WORD_BITS - BYTE;
+
+        buffer = BitOrder::skip(buffer, skipped);
+        available -= skipped;
+
+        skipped = decode(buffer, available, i);
+        if (skipped == 0)
+            break;
+    }
+
+    seek(uint32_t((next - data) * BYTE - available + skipped));
+    return i;
+}
+
+/**
+ * @return The %bit_string being read
+ */
+template<typename BitOrder>
+const basic_bit_string<BitOrder>& basic_bit_reader<BitOrder>::bits() const {
+    return *m_bits;
+}
+
+#endif //BIT_READER_H
@@ -3,7 +3,13 @@
 
 #include <cstdint>
 
-class bit_reference {
+#include "bit_order.h"
+
+/**
+ * Proxy to a single bit of a basic_bit_string, the place of the bit inside its byte is given by @a BitOrder
+ */
+template<typename BitOrder>
+class basic_bit_reference {
 
     uint64_t m_array_index : 61;
     uint64_t m_bit_index : 3;
@@ -12,17 +18,17 @@ class bit_reference {
 
 public:
 
-    bit_reference(uint64_t position, uint8_t * data) : m_data(data) {
+    basic_bit_reference(uint64_t position, uint8_t * data) : m_data(data) {
         const uint32_t BYTE = 8;
         m_array_index = position / BYTE;
-        m_bit_index = BYTE - position % BYTE - 1;
+        m_bit_index = BitOrder::bit_shift(position % BYTE);
     }
 
     operator bool() const {
         return (m_data[m_array_index] >> m_bit_index) & 1u;
     }
 
-    bit_reference& operator =(bool value) {
+    basic_bit_reference& operator =(bool value) {
 
         if (value) {
             m_data[m_array_index] |= 1u << m_bit_index;
@@ -33,54 +39,59 @@ public:
         return *this;
     }
 
-    bit_reference& operator =(const bit_reference& bit_ref) {
+    basic_bit_reference& operator =(const basic_bit_reference& bit_ref) {
         if (&bit_ref == this) // Check for self assignment
             return *this;
         return *this = bool(bit_ref);
     }
 
-    bool operator ==(const bit_reference& rhs) const {
+    bool operator ==(const basic_bit_reference& rhs) const {
         return bool(*this) == bool(rhs);
     }
 
-    bool operator !=(const bit_reference& rhs) const {
+    bool operator !=(const basic_bit_reference& rhs) const {
         return !(rhs == *this);
     }
 
-    bool operator <(const bit_reference& rhs) const {
+    bool operator <(const basic_bit_reference& rhs) const {
         return bool(*this) < bool(rhs);
     }
 
-    bool operator >(const bit_reference& rhs) const {
+    bool operator >(const basic_bit_reference& rhs) const {
         return rhs < *this;
     }
 
-    bool operator <=(const bit_reference& rhs) const {
+    bool operator <=(const basic_bit_reference& rhs) const {
         return !(rhs < *this);
     }
 
-    bool operator >=(const bit_reference& rhs) const {
+    bool operator >=(const basic_bit_reference& rhs) const {
         return !(*this < rhs);
     }
 
 };
 
-inline void swap(bit_reference x, bit_reference y) noexcept {
+template<typename BitOrder>
+inline void swap(basic_bit_reference<BitOrder> x, basic_bit_reference<BitOrder> y) noexcept {
     bool temp = x;
     x = y;
     y = temp;
 }
 
-inline void swap(bit_reference x, bool& y) noexcept {
+template<typename BitOrder>
+inline void swap(basic_bit_reference<BitOrder> x, bool& y) noexcept {
     bool temp = x;
     x = y;
     y = temp;
 }
 
-inline void swap(bool& x, bit_reference y) noexcept {
+template<typename BitOrder>
+inline void swap(bool& x, basic_bit_reference<BitOrder> y) noexcept {
     bool temp = x;
     x = y;
     y = temp;
 }
 
+typedef basic_bit_reference<msb_first> bit_reference;
+
 #endif //BIT_REFERENCE_H
@@ -0,0 +1,461 @@
+#ifndef BIT_ROPE_H
+#define BIT_ROPE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bit_string.h"
+
+/**
+ * Sequence of bits made of ranges of shared, immutable %basic_bit_string chunks, for assembling a large
+ * %bit_string from many pieces without copying them. <br>
+ * Appending a %bit_string moves it into a reference counted chunk and appending a rope shares its chunks, so
+ * concatenation never copies bits and costs O(1) amortized per chunk. at() and substr() find the chunk of a position
+ * with a binary search over the prefix sums of the chunk sizes, in O(log n) for n chunks. flatten() copies all
+ * chunks into a single %bit_string in one pass with one allocation.
+ *
+ * The chunks are held by std::shared_ptr<const basic_bit_string>, a %bit_string must not be modified after it was
+ * shared with a rope.
+ *
+ * @example bit_rope frame;
+ *          frame.append(std::move(header));
+ *          frame.append(std::move(payload));
+ *          bit_string bits = frame.flatten();
+ */
+template<typename BitOrder>
+class basic_bit_rope {
+
+public:
+
+    typedef basic_bit_string<BitOrder> string_type;
+
+    /**
+     * A range [start, start + length) of a shared %bit_string
+     */
+    class chunk {
+
+        std::shared_ptr<const string_type> m_bits;
+        uint32_t m_start;
+        uint32_t m_length;
+
+    public:
+
+        chunk(std::shared_ptr<const string_type> bits, uint32_t start, uint32_t length)
+                : m_bits(std::move(bits)), m_start(start), m_length(length) {}
+
+        const string_type& bits() const {
+            return *m_bits;
+        }
+
+        const std::shared_ptr<const string_type>& shared_bits() const {
+            return m_bits;
+        }
+
+        uint32_t start() const {
+            return m_start;
+        }
+
+        uint32_t length() const {
+            return m_length;
+        }
+
+        string_type to_bit_string() const {
+            return m_bits->substr(m_start, m_length);
+        }
+    };
+
+    typedef typename std::vector<chunk>::const_iterator chunk_iterator;
+
+private:
+
+    std::vector<chunk> m_chunks;
+    std::vector<uint64_t> m_ends;  // m_ends[i] is the position after the last bit of chunk i
+
+    uint32_t find_chunk(uint64_t position) const;
+
+    uint64_t chunk_start(uint32_t index) const;
+
+    void check_range(uint64_t position, uint64_t length) const;
+
+    void push_chunk(std::shared_ptr<const string_type> bits, uint32_t start, uint32_t length);
+
+public:
+
+    basic_bit_rope() = default;
+
+    explicit basic_bit_rope(string_type bits);
+
+    explicit basic_bit_rope(std::shared_ptr<const string_type> bits);
+
+/*===================================================================================================================*/
+
+    void append(string_type&& bits);
+
+    void append(const string_type& bits);
+
+    void append(std::shared_ptr<const string_type> bits);
+
+    void append(std::shared_ptr<const string_type> bits, uint32_t start, uint32_t length);
+
+    void append(const basic_bit_rope& rope);
+
+    void operator +=(string_type&& bits);
+
+    void operator +=(const string_type& bits);
+
+    void operator +=(const basic_bit_rope& rope);
+
+    void clear();
+
+/*===================================================================================================================*/
+
+    bool at(uint64_t position) const;
+
+    bool operator [](uint64_t position) const;
+
+    basic_bit_rope substr(uint64_t start) const;
+
+    basic_bit_rope substr(uint64_t start, uint64_t length) const;
+
+    string_type flatten() const;
+
+/*===================================================================================================================*/
+
+    uint32_t number_of_chunks() const;
+
+    const chunk& chunk_at(uint32_t index) const;
+
+    chunk_iterator begin_chunks() const;
+
+    chunk_iterator end_chunks() const;
+
+/*===================================================================================================================*/
+
+    bool empty() const;
+
+    uint64_t size() const;
+
+    uint64_t length() const;
+};
+
+typedef basic_bit_rope<msb_first> bit_rope;
+typedef basic_bit_rope<lsb_first> lsb_bit_rope;
+
+
+/**
+ * Construct a rope of a single chunk, @a bits is moved (or copied) into it
+ */
+template<typename BitOrder>
+basic_bit_rope<BitOrder>::basic_bit_rope(string_type bits) {
+    append(std::move(bits));
+}
+
+/**
+ * Construct a rope of a single chunk sharing @a bits
+ */
+template<typename BitOrder>
+basic_bit_rope<BitOrder>::basic_bit_rope(std::shared_ptr<const string_type> bits) {
+    append(std::move(bits));
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------- Concatenation ---------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * Push %bits to the end of the rope as a new chunk, without copying them
+ *
+ * @param bits %bit_string instance, it is moved into the chunk
+ */
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::append(string_type&& bits) {
+    if (!bits.empty())
+        append(std::make_shared<const string_type>(std::move(bits)));
+}
+
+/**
+ * Push a copy of %bits to the end of the rope as a new chunk <br>
+ * Prefer the overloads moving or sharing the %bit_string, which do not copy it
+ *
+ * @param bits %bit_string instance
+ */
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::append(const string_type& bits) {
+    if (!bits.empty())
+        append(std::make_shared<const string_type>(bits));
+}
+
+/**
+ * Push a shared %bit_string to the end of the rope as a new chunk
+ *
+ * @param bits Shared %bit_string, it must not be modified while the rope uses it
+ */
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::append(std::shared_ptr<const string_type> bits) {
+    if (!bits)
+        throw std::invalid_argument("bits is null");
+    const uint32_t length = bits->size();
+    push_chunk(std::move(bits), 0, length);
+}
+
+/**
+ * Push the range [start, start + length) of a shared %bit_string to the end of the rope as a new chunk
+ *
+ * @param bits Shared %bit_string, it must not be modified while the rope uses it
+ * @param start Index of the first bit of the range
+ * @param length Number of bits of the range
+ * @throw std::out_of_range if the range exceeds bits->size()
+ */
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::append(std::shared_ptr<const string_type> bits, uint32_t start, uint32_t length) {
+    if (!bits)
+        throw std::invalid_argument("bits is null");
+    if (start > bits->size() || length > bits->size() - start) {
+        throw std::out_of_range("Range [" + std::to_string(start) + ", " + std::to_string(uint64_t(start) + length) +
+                                ") is out of range of size " + std::to_string(bits->size()));
+    }
+    push_chunk(std::move(bits), start, length);
+}
+
+/**
+ * Push all chunks of @a rope to the end of this rope, they are shared and not copied
+ */
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::append(const basic_bit_rope& rope) {
+    if (&rope == this) {
+        const basic_bit_rope copy(rope);
+        append(copy);
+        return;
+    }
+    for (const chunk& piece : rope.m_chunks) {
+        push_chunk(piece.shared_bits(), piece.start(), piece.length());
+    }
+}
+
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::operator +=(string_type&& bits) {
+    append(std::move(bits));
+}
+
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::operator +=(const string_type& bits) {
+    append(bits);
+}
+
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::operator +=(const basic_bit_rope& rope) {
+    append(rope);
+}
+
+/**
+ * Remove all chunks, the %bit_strings no longer shared are freed
+ */
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::clear() {
+    m_chunks.clear();
+    m_ends.clear();
+}
+
+
+/*===================================================================================================================*/
+/*--------------------------------------------------- Access --------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return The bit at @a position, in O(log n) for n chunks
+ * @throw std::out_of_range if @a position is greater than or equal size()
+ */
+template<typename BitOrder>
+bool basic_bit_rope<BitOrder>::at(uint64_t position) const {
+    if (position >= size()) {
+        throw std::out_of_range("Position " + std::to_string(position) + " is out of range of size " +
+                                std::to_string(size()));
+    }
+    const uint32_t index = find_chunk(position);
+    const chunk& piece = m_chunks[index];
+    return piece.bits()[piece.start() + uint32_t(position - chunk_start(index))];
+}
+
+template<typename BitOrder>
+bool basic_bit_rope<BitOrder>::operator [](uint64_t position) const {
+    return at(position);
+}
+
+/**
+ * @param start Index of first bit.
+ * @return A new rope starting at @a start to the end, sharing the chunks of this rope
+ */
+template<typename BitOrder>
+basic_bit_rope<BitOrder> basic_bit_rope<BitOrder>::substr(uint64_t start) const {
+    check_range(start, 0);
+    return substr(start, size() - start);
+}
+
+/**
+ * The chunks in the range are shared and not copied, the first and last ones are narrowed to the range. <br>
+ * It costs O(log n + m) for n chunks in the rope and m chunks in the range.
+ *
+ * @param start Index of first bit.
+ * @param length The number of bits to take.
+ * @return A new rope starting at @a start with length of @a length, sharing the chunks of this rope
+ * @throw std::out_of_range if the range exceeds size()
+ */
+template<typename BitOrder>
+basic_bit_rope<BitOrder> basic_bit_rope<BitOrder>::substr(uint64_t start, uint64_t length) const {
+    check_range(start, length);
+    basic_bit_rope rope;
+    if (length == 0)
+        return rope;
+
+    const uint64_t end = start + length;
+    const uint32_t first = find_chunk(start);
+    const uint32_t last = find_chunk(end - 1);
+    rope.m_chunks.reserve(last - first + 1);
+    rope.m_ends.reserve(last - first + 1);
+
+    for (uint32_t index = first; index <= last; ++index) {
+        const chunk& piece = m_chunks[index];
+        const uint64_t piece_start = chunk_start(index);
+        const uint64_t from = std::max(start, piece_start);
+        const uint64_t to = std::min(end, m_ends[index]);
+        rope.push_chunk(piece.shared_bits(), piece.start() + uint32_t(from - piece_start), uint32_t(to - from));
+    }
+    return rope;
+}
+
+/**
+ * Copy all chunks into a single contiguous %bit_string, in one pass after a single allocation
+ *
+ * @throw std::length_error if size() exceeds the maximum size of a %bit_string
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_rope<BitOrder>::flatten() const {
+    if (size() > UINT32_MAX) {
+        throw std::length_error("Size " + std::to_string(size()) + " exceeds the maximum size of a bit_string");
+    }
+
+    string_type bits;
+    bits.reserve(size());
+    uint64_t position = 0;
+    for (const chunk& piece : m_chunks) {
+        string_type::copy_bits(bits.m_data, position, piece.bits().m_data, piece.start(), piece.length());
+        position += piece.length();
+    }
+    bits.m_size_in_bits = uint32_t(position);
+    bits.fill_extra_bits_with_zeros();
+    return bits;
+}
+
+
+/*===================================================================================================================*/
+/*--------------------------------------------------- Chunks --------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return Number of chunks, empty pieces are never stored
+ */
+template<typename BitOrder>
+uint32_t basic_bit_rope<BitOrder>::number_of_chunks() const {
+    return uint32_t(m_chunks.size());
+}
+
+/**
+ * @throw std::out_of_range if @a index is greater than or equal number_of_chunks()
+ */
+template<typename BitOrder>
+const typename basic_bit_rope<BitOrder>::chunk& basic_bit_rope<BitOrder>::chunk_at(uint32_t index) const {
+    return m_chunks.at(index);
+}
+
+/**
+ * @return Iterator to the first chunk, for streaming the bits in order without flattening
+ */
+template<typename BitOrder>
+typename basic_bit_rope<BitOrder>::chunk_iterator basic_bit_rope<BitOrder>::begin_chunks() const {
+    return m_chunks.begin();
+}
+
+template<typename BitOrder>
+typename basic_bit_rope<BitOrder>::chunk_iterator basic_bit_rope<BitOrder>::end_chunks() const {
+    return m_chunks.end();
+}
+
+
+/*===================================================================================================================*/
+/*-------------------------------------------------- Capacity -------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+template<typename BitOrder>
+bool basic_bit_rope<BitOrder>::empty() const {
+    return m_chunks.empty();
+}
+
+template<typename BitOrder>
+uint64_t basic_bit_rope<BitOrder>::size() const {
+    return m_ends.empty() ? 0 : m_ends.back();
+}
+
+template<typename BitOrder>
+uint64_t basic_bit_rope<BitOrder>::length() const {
+    return size();
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------- Private Helpers ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return Index of the chunk holding the bit at @a position, which must be less than size()
+ */
+template<typename BitOrder>
+uint32_t basic_bit_rope<BitOrder>::find_chunk(uint64_t position) const {
+    return uint32_t(std::upper_bound(m_ends.begin(), m_ends.end(), position) - m_ends.begin());
+}
+
+/**
+ * @return Position of the first bit of the chunk at @a index in the rope
+ */
+template<typename BitOrder>
+uint64_t basic_bit_rope<BitOrder>::chunk_start(uint32_t index) const {
+    return index == 0 ? 0 : m_ends[index - 1];
+}
+
+/**
+ * @throw std::out_of_range if the range [position, position + length) exceeds size()
+ */
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::check_range(uint64_t position, uint64_t length) const {
+    if (position > size() || length > size() - position) {
+        throw std::out_of_range("Range [" + std::to_string(position) + ", " + std::to_string(position + length) +
+                                ") is out of range of size " + std::to_string(size()));
+    }
+}
+
+/**
+ * Append a chunk and its end position, empty ranges are dropped
+ */
+template<typename BitOrder>
+void basic_bit_rope<BitOrder>::push_chunk(std::shared_ptr<const string_type> bits, uint32_t start, uint32_t length) {
+    if (length == 0)
+        return;
+    m_ends.push_back(size() + length);
+    try {
+        m_chunks.emplace_back(std::move(bits), start, length);
+    } catch (...) {
+        m_ends.pop_back();
+        throw;
+    }
+}
+
+#endif //BIT_ROPE_H
@@ -6,24 +6,63 @@
 #include <string>
 #include <stdexcept>
 #include <iostream>
+#include <vector>
+#include <utility>
 
+#include "bit_order.h"
 #include "bit_reference.h"
 #include "bit_iterator.h"
 #include "const_bit_iterator.h"
+#include "bit_kernels.h"
+#include "bit_string_stats.h"
 
-class bit_string {
+/**
+ * Dynamic array of bits with an interface similar to std::string and std::vector. <br>
+ * @a BitOrder is the order of the bits inside every byte and of the bits of integers, msb_first (%bit_string) or
+ * lsb_first (%lsb_bit_string), see bit_order.h. Both store bit i in byte i / 8, so they only differ in the raw bytes
+ * returned by data() and in the integer conversions: append_uint_64(6, 3) appends [110] to a %bit_string and [011]
+ * to a %lsb_bit_string, and get_bits() reverses it.
+ */
+template<typename BitOrder>
+class basic_bit_string {
 
 public:
-    typedef bit_iterator                            iterator;
-    typedef const_bit_iterator                      const_iterator;
+    typedef basic_bit_iterator<BitOrder>            iterator;
+    typedef basic_const_bit_iterator<BitOrder>      const_iterator;
+    typedef basic_bit_reference<BitOrder>           reference;
     typedef std::reverse_iterator<iterator>         reverse_iterator;
     typedef std::reverse_iterator<const_iterator>   const_reverse_iterator;
 
     static const uint32_t BYTE = 8;
     static const uint32_t SMALL_BUFFER_SIZE = 8;
 
+    // Returned by the search functions when there is no match
+    static const uint32_t npos = UINT32_MAX;
+
 private:
 
+    friend class packed_int_vector;
+
+    friend class elias_fano_sequence;
+
+    friend class bit_string_sort;
+
+    template<typename Order>
+    friend class basic_bit_reader;
+
+    template<typename Order>
+    friend class basic_bit_rope;
+
+    template<typename Order>
+    friend class basic_shared_bit_string;
+
+    template<typename Order>
+    friend uint32_t hamming_distance(const basic_bit_string<Order>& a, const basic_bit_string<Order>& b);
+
+    template<typename Order>
+    friend bool hamming_distance_at_most(const basic_bit_string<Order>& a, const basic_bit_string<Order>& b,
+                                         uint32_t threshold);
+
     uint32_t m_size_in_bits = 0;
     uint32_t m_capacity_in_bytes = SMALL_BUFFER_SIZE;
 
@@ -36,37 +75,37 @@ public:
 
 /*-------------------------------------------- C++ Rule of Five Functions --------------------------------------------*/
 
-    bit_string& operator =(const bit_string& other);  // Copy Assignment Operator
+    basic_bit_string& operator =(const basic_bit_string& other);  // Copy Assignment Operator
 
-    bit_string& operator =(bit_string&& other) noexcept;  // Move Assignment Operator
+    basic_bit_string& operator =(basic_bit_string&& other) noexcept;  // Move Assignment Operator
 
-    bit_string(const bit_string& other);  // Copy Constructor
+    basic_bit_string(const basic_bit_string& other);  // Copy Constructor
 
-    bit_string(bit_string&& other) noexcept;  // Move Constructor
+    basic_bit_string(basic_bit_string&& other) noexcept;  // Move Constructor
 
-    ~bit_string();  // Destructor
+    ~basic_bit_string();  // Destructor
 
 /*------------------------------------------ Constructors , Factory methods ------------------------------------------*/
 
-    bit_string() = default;
+    basic_bit_string() = default;
 
-    explicit bit_string(uint32_t number_of_elements);
+    explicit basic_bit_string(uint32_t number_of_elements);
 
-    bit_string(uint32_t number_of_elements, bool value);
+    basic_bit_string(uint32_t number_of_elements, bool value);
 
-    static bit_string from_uint_16(uint16_t value, uint8_t number_of_bits = sizeof(uint16_t) * BYTE);
+    static basic_bit_string from_uint_16(uint16_t value, uint8_t number_of_bits = sizeof(uint16_t) * BYTE);
 
-    static bit_string from_uint_32(uint32_t value, uint8_t number_of_bits = sizeof(uint32_t) * BYTE);
+    static basic_bit_string from_uint_32(uint32_t value, uint8_t number_of_bits = sizeof(uint32_t) * BYTE);
 
-    static bit_string from_uint_64(uint64_t value, uint8_t number_of_bits = sizeof(uint64_t) * BYTE);
+    static basic_bit_string from_uint_64(uint64_t value, uint8_t number_of_bits = sizeof(uint64_t) * BYTE);
 
-    static bit_string from_string(const std::string& str, uint64_t start = 0, int64_t length = -1);
+    static basic_bit_string from_string(const std::string& str, uint64_t start = 0, int64_t length = -1);
 
-    static bit_string from_string(const char* str, uint64_t start = 0, int64_t length = -1);
+    static basic_bit_string from_string(const char* str, uint64_t start = 0, int64_t length = -1);
 
-    static bit_string from_data(const std::string& str, uint64_t start = 0, int64_t length = -1);
+    static basic_bit_string from_data(const std::string& str, uint64_t start = 0, int64_t length = -1);
 
-    static bit_string from_data(const void* data, uint64_t length);
+    static basic_bit_string from_data(const void* data, uint64_t length);
 
 /*---------------------------------------------------- Insertions ----------------------------------------------------*/
 
@@ -74,7 +113,27 @@ public:
 
     void pop_back(uint32_t number_of_bits = 1);
 
-    void append(const bit_string& bits);
+    void insert(uint32_t position, bool bit);
+
+    void insert(uint32_t position, uint32_t number_of_bits, bool bit);
+
+    void insert(uint32_t position, const basic_bit_string& bits);
+
+    void erase(uint32_t position, int64_t length = -1);
+
+    void set();
+
+    void set(uint32_t position, uint32_t length, bool bit = true);
+
+    void reset();
+
+    void reset(uint32_t position, uint32_t length);
+
+    void flip();
+
+    void flip(uint32_t position, uint32_t length);
+
+    void append(const basic_bit_string& bits);
 
     void append(const char* bits, uint32_t start = 0, int32_t length = -1);
 
@@ -92,7 +151,7 @@ public:
 
     void append_uint_64(uint64_t value, uint32_t number_of_bits = sizeof(uint64_t) * BYTE);
 
-    void operator +=(const bit_string& bits);
+    void operator +=(const basic_bit_string& bits);
 
     void operator +=(const char* bits);
 
@@ -106,17 +165,25 @@ public:
 
 /*--------------------------------------------------- Data Access ---------------------------------------------------*/
 
-    bit_string substr(uint32_t start) const;
+    basic_bit_string substr(uint32_t start) const;
+
+    basic_bit_string substr(uint32_t start, uint32_t length) const;
 
-    bit_string substr(uint32_t start, uint32_t length) const;
+    uint64_t get_bits(uint32_t position, uint32_t number_of_bits) const;
+
+    void set_bits(uint32_t position, uint32_t number_of_bits, uint64_t value);
+
+    basic_bit_string extract(const basic_bit_string& mask) const;
+
+    void deposit(const basic_bit_string& mask, const basic_bit_string& bits);
 
     bool at(uint32_t position) const;
 
-    bit_reference at(uint32_t position);
+    reference at(uint32_t position);
 
     bool operator [](uint32_t position) const;
 
-    bit_reference operator [](uint32_t position);
+    reference operator [](uint32_t position);
 
     uint8_t at_byte(uint32_t position) const;
 
@@ -132,19 +199,27 @@ public:
 
     bool last_bit() const;
 
-    bit_reference last_bit();
+    reference last_bit();
 
     bool back() const;
 
-    bit_reference back();
+    reference back();
 
     bool first_bit() const;
 
-    bit_reference first_bit();
+    reference first_bit();
 
     bool front() const;
 
-    bit_reference front();
+    reference front();
+
+/*------------------------------------------------------ Search ------------------------------------------------------*/
+
+    uint32_t find(const basic_bit_string& pattern, uint32_t start = 0) const;
+
+    uint32_t rfind(const basic_bit_string& pattern, uint32_t start = npos) const;
+
+    std::vector<uint32_t> find_all(const basic_bit_string& pattern) const;
 
 /*------------------------------------------------------ Memory ------------------------------------------------------*/
 
@@ -160,6 +235,8 @@ public:
 
     void shrink_to_fit();
 
+    void swap(basic_bit_string& other) noexcept;
+
 /*---------------------------------------------------- Convertors ----------------------------------------------------*/
 
     std::string to_string(char one = '1', char zero = '0') const;
@@ -174,13 +251,13 @@ public:
 
 /*---------------------------------------------------- Iterators ----------------------------------------------------*/
 
-    bit_iterator begin();
+    iterator begin();
 
-    const_bit_iterator begin() const;
+    const_iterator begin() const;
 
-    bit_iterator end();
+    iterator end();
 
-    const_bit_iterator end() const;
+    const_iterator end() const;
 
     reverse_iterator rbegin();
 
@@ -200,9 +277,21 @@ public:
 
 /*------------------------------------------------------ Other ------------------------------------------------------*/
 
-    bool operator ==(const bit_string& other) const;
+    bool operator ==(const basic_bit_string& other) const;
+
+    bool operator !=(const basic_bit_string& other) const;
+
+    basic_bit_string& operator &=(const basic_bit_string& other);
+
+    basic_bit_string& operator |=(const basic_bit_string& other);
 
-    bool operator !=(const bit_string& other) const;
+    basic_bit_string& operator ^=(const basic_bit_string& other);
+
+    uint32_t count() const;
+
+    void reverse();
+
+    basic_bit_string reversed() const;
 
     bool empty() const;
 
@@ -238,11 +327,45 @@ private:
 
     void set_bit_value(uint32_t position, bool bit) const;
 
+    static uint64_t load_shifted_64(const uint8_t* data, uint32_t shift);
+
+    uint64_t load_word(uint64_t position) const;
+
+    uint64_t match_block(const basic_bit_string& pattern, uint32_t first, uint32_t last) const;
+
+    template<typename Callback>
+    void for_each_match(const basic_bit_string& pattern, uint32_t start, Callback on_match) const;
+
+    static void check_field_size(uint32_t number_of_bits);
+
+    static bool get_bit(const uint8_t* data, uint64_t position);
+
+    static void put_bit(uint8_t* data, uint64_t position, bool bit);
+
+    static void copy_bits(uint8_t* dst, uint64_t dst_position, const uint8_t* src, uint64_t src_position,
+                          uint64_t number_of_bits);
+
+    static void move_bits(uint8_t* data, uint64_t dst_position, uint64_t src_position, uint64_t number_of_bits);
+
+    void fill_bits(uint64_t position, uint64_t number_of_bits, bool bit);
+
+    void flip_bits(uint64_t position, uint64_t number_of_bits);
+
+    static uint8_t range_mask(uint64_t position, uint64_t end);
+
+    void make_room(uint32_t position, uint32_t number_of_bits);
+
+    void check_position(uint32_t position) const;
+
+    void check_range(uint32_t position, uint32_t length) const;
+
+    void check_same_size(const basic_bit_string& other) const;
+
     void push_back_unchecked(bool bit);
 
-    void copy_data(const bit_string& other);
+    void copy_data(const basic_bit_string& other);
 
-    void move_data(bit_string& other);
+    void move_data(basic_bit_string& other);
 
     void append_string_unchecked(const char* bits, uint32_t start, int32_t length);
 
@@ -253,12 +376,16 @@ private:
     bool is_small_string() const;
 };
 
+typedef basic_bit_string<msb_first> bit_string;
+typedef basic_bit_string<lsb_first> lsb_bit_string;
+
 
 /*====================================================================================================================*/
 /*-------------------------------------------- C++ Rule of Five Functions --------------------------------------------*/
 /*====================================================================================================================*/
 
-bit_string& bit_string::operator =(const bit_string& other) {
+template<typename BitOrder>
+basic_bit_string<BitOrder>& basic_bit_string<BitOrder>::operator =(const basic_bit_string& other) {
     if (&other == this) // Check for self assignment
         return *this;
 
@@ -267,25 +394,30 @@ bit_string& bit_string::operator =(const bit_string& other) {
     return *this;
 }
 
-bit_string& bit_string::operator =(bit_string&& other) noexcept {
+template<typename BitOrder>
+basic_bit_string<BitOrder>& basic_bit_string<BitOrder>::operator =(basic_bit_string&& other) noexcept {
     free_data();
     move_data(other);
     return *this;
 }
 
-bit_string::bit_string(const bit_string& other) {
+template<typename BitOrder>
+basic_bit_string<BitOrder>::basic_bit_string(const basic_bit_string& other) {
     copy_data(other);
 }
 
-bit_string::bit_string(bit_string&& other) noexcept {
+template<typename BitOrder>
+basic_bit_string<BitOrder>::basic_bit_string(basic_bit_string&& other) noexcept {
     move_data(other);
 }
 
-bit_string::~bit_string() {
+template<typename BitOrder>
+basic_bit_string<BitOrder>::~basic_bit_string() {
     free_data();
 }
 
-void bit_string::move_data(bit_string& other) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::move_data(basic_bit_string& other) {
     if (other.is_small_string()) {
         copy_data(other);
         return;
@@ -295,26 +427,35 @@ void bit_string::move_data(bit_string& other) {
     m_size_in_bits = other.m_size_in_bits;
     m_capacity_in_bytes = other.m_capacity_in_bytes;
     m_data = other.m_data;
+    BIT_STRING_STATS(stats.moves_stolen++);
 
     // Clear other's resources
     other.m_data = nullptr;
 }
 
-void bit_string::copy_data(const bit_string& other) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::copy_data(const basic_bit_string& other) {
     m_size_in_bits = other.m_size_in_bits;
     m_capacity_in_bytes = max(m_capacity_in_bytes, other.size_in_bytes());
     if (m_capacity_in_bytes > SMALL_BUFFER_SIZE) {
         m_data = new uint8_t[m_capacity_in_bytes];
+        BIT_STRING_STATS(stats.record_allocation(m_capacity_in_bytes); stats.heap_buffers++);
+    } else {
+        BIT_STRING_STATS(stats.small_buffer_hits++);
     }
-    memcpy(m_data, other.m_data, m_capacity_in_bytes);
+    // Copy only the used bytes, other may have smaller capacity than this
+    memcpy(m_data, other.m_data, other.size_in_bytes());
+    BIT_STRING_STATS(stats.bytes_copied += other.size_in_bytes());
 }
 
 
 /**
  * Free Dynamic Allocated Memory
  */
-void bit_string::free_data() const {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::free_data() const {
     if (!is_small_string()) {
+        BIT_STRING_STATS(stats.deallocations += (m_data != nullptr));
         delete[] m_data;
     }
 }
@@ -322,7 +463,8 @@ void bit_string::free_data() const {
 /**
  * @return True if this %bit_string is small and stored on the stack
  */
-bool bit_string::is_small_string() const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::is_small_string() const {
     return m_data == small_buffer;
 }
 
@@ -335,7 +477,8 @@ bool bit_string::is_small_string() const {
  *
  * @param number_of_elements The number of elements to initially create.
  */
-bit_string::bit_string(uint32_t number_of_elements) {
+template<typename BitOrder>
+basic_bit_string<BitOrder>::basic_bit_string(uint32_t number_of_elements) {
     resize(number_of_elements);
 }
 
@@ -345,7 +488,8 @@ bit_string::bit_string(uint32_t number_of_elements) {
  * @param number_of_elements The number of elements to initially create.
  * @param value The value to initialize the newly created elements
  */
-bit_string::bit_string(uint32_t number_of_elements, bool value) {
+template<typename BitOrder>
+basic_bit_string<BitOrder>::basic_bit_string(uint32_t number_of_elements, bool value) {
     resize(number_of_elements, value);
 }
 
@@ -362,8 +506,9 @@ bit_string::bit_string(uint32_t number_of_elements, bool value) {
  *
  * @throw std::length_error if number_of_bits is negative Or greater than sizeof(value) * BYTE, i.e. 16 bit
  */
-bit_string bit_string::from_uint_16(uint16_t value, uint8_t number_of_bits) {
-    bit_string _bit_string;
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::from_uint_16(uint16_t value, uint8_t number_of_bits) {
+    basic_bit_string _bit_string;
     _bit_string.append_uint_16(value, number_of_bits);
     return _bit_string;
 }
@@ -381,8 +526,9 @@ bit_string bit_string::from_uint_16(uint16_t value, uint8_t number_of_bits) {
  *
  * @throw std::length_error if number_of_bits is negative Or greater than sizeof(value) * BYTE, i.e. 32 bit
  */
-bit_string bit_string::from_uint_32(uint32_t value, uint8_t number_of_bits) {
-    bit_string _bit_string;
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::from_uint_32(uint32_t value, uint8_t number_of_bits) {
+    basic_bit_string _bit_string;
     _bit_string.append_uint_32(value, number_of_bits);
     return _bit_string;
 }
@@ -400,8 +546,9 @@ bit_string bit_string::from_uint_32(uint32_t value, uint8_t number_of_bits) {
  *
  * @throw std::length_error if number_of_bits is negative Or greater than sizeof(value) * BYTE, i.e. 64 bit
  */
-bit_string bit_string::from_uint_64(uint64_t value, uint8_t number_of_bits) {
-    bit_string _bit_string;
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::from_uint_64(uint64_t value, uint8_t number_of_bits) {
+    basic_bit_string _bit_string;
     _bit_string.append_uint_64(value, number_of_bits);
     return _bit_string;
 }
@@ -419,11 +566,13 @@ bit_string bit_string::from_uint_64(uint64_t value, uint8_t number_of_bits) {
  *
  * @throw std::logic_error if %str contains any this other than '0' and '1'
  */
-bit_string bit_string::from_string(const std::string& str, uint64_t start, int64_t length) {
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::from_string(const std::string& str, uint64_t start,
+                                                                   int64_t length) {
     if (length <= 0 || length > str.length() - start)
         length = str.length() - start;
 
-    bit_string _bit_string;
+    basic_bit_string _bit_string;
     _bit_string.reserve(length);
 
     _bit_string.append(str, start, length);
@@ -444,12 +593,13 @@ bit_string bit_string::from_string(const std::string& str, uint64_t start, int64
  *
  * @throw std::logic_error if %str contains any this other than '0' and '1'
  */
-bit_string bit_string::from_string(const char* str, uint64_t start, int64_t length) {
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::from_string(const char* str, uint64_t start, int64_t length) {
     uint32_t actual_length = strlen(str);
     if (length <= 0 || length > actual_length - start)
         length = actual_length - start;
 
-    bit_string _bit_string;
+    basic_bit_string _bit_string;
     _bit_string.reserve(length);
 
     _bit_string.append(str, start, length);
@@ -468,7 +618,9 @@ bit_string bit_string::from_string(const char* str, uint64_t start, int64_t leng
  * @param length Number of characters to convert (default remainder)
  * @return bit_string with data equal to that of %str
  */
-bit_string bit_string::from_data(const std::string& str, uint64_t start, int64_t length) {
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::from_data(const std::string& str, uint64_t start,
+                                                                 int64_t length) {
     if (length <= 0 || length > str.length() - start)
         length = str.length() - start;
 
@@ -484,8 +636,9 @@ bit_string bit_string::from_data(const std::string& str, uint64_t start, int64_t
  * @return bit_string with data equal to that of %data
  *
  */
-bit_string bit_string::from_data(const void* data, uint64_t length) {
-    bit_string _bit_string;
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::from_data(const void* data, uint64_t length) {
+    basic_bit_string _bit_string;
     _bit_string.append_data(data, length);
     return _bit_string;
 }
@@ -499,7 +652,8 @@ bit_string bit_string::from_data(const void* data, uint64_t length) {
  * Append a single bit to the end of the %bit_string.
  * @param bit The bit to append
  */
-void bit_string::push_back(bool bit) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::push_back(bool bit) {
 
     if (m_size_in_bits == m_capacity_in_bytes * BYTE) {
         reallocate(m_capacity_in_bytes * 2);
@@ -508,9 +662,10 @@ void bit_string::push_back(bool bit) {
     push_back_unchecked(bit);
 }
 
-void bit_string::set_bit_value(uint32_t position, bool bit) const {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::set_bit_value(uint32_t position, bool bit) const {
     uint32_t array_index = position / BYTE;
-    uint8_t bit_index = BYTE - position % BYTE - 1;
+    uint8_t bit_index = BitOrder::bit_shift(position % BYTE);
 
     // For each new Byte, initialize it with 0
     if (position % BYTE == 0) {
@@ -528,7 +683,8 @@ void bit_string::set_bit_value(uint32_t position, bool bit) const {
  * Append a single bit to the end of the %bit_string without checking for reallocation.
  * @param bit The bit to append
  */
-void bit_string::push_back_unchecked(bool bit) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::push_back_unchecked(bool bit) {
     set_bit_value(m_size_in_bits, bit);
     m_size_in_bits++;
 }
@@ -540,17 +696,178 @@ void bit_string::push_back_unchecked(bool bit) {
  * @param number_of_bits The number of bits to remove from the bit string
  * @note This does not actually clear the memory allocated, to clear memory call @a shrink_to_fit()
  */
-void bit_string::pop_back(uint32_t number_of_bits) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::pop_back(uint32_t number_of_bits) {
     m_size_in_bits = max(m_size_in_bits - number_of_bits, 0);
     fill_extra_bits_with_zeros();
 }
 
+
+/**
+ * Insert a single bit before @a position, shifting the following bits to the right
+ *
+ * @param position Index of the bit to insert before, size() to insert at the end
+ * @param bit The bit to insert
+ * @throw std::out_of_range if @a position is greater than size()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::insert(uint32_t position, bool bit) {
+    insert(position, 1, bit);
+}
+
+
+/**
+ * Insert @a number_of_bits copies of @a bit before @a position, shifting the following bits to the right
+ *
+ * @param position Index of the bit to insert before, size() to insert at the end
+ * @param number_of_bits Number of bits to insert
+ * @param bit The value of the inserted bits
+ * @throw std::out_of_range if @a position is greater than size()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::insert(uint32_t position, uint32_t number_of_bits, bool bit) {
+    make_room(position, number_of_bits);
+    fill_bits(position, number_of_bits, bit);
+    fill_extra_bits_with_zeros();
+}
+
+
+/**
+ * Insert @a bits before @a position, shifting the following bits to the right
+ *
+ * @param position Index of the bit to insert before, size() to insert at the end
+ * @param bits %bit_string instance
+ * @throw std::out_of_range if @a position is greater than size()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::insert(uint32_t position, const basic_bit_string& bits) {
+    if (&bits == this) { // Inserting into itself, shifting would overwrite the source
+        insert(position, basic_bit_string(bits));
+        return;
+    }
+
+    make_room(position, bits.size());
+    copy_bits(m_data, position, bits.m_data, 0, bits.size());
+    fill_extra_bits_with_zeros();
+}
+
+
+/**
+ * Remove @a length bits starting at @a position, shifting the following bits to the left
+ *
+ * @param position Index of the first bit to remove
+ * @param length Number of bits to remove (default remainder)
+ * @throw std::out_of_range if @a position is greater than size()
+ * @note This does not actually clear the memory allocated, to clear memory call @a shrink_to_fit()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::erase(uint32_t position, int64_t length) {
+    check_position(position);
+    if (length < 0 || length > m_size_in_bits - position)
+        length = m_size_in_bits - position;
+
+    copy_bits(m_data, position, m_data, position + length, m_size_in_bits - position - length);
+    m_size_in_bits -= length;
+    fill_extra_bits_with_zeros();
+}
+
+
+/**
+ * Set all bits to 1
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::set() {
+    fill_bits(0, m_size_in_bits, true);
+    fill_extra_bits_with_zeros();
+}
+
+
+/**
+ * Set @a length bits starting at @a position to @a bit
+ *
+ * @param position Index of the first bit
+ * @param length Number of bits to set
+ * @param bit The new value of the bits (default 1)
+ * @throw std::out_of_range if the range exceeds size()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::set(uint32_t position, uint32_t length, bool bit) {
+    check_range(position, length);
+    fill_bits(position, length, bit);
+}
+
+
+/**
+ * Set all bits to 0
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::reset() {
+    fill_bits(0, m_size_in_bits, false);
+}
+
+
+/**
+ * Set @a length bits starting at @a position to 0
+ *
+ * @throw std::out_of_range if the range exceeds size()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::reset(uint32_t position, uint32_t length) {
+    set(position, length, false);
+}
+
+
+/**
+ * Toggle all bits
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::flip() {
+    flip_bits(0, m_size_in_bits);
+    fill_extra_bits_with_zeros();
+}
+
+
+/**
+ * Toggle @a length bits starting at @a position
+ *
+ * @param position Index of the first bit
+ * @param length Number of bits to toggle
+ * @throw std::out_of_range if the range exceeds size()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::flip(uint32_t position, uint32_t length) {
+    check_range(position, length);
+    flip_bits(position, length);
+}
+
+
+/**
+ * Open a gap of @a number_of_bits at @a position by shifting the following bits to the right in place.
+ * Reallocates at most once. Bits of the gap are left unspecified.
+ *
+ * @throw std::out_of_range if @a position is greater than size()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::make_room(uint32_t position, uint32_t number_of_bits) {
+    check_position(position);
+
+    // If we don't have enough room for all new bits
+    // Used for Optimization to Reallocate Only Once
+    if (number_of_bits > capacity() - size()) {
+        reserve(capacity() + max(capacity(), number_of_bits));
+    }
+
+    move_bits(m_data, position + number_of_bits, position, m_size_in_bits - position);
+    m_size_in_bits += number_of_bits;
+}
+
 /**
  * Push %bits to the end of this bit string
  *
  * @param bits %bit_string instance
  */
-void bit_string::append(const bit_string& bits) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append(const basic_bit_string& bits) {
 
     // If we don't have enough room for all new bits
     // Used for Optimization to Reallocate Only Once
@@ -558,14 +875,11 @@ void bit_string::append(const bit_string& bits) {
         reserve(capacity() + max(capacity(), bits.size()));
     }
 
-    if (fit_in_bytes()) {
-        memcpy(m_data + size_in_bytes(), bits.data(), bits.size_in_bytes());
-        m_size_in_bits += bits.size();
-    } else {
-        for (bool bit : bits) {
-            push_back_unchecked(bit);
-        }
-    }
+    BIT_STRING_STATS(fit_in_bytes() ? stats.append_fast_path++ : stats.append_slow_path++;
+                     stats.bytes_copied += bits.size_in_bytes());
+    copy_bits(m_data, m_size_in_bits, bits.m_data, 0, bits.size());
+    m_size_in_bits += bits.size();
+    fill_extra_bits_with_zeros();
 }
 
 
@@ -575,7 +889,8 @@ void bit_string::append(const bit_string& bits) {
  * @param bits C style string of '0's and '1's
  * @throw std::logic_error any char in bits is not '0' or '1'
  */
-void bit_string::append_string_unchecked(const char* bits, uint32_t start, int32_t length) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append_string_unchecked(const char* bits, uint32_t start, int32_t length) {
     // If we don't have enough room for all new bits
     // Used for Optimization to Reallocate Only Once
     if (length > capacity() - size()) {
@@ -583,12 +898,23 @@ void bit_string::append_string_unchecked(const char* bits, uint32_t start, int32
     }
 
     uint32_t end = start + length;
+    uint32_t i = start;
 
-    for (int i = start; i < end; ++i) {
-        if (bits[i] != '0' && bits[i] != '1') {
-            throw std::logic_error(R"(bit_string accepts only '0' and '1')");
-        }
-        push_back_unchecked(bits[i] == '1');
+    // Push bits one by one until we reach a byte boundary
+    for (; i < end && !fit_in_bytes(); ++i) {
+        append(bits[i]);
+    }
+
+    // Pack complete bytes with the bulk parser, any invalid char makes it fail
+    uint32_t number_of_bytes = (end - i) / BYTE;
+    if (!BitOrder::parse(m_data + size_in_bytes(), bits + i, number_of_bytes)) {
+        throw std::logic_error(R"(bit_string accepts only '0' and '1')");
+    }
+    m_size_in_bits += number_of_bytes * BYTE;
+    i += number_of_bytes * BYTE;
+
+    for (; i < end; ++i) {
+        append(bits[i]);
     }
 }
 
@@ -599,7 +925,8 @@ void bit_string::append_string_unchecked(const char* bits, uint32_t start, int32
  * @param bits C style string of '0's and '1's
  * @throw std::logic_error any char in bits is not '0' or '1'
  */
-void bit_string::append(const char* bits, uint32_t start, int32_t length) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append(const char* bits, uint32_t start, int32_t length) {
     int actual_length = strlen(bits);
     if (length <= 0 || length > actual_length - start)
         length = actual_length - start;
@@ -614,7 +941,8 @@ void bit_string::append(const char* bits, uint32_t start, int32_t length) {
  * @param bits std::string of '0's and '1's
  * @throw std::logic_error any char in bits is not '0' or '1'
  */
-void bit_string::append(const std::string& bits, uint32_t start, int32_t length) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append(const std::string& bits, uint32_t start, int32_t length) {
     if (length <= 0 || length > bits.length() - start)
         length = bits.length() - start;
 
@@ -630,7 +958,8 @@ void bit_string::append(const std::string& bits, uint32_t start, int32_t length)
  * @param length Number of bytes to convert
  * @return bit_string with data equal to that of %data
  */
-void bit_string::append_data(const void* data, uint32_t length) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append_data(const void* data, uint32_t length) {
 
     // If we don't have enough room for all new bits
     // Used for Optimization to Reallocate Only Once
@@ -657,24 +986,43 @@ void bit_string::append_data(const void* data, uint32_t length) {
  * @param bit The bit to be pushed back (Must be a '0' or '1')
  * @throw std::logic_error if bit is not '0' or '1'
  */
-void bit_string::append(char bit) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append(char bit) {
     if (bit != '0' && bit != '1') {
         throw std::logic_error(R"(bit_string accepts only '0' and '1')");
     }
     push_back(bit == '1');
 }
 
-void bit_string::append_uint_unchecked(uint64_t value, uint32_t number_of_bits) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append_uint_unchecked(uint64_t value, uint32_t number_of_bits) {
     // If we don't have enough room for all new bits
     // Used for Optimization to Reallocate Only Once
     if (number_of_bits > capacity() - size()) {
         reserve(capacity() + max(capacity(), number_of_bits));
     }
 
-    while (number_of_bits) {
-        push_back_unchecked((value >> --number_of_bits) & 1u);
+    if (number_of_bits == 0)
+        return;
+
+    const uint32_t byte = m_size_in_bits / BYTE;
+    const uint32_t shift = m_size_in_bits % BYTE;
+    const uint32_t word_bits = sizeof(uint64_t) * BYTE;
+    const uint32_t position = m_size_in_bits;
+    m_size_in_bits += number_of_bits;
+
+    if (m_capacity_in_bytes - byte > sizeof(uint64_t)) {
+        // The bits after the end need not be kept, so the word is stored without loading it first (which would wait
+        // for the previous append), only the bits before the field in its first byte are kept
+        const uint64_t field_word = BitOrder::from_value(value, number_of_bits);
+        const uint64_t head = BitOrder::from_value(m_data[byte] & BitOrder::head_mask(shift), BYTE);
+        BitOrder::store_64(m_data + byte, head | BitOrder::delay(field_word, shift));
+        if (shift + number_of_bits > word_bits)
+            m_data[byte + sizeof(uint64_t)] = BitOrder::head_byte(BitOrder::skip(field_word, word_bits - shift));
+    } else {
+        set_bits(position, number_of_bits, value);
+        fill_extra_bits_with_zeros();
     }
-    fill_extra_bits_with_zeros();
 }
 
 /**
@@ -682,7 +1030,8 @@ void bit_string::append_uint_unchecked(uint64_t value, uint32_t number_of_bits)
  *
  * @param byte The byte to be pushed back
  */
-void bit_string::append_byte(uint8_t byte) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append_byte(uint8_t byte) {
     append_uint_unchecked(byte, BYTE);
 }
 
@@ -698,7 +1047,8 @@ void bit_string::append_byte(uint8_t byte) {
  *
  * @throw std::length_error if number_of_bits is negative Or greater than sizeof(value) * BYTE, i.e. 16 bit
  */
-void bit_string::append_uint_16(uint16_t value, uint32_t number_of_bits) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append_uint_16(uint16_t value, uint32_t number_of_bits) {
     if (number_of_bits < 0 || number_of_bits > sizeof(value) * BYTE) {
         throw std::length_error("number_of_bits Must be between 0 and " + std::to_string(sizeof(value) * BYTE));
     }
@@ -718,7 +1068,8 @@ void bit_string::append_uint_16(uint16_t value, uint32_t number_of_bits) {
  *
  * @throw std::length_error if number_of_bits is negative Or greater than sizeof(value) * BYTE, i.e. 32 bit
  */
-void bit_string::append_uint_32(uint32_t value, uint32_t number_of_bits) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append_uint_32(uint32_t value, uint32_t number_of_bits) {
     if (number_of_bits < 0 || number_of_bits > sizeof(value) * BYTE) {
         throw std::length_error("number_of_bits Must be between 0 and " + std::to_string(sizeof(value) * BYTE));
     }
@@ -739,7 +1090,8 @@ void bit_string::append_uint_32(uint32_t value, uint32_t number_of_bits) {
  *
  * @throw std::length_error if number_of_bits is negative Or greater than sizeof(value) * BYTE, i.e. 64 bit
  */
-void bit_string::append_uint_64(uint64_t value, uint32_t number_of_bits) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::append_uint_64(uint64_t value, uint32_t number_of_bits) {
     if (number_of_bits < 0 || number_of_bits > sizeof(value) * BYTE) {
         throw std::length_error("number_of_bits Must be between 0 and " + std::to_string(sizeof(value) * BYTE));
     }
@@ -752,7 +1104,8 @@ void bit_string::append_uint_64(uint64_t value, uint32_t number_of_bits) {
  *
  * @param bits %bit_string instance
  */
-void bit_string::operator +=(const bit_string& bits) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::operator +=(const basic_bit_string& bits) {
     append(bits);
 }
 
@@ -762,7 +1115,8 @@ void bit_string::operator +=(const bit_string& bits) {
  * @param bits C style string of '0's and '1's
  * @throw std::logic_error any char in bits is not '0' or '1'
  */
-void bit_string::operator +=(const char* bits) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::operator +=(const char* bits) {
     append(bits);
 }
 
@@ -773,7 +1127,8 @@ void bit_string::operator +=(const char* bits) {
  * @param bits std::string of '0's and '1's
  * @throw std::logic_error any char in bits is not '0' or '1'
  */
-void bit_string::operator +=(const std::string& bits) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::operator +=(const std::string& bits) {
     append(bits);
 }
 
@@ -784,7 +1139,8 @@ void bit_string::operator +=(const std::string& bits) {
  * @param bit The bit to be pushed back (Must be a '0' or '1')
  * @throw std::logic_error if bit is not '0' or '1'
  */
-void bit_string::operator +=(const char bit) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::operator +=(const char bit) {
     append(bit);
 }
 
@@ -795,7 +1151,8 @@ void bit_string::operator +=(const char bit) {
  * @param byte The byte to be pushed back
  * @throw std::logic_error if bit is not '0' or '1'
  */
-void bit_string::operator +=(const unsigned char byte) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::operator +=(const unsigned char byte) {
     append_byte(byte);
 }
 
@@ -805,7 +1162,8 @@ void bit_string::operator +=(const unsigned char byte) {
  *
  * @param bit The bit to be pushed back
  */
-void bit_string::operator +=(const bool bit) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::operator +=(const bool bit) {
     push_back(bit);
 }
 
@@ -819,7 +1177,8 @@ void bit_string::operator +=(const bool bit) {
  * @param start Index of first bit.
  * @return A new %bit_string using starting at @a start.
 */
-bit_string bit_string::substr(uint32_t start) const {
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::substr(uint32_t start) const {
     return substr(start, length() - start);
 }
 
@@ -828,33 +1187,185 @@ bit_string bit_string::substr(uint32_t start) const {
  * @param length The number of bits to take.
  * @return A new %bit_string using starting at @a start with length of @a length.
  */
-bit_string bit_string::substr(uint32_t start, uint32_t length) const {
-    bit_string _bit_string;
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::substr(uint32_t start, uint32_t length) const {
+    basic_bit_string _bit_string;
     _bit_string.reserve(length);
 
+    BIT_STRING_STATS(start % BYTE == 0 ? stats.substr_fast_path++ : stats.substr_slow_path++;
+                     stats.bytes_copied += convert_size_to_bytes(length));
+
     if (start % BYTE == 0) {
         memcpy(_bit_string.m_data, m_data + convert_size_to_bytes(start), convert_size_to_bytes(length));
-        _bit_string.m_size_in_bits = length;
-        _bit_string.fill_extra_bits_with_zeros();
     } else {
-        uint32_t end = start + length;
-        for (int i = start; i < end; ++i) {
-            _bit_string.push_back_unchecked(at(i));
-        }
+        copy_bits(_bit_string.m_data, 0, m_data, start, length);
     }
+    _bit_string.m_size_in_bits = length;
+    _bit_string.fill_extra_bits_with_zeros();
 
     return _bit_string;
 }
 
+
+/**
+ * Read a field of @a number_of_bits starting at @a position without allocating. <br>
+ * i.e. bits = [1010 0111], get_bits(2, 4) = 0b1001 = 9
+ *
+ * @param position Index of the first bit of the field, its most significant bit for msb_first
+ * @param number_of_bits Size of the field, between 0 and 64
+ * @return The field, right aligned
+ * @throw std::length_error if number_of_bits is greater than 64
+ * @throw std::out_of_range if the field exceeds size()
+ */
+template<typename BitOrder>
+uint64_t basic_bit_string<BitOrder>::get_bits(uint32_t position, uint32_t number_of_bits) const {
+    check_field_size(number_of_bits);
+    check_range(position, number_of_bits);
+    if (number_of_bits == 0)
+        return 0;
+
+    const uint32_t byte = position / BYTE;
+    const uint32_t shift = position % BYTE;
+    const uint32_t word_bits = sizeof(uint64_t) * BYTE;
+    uint64_t word;
+
+    if (m_capacity_in_bytes - byte >= sizeof(uint64_t)) {
+        // Single unaligned load, and a 9th byte only if the field crosses the 64-bit boundary
+        word = BitOrder::skip(BitOrder::load_64(m_data + byte), shift);
+        if (shift + number_of_bits > word_bits)
+            word |= BitOrder::delay(BitOrder::from_value(m_data[byte + sizeof(uint64_t)], BYTE), word_bits - shift);
+    } else {
+        // Near the end of the buffer, the field is within the remaining bytes
+        uint8_t buffer[sizeof(uint64_t)] = {0};
+        memcpy(buffer, m_data + byte, m_capacity_in_bytes - byte);
+        word = BitOrder::skip(BitOrder::load_64(buffer), shift);
+    }
+
+    return BitOrder::to_value(word, number_of_bits);
+}
+
+
+/**
+ * Overwrite a field of @a number_of_bits starting at @a position with the least significant bits of @a value. <br>
+ * i.e. bits = [1010 0111], set_bits(2, 4, 6) results in [1001 1011]
+ *
+ * @param position Index of the first bit of the field, its most significant bit for msb_first
+ * @param number_of_bits Size of the field, between 0 and 64
+ * @param value Value of the field, bits above number_of_bits are ignored
+ * @throw std::length_error if number_of_bits is greater than 64
+ * @throw std::out_of_range if the field exceeds size()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::set_bits(uint32_t position, uint32_t number_of_bits, uint64_t value) {
+    check_field_size(number_of_bits);
+    check_range(position, number_of_bits);
+    if (number_of_bits == 0)
+        return;
+
+    const uint32_t byte = position / BYTE;
+    const uint32_t shift = position % BYTE;
+    const uint32_t word_bits = sizeof(uint64_t) * BYTE;
+
+    // The field as the first bits of a word, then moved to its place in the 8 bytes starting at byte
+    const uint64_t field_word = BitOrder::from_value(value, number_of_bits);
+    const uint64_t mask = BitOrder::delay(BitOrder::head_mask_64(number_of_bits), shift);
+    const uint64_t field = BitOrder::delay(field_word, shift);
+
+    // Bits of the field that do not fit in the 64-bit word go to the start of the 9th byte
+    const uint32_t spilled_bits = shift + number_of_bits > word_bits ? shift + number_of_bits - word_bits : 0;
+
+    if (m_capacity_in_bytes - byte >= sizeof(uint64_t)) {
+        BitOrder::store_64(m_data + byte, (BitOrder::load_64(m_data + byte) & ~mask) | field);
+        if (spilled_bits) {
+            const uint8_t spill_mask = BitOrder::head_mask(spilled_bits);
+            const uint8_t spill = BitOrder::head_byte(BitOrder::skip(field_word, word_bits - shift));
+            m_data[byte + sizeof(uint64_t)] = (m_data[byte + sizeof(uint64_t)] & ~spill_mask) | (spill & spill_mask);
+        }
+    } else {
+        uint8_t buffer[sizeof(uint64_t)] = {0};
+        memcpy(buffer, m_data + byte, m_capacity_in_bytes - byte);
+        BitOrder::store_64(buffer, (BitOrder::load_64(buffer) & ~mask) | field);
+        memcpy(m_data + byte, buffer, m_capacity_in_bytes - byte);
+    }
+}
+
+
+/**
+ * Gather the bits where @a mask is 1 into a new dense %bit_string, keeping their order. <br>
+ * i.e. bits = [1011 0010], mask = [1100 0011], extract(mask) = [1010]
+ *
+ * @param mask %bit_string with the same size as this %bit_string
+ * @return A %bit_string of size mask.count()
+ * @throw std::length_error if @a mask has different size than this %bit_string
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::extract(const basic_bit_string& mask) const {
+    check_same_size(mask);
+
+    const bit_kernels& kernels = bit_kernels::get();
+    const uint32_t word_bits = sizeof(uint64_t) * BYTE;
+
+    basic_bit_string result;
+    result.reserve(mask.count());
+
+    // 64 bits at a time, the bits of each word are right aligned so the extracted bits end up in the low bits
+    for (uint32_t position = 0; position < m_size_in_bits; position += word_bits) {
+        const uint32_t number_of_bits = min(word_bits, m_size_in_bits - position);
+        const uint64_t mask_word = mask.get_bits(position, number_of_bits);
+        if (mask_word == 0)
+            continue;
+        const uint64_t extracted = kernels.extract_bits(get_bits(position, number_of_bits), mask_word);
+        result.append_uint_unchecked(extracted, scalar_kernels::popcount_64(mask_word));
+    }
+
+    return result;
+}
+
+
+/**
+ * Scatter the bits of @a bits, in order, to the positions where @a mask is 1, the inverse of extract(). <br>
+ * The bits where @a mask is 0 are not changed. <br>
+ * i.e. this = [0000 0000], mask = [1100 0011], bits = [1010], the result is [1000 0010]
+ *
+ * @param mask %bit_string with the same size as this %bit_string
+ * @param bits %bit_string of size mask.count()
+ * @throw std::length_error if @a mask has different size than this %bit_string,
+ *                          or @a bits has different size than mask.count()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::deposit(const basic_bit_string& mask, const basic_bit_string& bits) {
+    check_same_size(mask);
+    if (bits.size() != mask.count()) {
+        throw std::length_error("bit_string of size " + std::to_string(bits.size()) + " can not be deposited into " +
+                                std::to_string(mask.count()) + " bits of the mask");
+    }
+
+    const bit_kernels& kernels = bit_kernels::get();
+    const uint32_t word_bits = sizeof(uint64_t) * BYTE;
+    uint32_t source_position = 0;
+
+    for (uint32_t position = 0; position < m_size_in_bits; position += word_bits) {
+        const uint32_t number_of_bits = min(word_bits, m_size_in_bits - position);
+        const uint64_t mask_word = mask.get_bits(position, number_of_bits);
+        if (mask_word == 0)
+            continue;
+        const uint32_t source_bits = scalar_kernels::popcount_64(mask_word);
+        const uint64_t deposited = kernels.deposit_bits(bits.get_bits(source_position, source_bits), mask_word);
+        set_bits(position, number_of_bits, (get_bits(position, number_of_bits) & ~mask_word) | deposited);
+        source_position += source_bits;
+    }
+}
+
 /**
  * Allows data access to bits.
  *
  * @param position The index of the bit to access.
  * @return Read-only (constant) reference to the bit.
  */
-bool bit_string::at(uint32_t position) const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::at(uint32_t position) const {
     uint32_t array_index = position / BYTE;
-    uint8_t bit_index = BYTE - position % BYTE - 1;
+    uint8_t bit_index = BitOrder::bit_shift(position % BYTE);
     return (m_data[array_index] >> bit_index) & 1u;
 }
 
@@ -864,7 +1375,8 @@ bool bit_string::at(uint32_t position) const {
  * @param position The index of the bit to access.
  * @return Read/write reference to the bit.
  */
-bit_reference bit_string::at(uint32_t position) {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::reference basic_bit_string<BitOrder>::at(uint32_t position) {
     return {position, m_data};
 }
 
@@ -874,7 +1386,8 @@ bit_reference bit_string::at(uint32_t position) {
  * @param position The index of the bit to access.
  * @return Read-only (constant) reference to the bit.
  */
-bool bit_string::operator [](uint32_t position) const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::operator [](uint32_t position) const {
     return at(position);
 }
 
@@ -884,7 +1397,8 @@ bool bit_string::operator [](uint32_t position) const {
  * @param position The index of the bit to access.
  * @return Read/write reference to the bit.
  */
-bit_reference bit_string::operator [](uint32_t position) {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::reference basic_bit_string<BitOrder>::operator [](uint32_t position) {
     return at(position);
 }
 
@@ -894,7 +1408,8 @@ bit_reference bit_string::operator [](uint32_t position) {
  * @param position The index of the byte to access.
  * @return Read-only (constant) reference to the byte.
  */
-uint8_t bit_string::at_byte(uint32_t position) const{
+template<typename BitOrder>
+uint8_t basic_bit_string<BitOrder>::at_byte(uint32_t position) const{
     return m_data[position];
 }
 
@@ -904,7 +1419,8 @@ uint8_t bit_string::at_byte(uint32_t position) const{
  * @param position The index of the byte to access.
  * @return Read/write reference to the byte.
  */
-uint8_t& bit_string::at_byte(uint32_t position){
+template<typename BitOrder>
+uint8_t& basic_bit_string<BitOrder>::at_byte(uint32_t position){
     return m_data[position];
 }
 
@@ -916,7 +1432,8 @@ uint8_t& bit_string::at_byte(uint32_t position){
  * if %bit_string does not fit in bytes.
  * @see fill_extra_bits_with_zeros()
  */
-uint8_t bit_string::last_byte() const {
+template<typename BitOrder>
+uint8_t basic_bit_string<BitOrder>::last_byte() const {
     return m_data[(m_size_in_bits - 1) / BYTE];
 }
 
@@ -927,7 +1444,8 @@ uint8_t bit_string::last_byte() const {
  * if %bit_string does not fit in bytes.
  * @see fill_extra_bits_with_zeros()
  */
-uint8_t bit_string::back_byte() const {
+template<typename BitOrder>
+uint8_t basic_bit_string<BitOrder>::back_byte() const {
     return last_byte();
 }
 
@@ -937,7 +1455,8 @@ uint8_t bit_string::back_byte() const {
  * @note May contains garbage bits if %bit_string length is less than 8 bits.
  * @see fill_extra_bits_with_zeros()
  */
-uint8_t bit_string::first_byte() const {
+template<typename BitOrder>
+uint8_t basic_bit_string<BitOrder>::first_byte() const {
     return m_data[0];
 }
 
@@ -947,14 +1466,16 @@ uint8_t bit_string::first_byte() const {
  * @note May contains garbage bits if %bit_string length is less than 8 bits.
  * @see fill_extra_bits_with_zeros()
  */
-uint8_t bit_string::front_byte() const {
+template<typename BitOrder>
+uint8_t basic_bit_string<BitOrder>::front_byte() const {
     return first_byte();
 }
 
 /**
  * Returns a read-only (constant) reference to the data at the last bit of the %bit_string.
  */
-bool bit_string::last_bit() const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::last_bit() const {
     return at(m_size_in_bits - 1);
 }
 
@@ -962,7 +1483,8 @@ bool bit_string::last_bit() const {
 /**
  * Returns a read/write reference to the data at the last bit of the %bit_string.
  */
-bit_reference bit_string::last_bit() {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::reference basic_bit_string<BitOrder>::last_bit() {
     return at(m_size_in_bits - 1);
 }
 
@@ -970,7 +1492,8 @@ bit_reference bit_string::last_bit() {
 /**
  * Returns a read-only (constant) reference to the data at the last bit of the %bit_string.
  */
-bool bit_string::back() const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::back() const {
     return last_bit();
 }
 
@@ -978,38 +1501,214 @@ bool bit_string::back() const {
 /**
  * Returns a read/write reference to the data at the last bit of the %bit_string.
  */
-bit_reference bit_string::back() {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::reference basic_bit_string<BitOrder>::back() {
     return last_bit();
 }
 
 /**
  * Returns a read-only (constant) reference to the data at the first bit of the %bit_string.
  */
-bool bit_string::first_bit() const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::first_bit() const {
     return at(0);
 }
 
 /**
  * Returns a read/write reference to the data at the first bit of the %bit_string.
  */
-bit_reference bit_string::first_bit() {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::reference basic_bit_string<BitOrder>::first_bit() {
     return at(0);
 }
 
 /**
  * Returns a read-only (constant) reference to the data at the first bit of the %bit_string.
  */
-bool bit_string::front() const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::front() const {
     return first_bit();
 }
 
 /**
  * Returns a read/write reference to the data at the first bit of the %bit_string.
  */
-bit_reference bit_string::front() {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::reference basic_bit_string<BitOrder>::front() {
     return first_bit();
 }
 
+
+/*===================================================================================================================*/
+/*------------------------------------------------------ Search ------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * Find the first occurrence of @a pattern at any bit offset. <br>
+ * i.e. bits = [0110 1101], find([11]) = 1, find([11], 2) = 4
+ *
+ * @param pattern %bit_string to search for
+ * @param start Index of the first bit to start searching at
+ * @return Index of the first bit of the first occurrence starting at or after @a start, or npos if not found
+ */
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::find(const basic_bit_string& pattern, uint32_t start) const {
+    uint32_t result = npos;
+    for_each_match(pattern, start, [&](uint32_t position) {
+        result = position;
+        return true;
+    });
+    return result;
+}
+
+
+/**
+ * Find the last occurrence of @a pattern at any bit offset.
+ *
+ * @param pattern %bit_string to search for
+ * @param start Index of the last bit to consider as the start of an occurrence (default the whole %bit_string)
+ * @return Index of the first bit of the last occurrence starting at or before @a start, or npos if not found
+ */
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::rfind(const basic_bit_string& pattern, uint32_t start) const {
+    if (pattern.size() > m_size_in_bits)
+        return npos;
+
+    const uint32_t block_bits = sizeof(uint64_t) * BYTE;
+    uint64_t last = min(start, m_size_in_bits - pattern.size());
+
+    while (true) {
+        const uint64_t first = last >= block_bits - 1 ? last - (block_bits - 1) : 0;
+        const uint64_t matches = match_block(pattern, first, last);
+        if (matches != 0)
+            return first + BitOrder::last_one(matches);
+        if (first == 0)
+            return npos;
+        last = first - 1;
+    }
+}
+
+
+/**
+ * Find all the occurrences of @a pattern at any bit offset, including overlapping ones. <br>
+ * i.e. bits = [1111 0], find_all([11]) = {0, 1, 2}
+ *
+ * @param pattern %bit_string to search for
+ * @return Indices of the first bit of every occurrence, in increasing order
+ */
+template<typename BitOrder>
+std::vector<uint32_t> basic_bit_string<BitOrder>::find_all(const basic_bit_string& pattern) const {
+    std::vector<uint32_t> positions;
+    for_each_match(pattern, 0, [&](uint32_t position) {
+        positions.push_back(position);
+        return false;
+    });
+    return positions;
+}
+
+
+/**
+ * Call @a on_match with the position of every occurrence of @a pattern starting at or after @a start, in increasing
+ * order, until it returns true. <br>
+ * Every occurrence of a pattern of at least 23 bits contains 2 complete bytes of the %bit_string, which are one of the
+ * 8 pairs of bytes of the pattern starting at bits 0 to 7. These pairs are searched with the find_any_pair kernel at
+ * memory speed, and only the few occurrences around them are verified. Shorter patterns are matched by match_block().
+ */
+template<typename BitOrder>
+template<typename Callback>
+void basic_bit_string<BitOrder>::for_each_match(const basic_bit_string& pattern, uint32_t start,
+                                               Callback on_match) const {
+    if (pattern.size() > m_size_in_bits)
+        return;
+
+    const uint32_t last = m_size_in_bits - pattern.size();
+    const uint32_t word_bits = sizeof(uint64_t) * BYTE;
+
+    if (pattern.size() < 3 * BYTE - 1) {
+        for (uint64_t first = start; first <= last; first += word_bits) {
+            uint64_t matches = match_block(pattern, first, min(first + word_bits - 1, last));
+            while (matches != 0) {
+                const uint32_t offset = BitOrder::first_one(matches);
+                if (on_match(first + offset))
+                    return;
+                matches &= ~BitOrder::delay(BitOrder::head_mask_64(1), offset);
+            }
+        }
+        return;
+    }
+
+    uint8_t pairs[2 * BYTE];
+    for (uint32_t shift = 0; shift < BYTE; ++shift) {
+        const uint64_t pair = pattern.load_word(shift);
+        pairs[2 * shift] = BitOrder::head_byte(pair);
+        pairs[2 * shift + 1] = BitOrder::head_byte(BitOrder::skip(pair, BYTE));
+    }
+
+    // The first 64 bits of the pattern verify a candidate with a single load
+    const uint64_t pattern_word = pattern.load_word(0);
+    const uint64_t pattern_mask = BitOrder::head_mask_64(min(pattern.size(), word_bits));
+
+    // An occurrence at position p contains the bytes i and i + 1 where i = ceil(p / 8), and p = 8 * i - shift
+    const bit_kernels& kernels = bit_kernels::get();
+    const uint64_t end = min(uint64_t(convert_size_to_bytes(last)) + 1, size_in_bytes() - 1);
+
+    for (uint64_t i = convert_size_to_bytes(start); i < end; ++i) {
+        i += kernels.find_any_pair(m_data + i, end - i, pairs);
+        if (i >= end)
+            return;
+
+        for (uint32_t shift = BYTE; shift-- > 0;) {
+            const int64_t position = int64_t(i * BYTE) - shift;
+            if (m_data[i] != pairs[2 * shift] || m_data[i + 1] != pairs[2 * shift + 1] ||
+                position < start || position > last)
+                continue;
+            if (((load_word(position) ^ pattern_word) & pattern_mask) != 0)
+                continue;
+            if ((pattern.size() <= word_bits || match_block(pattern, position, position) != 0) && on_match(position))
+                return;
+        }
+    }
+}
+
+
+/**
+ * Bit-parallel match of @a pattern at the (at most 64) positions [first, last]. <br>
+ * Bit j of the result (in the order of the words of BitOrder) is set while the text at position first + j matches
+ * the pattern so far. For every bit k of the pattern the text shifted by k is combined into the result with one AND,
+ * so all the positions are checked at once and the loop stops as soon as no position is left, which is usually after
+ * a few bits.
+ *
+ * @return Positions of the occurrences, position first + j is bit j, i.e. bit (63 - j) for msb_first
+ */
+template<typename BitOrder>
+uint64_t basic_bit_string<BitOrder>::match_block(const basic_bit_string& pattern, uint32_t first, uint32_t last) const {
+    const uint32_t word_bits = sizeof(uint64_t) * BYTE;
+    uint64_t matches = BitOrder::head_mask_64(last - first + 1);
+
+    // The first 64 bits of the pattern are compared with shifts of a 128-bit window of the text
+    const uint64_t high = load_word(first);
+    const uint64_t low = load_word(uint64_t(first) + word_bits);
+    const uint64_t pattern_word = pattern.load_word(0);
+    const uint32_t window_bits = min(pattern.size(), word_bits);
+
+    for (uint32_t k = 0; k < window_bits && matches != 0; ) {
+        // Test for an early exit only every 8 bits, so the loop has fewer unpredictable branches
+        for (uint32_t end = min(k + BYTE, window_bits); k < end; ++k) {
+            const uint64_t text = k ? BitOrder::skip(high, k) | BitOrder::delay(low, word_bits - k) : high;
+            const uint64_t pattern_bit = 0 - BitOrder::to_value(BitOrder::skip(pattern_word, k), 1);
+            matches &= ~(text ^ pattern_bit);
+        }
+    }
+
+    for (uint32_t k = word_bits; k < pattern.size() && matches != 0; ++k) {
+        const uint64_t text = load_word(uint64_t(first) + k);
+        matches &= get_bit(pattern.m_data, k) ? text : ~text;
+    }
+
+    return matches;
+}
+
 /*====================================================================================================================*/
 /*------------------------------------------------------ Memory ------------------------------------------------------*/
 /*====================================================================================================================*/
@@ -1019,7 +1718,8 @@ bit_reference bit_string::front() {
 /**
  * @return Constant pointer to internal data. It is undefined to modify the contents through the returned pointer.
  */
-const uint8_t* bit_string::data() const {
+template<typename BitOrder>
+const uint8_t* basic_bit_string<BitOrder>::data() const {
     return m_data;
 }
 
@@ -1032,7 +1732,8 @@ const uint8_t* bit_string::data() const {
  * @param n Number of bits the %bit_string should contain.
  * @param bit Bit to fill any new elements (Default 0).
  */
-void bit_string::resize(uint64_t n, bool bit) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::resize(uint64_t n, bool bit) {
     reallocate(convert_size_to_bytes(n));
     if (size_in_bytes() < m_capacity_in_bytes) {  // i.e. the size extended
         int fill = bit ? -1 : 0; // -1 is all ones (represented as two's complement)
@@ -1047,7 +1748,8 @@ void bit_string::resize(uint64_t n, bool bit) {
  * Preallocate enough memory for specified number of bits.
  * @param n Number of bits required.
  */
-void bit_string::reserve(uint64_t n) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::reserve(uint64_t n) {
     if (n < m_size_in_bits) // Make sure we don't shrink below the current size.
         return;
 
@@ -1062,7 +1764,8 @@ void bit_string::reserve(uint64_t n) {
  *
  * @param new_capacity_in_bytes The new size to allocate, it can be smaller or greater than the old size
  */
-void bit_string::reallocate(uint32_t new_capacity_in_bytes) {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::reallocate(uint32_t new_capacity_in_bytes) {
     if (is_small_string() && new_capacity_in_bytes <= SMALL_BUFFER_SIZE) {
         return;
     }
@@ -1072,9 +1775,12 @@ void bit_string::reallocate(uint32_t new_capacity_in_bytes) {
         new_capacity_in_bytes = SMALL_BUFFER_SIZE;
     } else {
         new_data = new uint8_t[new_capacity_in_bytes];
+        BIT_STRING_STATS(stats.record_allocation(new_capacity_in_bytes);
+                         stats.reallocations += !is_small_string());
     }
     uint32_t capacity = min(new_capacity_in_bytes, m_capacity_in_bytes);
     memcpy(new_data, m_data, capacity);
+    BIT_STRING_STATS(stats.bytes_copied += capacity);
     free_data();
     m_data = new_data;
     m_capacity_in_bytes = new_capacity_in_bytes;
@@ -1086,7 +1792,8 @@ void bit_string::reallocate(uint32_t new_capacity_in_bytes) {
  *
  * @note This does not actually clear the memory allocated, to clear memory call shrink_to_fit()
  */
-void bit_string::clear() {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::clear() {
     m_size_in_bits = 0;
 }
 
@@ -1096,7 +1803,8 @@ void bit_string::clear() {
  *
  * @note This does not actually clear the memory allocated, to clear memory call shrink_to_fit()
  */
-void bit_string::clear_complete_bytes() {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::clear_complete_bytes() {
     if (fit_in_bytes()) {
         m_size_in_bits = 0;
     } else {
@@ -1109,7 +1817,8 @@ void bit_string::clear_complete_bytes() {
 /**
  * Shrink allocated memory to fit actual size
  */
-void bit_string::shrink_to_fit() {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::shrink_to_fit() {
     if (is_small_string()) {
         return;
     }
@@ -1124,6 +1833,30 @@ void bit_string::shrink_to_fit() {
 }
 
 
+/**
+ * Exchange the contents of this %bit_string and @a other without any allocation, the small buffers are swapped and
+ * only the pointers of dynamic data change hands
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::swap(basic_bit_string& other) noexcept {
+    const bool small = is_small_string();
+    const bool other_small = other.is_small_string();
+
+    uint8_t buffer[SMALL_BUFFER_SIZE];
+    memcpy(buffer, small_buffer, SMALL_BUFFER_SIZE);
+    memcpy(small_buffer, other.small_buffer, SMALL_BUFFER_SIZE);
+    memcpy(other.small_buffer, buffer, SMALL_BUFFER_SIZE);
+
+    std::swap(m_size_in_bits, other.m_size_in_bits);
+    std::swap(m_capacity_in_bytes, other.m_capacity_in_bytes);
+    std::swap(m_data, other.m_data);
+    if (other_small)
+        m_data = small_buffer;
+    if (small)
+        other.m_data = other.small_buffer;
+}
+
+
 /*====================================================================================================================*/
 /*---------------------------------------------------- Convertors ----------------------------------------------------*/
 /*====================================================================================================================*/
@@ -1134,13 +1867,16 @@ void bit_string::shrink_to_fit() {
  * @param zero Character to print in case of reset bit (Default to '0')
  * @return std::string representation of the data
  */
-std::string bit_string::to_string(char one, char zero) const {
-    std::string str;
-    str.reserve(m_size_in_bits);
+template<typename BitOrder>
+std::string basic_bit_string<BitOrder>::to_string(char one, char zero) const {
+    std::string str(m_size_in_bits, zero);
+    if (str.empty())
+        return str;
 
-    const bit_string& this_bit_string = *this; // Creating alias for *this
-    for (bool bit : this_bit_string) {
-        str.push_back(bit ? one : zero);
+    BitOrder::format(&str[0], m_data, complete_bytes_size(), one, zero);
+
+    for (uint32_t i = complete_bytes_size() * BYTE; i < m_size_in_bits; ++i) {
+        str[i] = at(i) ? one : zero;
     }
 
     return str;
@@ -1151,7 +1887,8 @@ std::string bit_string::to_string(char one, char zero) const {
  * @return The integral equivalent of the bits.
  * @throw std::overflow_error If there are too many bits to be represented in uint64_t.
  */
-uint64_t bit_string::to_uint_64() {
+template<typename BitOrder>
+uint64_t basic_bit_string<BitOrder>::to_uint_64() {
     return to_uint(sizeof(uint64_t));
 }
 
@@ -1160,7 +1897,8 @@ uint64_t bit_string::to_uint_64() {
  * @return The integral equivalent of the bits.
  * @throw std::overflow_error If there are too many bits to be represented in uint32_t.
  */
-uint32_t bit_string::to_uint_32() {
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::to_uint_32() {
     return to_uint(sizeof(uint32_t));
 }
 
@@ -1169,7 +1907,8 @@ uint32_t bit_string::to_uint_32() {
  * @return The integral equivalent of the bits.
  * @throw std::overflow_error If there are too many bits to be represented in uint16_t.
  */
-uint16_t bit_string::to_uint_16() {
+template<typename BitOrder>
+uint16_t basic_bit_string<BitOrder>::to_uint_16() {
     return to_uint(sizeof(uint16_t));
 }
 
@@ -1178,7 +1917,8 @@ uint16_t bit_string::to_uint_16() {
  * @return The integral equivalent of the bits.
  * @throw std::overflow_error If there are too many bits to be represented in uint8_t.
  */
-uint8_t bit_string::to_uint_8() {
+template<typename BitOrder>
+uint8_t basic_bit_string<BitOrder>::to_uint_8() {
     return to_uint(sizeof(uint8_t));
 }
 
@@ -1190,21 +1930,12 @@ uint8_t bit_string::to_uint_8() {
  * @return The integral equivalent of the bits.
  * @throw std::overflow_error If there are too many bits to be represented in number_of_bytes.
  */
-uint64_t bit_string::to_uint(uint32_t number_of_bytes) {
+template<typename BitOrder>
+uint64_t basic_bit_string<BitOrder>::to_uint(uint32_t number_of_bytes) {
     if (size_in_bytes() > number_of_bytes)
         throw std::overflow_error("bit_string does not fit in " + std::to_string(number_of_bytes) + " bytes");
 
-    number_of_bytes = size_in_bytes();
-
-    uint64_t value = 0;
-    for (int i = 0; i < number_of_bytes; ++i) {
-        value <<= BYTE;
-        value += m_data[i];
-    }
-
-    value >>= extra_bits_size();
-
-    return value;
+    return get_bits(0, m_size_in_bits);
 }
 
 
@@ -1217,7 +1948,8 @@ uint64_t bit_string::to_uint(uint32_t number_of_bytes) {
  * Returns a read/write iterator that points to the first bit in the %bit_string. <br>
  * Iteration is done in ordinary element order.
  */
-bit_string::iterator bit_string::begin() {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::iterator basic_bit_string<BitOrder>::begin() {
     return {0, m_data};
 }
 
@@ -1226,7 +1958,8 @@ bit_string::iterator bit_string::begin() {
  * Returns a read-only (constant) iterator that points to the first bit in the %bit_string. <br>
  * Iteration is done in ordinary element order.
  */
-bit_string::const_iterator bit_string::begin() const {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::const_iterator basic_bit_string<BitOrder>::begin() const {
     return {0, m_data};
 }
 
@@ -1235,7 +1968,8 @@ bit_string::const_iterator bit_string::begin() const {
  * Returns a read/write iterator that points one past the last bit in the %bit_string. <br>
  * Iteration is done in ordinary element order.
  */
-bit_string::iterator bit_string::end() {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::iterator basic_bit_string<BitOrder>::end() {
     return {m_size_in_bits, m_data};
 }
 
@@ -1244,7 +1978,8 @@ bit_string::iterator bit_string::end() {
  * Returns a read-only (constant) iterator that points one past the last bit in the %bit_string. <br>
  * Iteration is done in ordinary element order.
  */
-bit_string::const_iterator bit_string::end() const {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::const_iterator basic_bit_string<BitOrder>::end() const {
     return {m_size_in_bits, m_data};
 }
 
@@ -1253,7 +1988,8 @@ bit_string::const_iterator bit_string::end() const {
  * Returns a read/write reverse iterator that points to the last bit in the %bit_string. <br>
  * Iteration is done in reverse element order.
  */
-bit_string::reverse_iterator bit_string::rbegin() {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::reverse_iterator basic_bit_string<BitOrder>::rbegin() {
     return reverse_iterator(end());
 }
 
@@ -1262,7 +1998,8 @@ bit_string::reverse_iterator bit_string::rbegin() {
  * Returns a read-only (constant) reverse iterator that points to the last bit in the %bit_string. <br>
  * Iteration is done in reverse element order.
  */
-bit_string::const_reverse_iterator bit_string::rbegin() const {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::const_reverse_iterator basic_bit_string<BitOrder>::rbegin() const {
     return const_reverse_iterator(end());
 }
 
@@ -1271,7 +2008,8 @@ bit_string::const_reverse_iterator bit_string::rbegin() const {
  * Returns a read/write reverse iterator that points to one before the first bit in the %bit_string. <br>
  * Iteration is done in reverse element order.
  */
-bit_string::reverse_iterator bit_string::rend() {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::reverse_iterator basic_bit_string<BitOrder>::rend() {
     return reverse_iterator(begin());
 }
 
@@ -1280,7 +2018,8 @@ bit_string::reverse_iterator bit_string::rend() {
  * Returns a read-only (constant) reverse iterator that points to one before the first bit in the %bit_string. <br>
  * Iteration is done in reverse element order.
  */
-bit_string::const_reverse_iterator bit_string::rend() const {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::const_reverse_iterator basic_bit_string<BitOrder>::rend() const {
     return const_reverse_iterator(begin());
 }
 
@@ -1289,7 +2028,8 @@ bit_string::const_reverse_iterator bit_string::rend() const {
  * Returns a read-only (constant) iterator that points to the first bit in the %bit_string. <br>
  * Iteration is done in ordinary element order.
  */
-bit_string::const_iterator bit_string::cbegin() const noexcept {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::const_iterator basic_bit_string<BitOrder>::cbegin() const noexcept {
     return {0, m_data};
 }
 
@@ -1298,7 +2038,8 @@ bit_string::const_iterator bit_string::cbegin() const noexcept {
  * Returns a read-only (constant) iterator that points one past the last bit in the %bit_string. <br>
  * Iteration is done in ordinary element order.
  */
-bit_string::const_iterator bit_string::cend() const noexcept {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::const_iterator basic_bit_string<BitOrder>::cend() const noexcept {
     return {m_size_in_bits, m_data};
 }
 
@@ -1307,7 +2048,8 @@ bit_string::const_iterator bit_string::cend() const noexcept {
  * Returns a read-only (constant) reverse iterator that points to the last bit in the %bit_string. <br>
  * Iteration is done in reverse element order.
  */
-bit_string::const_reverse_iterator bit_string::crbegin() const noexcept {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::const_reverse_iterator basic_bit_string<BitOrder>::crbegin() const noexcept {
     return const_reverse_iterator(end());
 }
 
@@ -1316,7 +2058,8 @@ bit_string::const_reverse_iterator bit_string::crbegin() const noexcept {
  * Returns a read-only (constant) reverse iterator that points to one before the first bit in the %bit_string. <br>
  * Iteration is done in reverse element order.
  */
-bit_string::const_reverse_iterator bit_string::crend() const noexcept {
+template<typename BitOrder>
+typename basic_bit_string<BitOrder>::const_reverse_iterator basic_bit_string<BitOrder>::crend() const noexcept {
     return const_reverse_iterator(begin());
 }
 
@@ -1326,20 +2069,103 @@ bit_string::const_reverse_iterator bit_string::crend() const noexcept {
 /*===================================================================================================================*/
 
 
-bool bit_string::operator ==(const bit_string& other) const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::operator ==(const basic_bit_string& other) const {
     return m_size_in_bits == other.m_size_in_bits &&
-           memcmp(m_data, other.m_data, size_in_bytes()) == 0;
+           bit_kernels::get().equal(m_data, other.m_data, size_in_bytes());
 }
 
-bool bit_string::operator !=(const bit_string& other) const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::operator !=(const basic_bit_string& other) const {
     return !(other == *this);
 }
 
 
+/**
+ * Bitwise AND with @a other, bit by bit
+ *
+ * @throw std::length_error if @a other has different size
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder>& basic_bit_string<BitOrder>::operator &=(const basic_bit_string& other) {
+    check_same_size(other);
+    bit_kernels::get().bitwise_and(m_data, other.m_data, size_in_bytes());
+    return *this;
+}
+
+
+/**
+ * Bitwise OR with @a other, bit by bit
+ *
+ * @throw std::length_error if @a other has different size
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder>& basic_bit_string<BitOrder>::operator |=(const basic_bit_string& other) {
+    check_same_size(other);
+    bit_kernels::get().bitwise_or(m_data, other.m_data, size_in_bytes());
+    fill_extra_bits_with_zeros();
+    return *this;
+}
+
+
+/**
+ * Bitwise XOR with @a other, bit by bit
+ *
+ * @throw std::length_error if @a other has different size
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder>& basic_bit_string<BitOrder>::operator ^=(const basic_bit_string& other) {
+    check_same_size(other);
+    bit_kernels::get().bitwise_xor(m_data, other.m_data, size_in_bytes());
+    fill_extra_bits_with_zeros();
+    return *this;
+}
+
+
+/**
+ * @return The number of set bits (ones) in the %bit_string
+ */
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::count() const {
+    fill_extra_bits_with_zeros();
+    return bit_kernels::get().popcount(m_data, size_in_bytes());
+}
+
+
+/**
+ * Reverse the order of the bits in place, i.e. [1101 001] becomes [1001 011]. <br>
+ * The bytes are reversed (with the bits of every byte) from both ends at once, then the unused bits of the last
+ * byte, which are now at the front, are removed with a single shift.
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::reverse() {
+    fill_extra_bits_with_zeros();
+    bit_kernels::get().reverse(m_data, size_in_bytes());
+
+    const uint8_t shift = extra_bits_size();
+    if (shift != 0) {
+        copy_bits(m_data, 0, m_data, shift, m_size_in_bits);
+        fill_extra_bits_with_zeros();
+    }
+}
+
+
+/**
+ * @return A copy of the %bit_string with the bits in reverse order
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_bit_string<BitOrder>::reversed() const {
+    basic_bit_string result(*this);
+    result.reverse();
+    return result;
+}
+
+
 /**
  * Returns true if the %bit_string is empty. (Therefore begin() would equal end())
  */
-bool bit_string::empty() const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::empty() const {
     return m_size_in_bits == 0;
 }
 
@@ -1347,7 +2173,8 @@ bool bit_string::empty() const {
 /**
  * Returns true if the %bit_string has no extra bits in last byte and completely fits in bytes
  */
-bool bit_string::fit_in_bytes() const {
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::fit_in_bytes() const {
     return m_size_in_bits % BYTE == 0;
 }
 
@@ -1355,7 +2182,8 @@ bool bit_string::fit_in_bytes() const {
 /**
  * @return Total number of bits that the %bit_string can hold before needing to allocate more memory.
  */
-uint32_t bit_string::capacity() const {
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::capacity() const {
     return m_capacity_in_bytes * BYTE;
 }
 
@@ -1363,7 +2191,8 @@ uint32_t bit_string::capacity() const {
 /**
  * @return The number of bits in the %bit_string
  */
-uint32_t bit_string::size() const {
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::size() const {
     return m_size_in_bits;
 }
 
@@ -1371,7 +2200,8 @@ uint32_t bit_string::size() const {
 /**
  * @return The number of bits in the %bit_string
  */
-uint32_t bit_string::length() const {
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::length() const {
     return size();
 }
 
@@ -1379,7 +2209,8 @@ uint32_t bit_string::length() const {
 /**
  * @return The number of bytes used to store the data
  */
-uint32_t bit_string::size_in_bytes() const {
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::size_in_bytes() const {
     return convert_size_to_bytes(m_size_in_bits);
 }
 
@@ -1387,7 +2218,8 @@ uint32_t bit_string::size_in_bytes() const {
 /**
  * @return The number of bytes used to store the data
  */
-uint32_t bit_string::length_in_bytes() const {
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::length_in_bytes() const {
     return size_in_bytes();
 }
 
@@ -1397,7 +2229,8 @@ uint32_t bit_string::length_in_bytes() const {
  * i.e. if last byte is completely filled and has no extra bits return same as size_in_bytes() <br>
  * if last byte is partially completed and has extra bits return size_in_bytes() - 1 <br>
  */
-uint32_t bit_string::complete_bytes_size() const {
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::complete_bytes_size() const {
     return m_size_in_bits / BYTE;
 }
 
@@ -1408,7 +2241,8 @@ uint32_t bit_string::complete_bytes_size() const {
  *
  * @return The number of extra bits
  */
-uint8_t bit_string::extra_bits_size() const {
+template<typename BitOrder>
+uint8_t basic_bit_string<BitOrder>::extra_bits_size() const {
     return size_in_bytes() * BYTE - m_size_in_bits;
 }
 
@@ -1417,12 +2251,10 @@ uint8_t bit_string::extra_bits_size() const {
  * Fill unused bits in last byte with zeros instead of being garbage
  * This can be useful when returning raw data or returning last byte
  */
-void bit_string::fill_extra_bits_with_zeros() const {
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::fill_extra_bits_with_zeros() const {
     if (!fit_in_bytes()) {
-        const uint32_t index_of_last_bit = m_size_in_bits + extra_bits_size();
-        for (int i = m_size_in_bits; i < index_of_last_bit; ++i) {
-            set_bit_value(i, 0);
-        }
+        m_data[m_size_in_bits / BYTE] &= BitOrder::head_mask(m_size_in_bits % BYTE);
     }
 }
 
@@ -1434,19 +2266,395 @@ void bit_string::fill_extra_bits_with_zeros() const {
  * @param size_in_bits Size to convert
  * @return Size after conversion from bits to bytes
  */
-uint32_t bit_string::convert_size_to_bytes(uint64_t size_in_bits) {
+template<typename BitOrder>
+uint32_t basic_bit_string<BitOrder>::convert_size_to_bytes(uint64_t size_in_bits) {
     return (size_in_bits % BYTE == 0) ? (size_in_bits / BYTE) : (size_in_bits / BYTE + 1);
 }
 
-uint64_t bit_string::min(uint64_t a, uint64_t b) {
+/**
+ * @return The bit at @a position of raw %bit_string data
+ */
+template<typename BitOrder>
+bool basic_bit_string<BitOrder>::get_bit(const uint8_t* data, uint64_t position) {
+    return (data[position / BYTE] >> BitOrder::bit_shift(position % BYTE)) & 1u;
+}
+
+
+/**
+ * Set the bit at @a position of raw %bit_string data to @a bit
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::put_bit(uint8_t* data, uint64_t position, bool bit) {
+    uint8_t mask = 1u << BitOrder::bit_shift(position % BYTE);
+    if (bit) {
+        data[position / BYTE] |= mask;
+    } else {
+        data[position / BYTE] &= ~mask;
+    }
+}
+
+
+/**
+ * Copy @a number_of_bits from @a src starting at bit @a src_position to @a dst starting at bit @a dst_position. <br>
+ * Bits of @a dst outside the copied range are preserved. <br>
+ * Complete bytes are copied by the bulk kernels, even if the source and destination are not aligned to each other.
+ *
+ * @note @a src and @a dst may overlap only if dst_position <= src_position
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::copy_bits(uint8_t* dst, uint64_t dst_position, const uint8_t* src,
+                                           uint64_t src_position, uint64_t number_of_bits) {
+    // Copy bits one by one until destination reaches a byte boundary
+    while (dst_position % BYTE != 0 && number_of_bits > 0) {
+        put_bit(dst, dst_position++, get_bit(src, src_position++));
+        number_of_bits--;
+    }
+
+    if (number_of_bits == 0)
+        return;
+
+    dst += dst_position / BYTE;
+    src += src_position / BYTE;
+    const uint32_t shift = src_position % BYTE;
+    const uint64_t complete_bytes = number_of_bits / BYTE;
+    const uint32_t remaining_bits = number_of_bits % BYTE;
+
+    if (shift == 0) {
+        memmove(dst, src, complete_bytes);
+    } else {
+        BitOrder::shift_copy(dst, src, complete_bytes, shift);
+    }
+
+    if (remaining_bits > 0) {
+        uint8_t value = BitOrder::skip(src[complete_bytes], shift);
+        if (shift + remaining_bits > BYTE) {
+            value |= BitOrder::delay(src[complete_bytes + 1], BYTE - shift);
+        }
+        uint8_t mask = BitOrder::head_mask(remaining_bits);
+        dst[complete_bytes] = (dst[complete_bytes] & ~mask) | (value & mask);
+    }
+}
+
+
+/**
+ * Move @a number_of_bits inside @a data from bit @a src_position to bit @a dst_position, the ranges may overlap. <br>
+ * Moving to the left is a forward copy_bits(), moving to the right copies backwards 64-bit words at a time.
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::move_bits(uint8_t* data, uint64_t dst_position, uint64_t src_position,
+                                           uint64_t number_of_bits) {
+    if (dst_position <= src_position) {
+        copy_bits(data, dst_position, data, src_position, number_of_bits);
+        return;
+    }
+
+    const uint64_t distance = dst_position - src_position;
+    const uint64_t dst_end = dst_position + number_of_bits;
+
+    // Whole destination bytes are [first_byte, last_byte), and the bits around them are moved one by one
+    uint64_t first_byte = convert_size_to_bytes(dst_position);
+    uint64_t last_byte = dst_end / BYTE;
+    if (first_byte >= last_byte) {
+        first_byte = last_byte = dst_position / BYTE;
+    }
+
+    // Move from the end, so every source bit is read before it is overwritten
+    for (uint64_t i = dst_end; i > max(last_byte * BYTE, dst_position); --i) {
+        put_bit(data, i - 1, get_bit(data, i - 1 - distance));
+    }
+
+    const uint32_t shift = (BYTE - distance % BYTE) % BYTE;
+    if (shift == 0) {
+        memmove(data + first_byte, data + first_byte - distance / BYTE, last_byte - first_byte);
+    } else {
+        // Destination byte k is made of source bytes q and q + 1, where q < k
+        uint64_t k = last_byte;
+        while (k > first_byte) {
+            uint64_t q = (k * BYTE - BYTE - distance) / BYTE;
+            if (k - first_byte >= BYTE && q >= BYTE - 1) {
+                // 8 destination bytes from 9 source bytes
+                k -= BYTE;
+                q -= BYTE - 1;
+                BitOrder::store_64(data + k, load_shifted_64(data + q, shift));
+            } else {
+                k--;
+                data[k] = BitOrder::skip(data[q], shift) | BitOrder::delay(data[q + 1], BYTE - shift);
+            }
+        }
+    }
+
+    for (uint64_t i = min(first_byte * BYTE, dst_end); i > dst_position; --i) {
+        put_bit(data, i - 1, get_bit(data, i - 1 - distance));
+    }
+}
+
+
+/**
+ * @return Mask of the bits of the byte containing bit @a position that are in the range [position, end)
+ */
+template<typename BitOrder>
+uint8_t basic_bit_string<BitOrder>::range_mask(uint64_t position, uint64_t end) {
+    const uint64_t byte_end = (position / BYTE + 1) * BYTE;
+    uint8_t mask = ~BitOrder::head_mask(position % BYTE);
+    if (end < byte_end)
+        mask &= BitOrder::head_mask(end % BYTE);
+    return mask;
+}
+
+
+/**
+ * Set @a number_of_bits starting at @a position to @a bit,
+ * the edge bytes are masked and the whole bytes between them are filled with memset
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::fill_bits(uint64_t position, uint64_t number_of_bits, bool bit) {
+    if (number_of_bits == 0)
+        return;
+
+    const uint64_t end = position + number_of_bits;
+    uint64_t first_byte = position / BYTE;
+    const uint64_t last_byte = (end - 1) / BYTE;
+
+    if (position % BYTE != 0 || first_byte == last_byte) {
+        const uint8_t mask = range_mask(position, end);
+        m_data[first_byte] = bit ? (m_data[first_byte] | mask) : (m_data[first_byte] & ~mask);
+        first_byte++;
+    }
+
+    if (first_byte > last_byte)
+        return;
+
+    const uint64_t complete_bytes = end / BYTE - first_byte;
+    memset(m_data + first_byte, bit ? 0xFF : 0x00, complete_bytes);
+
+    if (end % BYTE != 0) {
+        const uint8_t mask = range_mask(last_byte * BYTE, end);
+        m_data[last_byte] = bit ? (m_data[last_byte] | mask) : (m_data[last_byte] & ~mask);
+    }
+}
+
+
+/**
+ * Toggle @a number_of_bits starting at @a position,
+ * the edge bytes are masked and the whole bytes between them use the bitwise_not kernel
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::flip_bits(uint64_t position, uint64_t number_of_bits) {
+    if (number_of_bits == 0)
+        return;
+
+    const uint64_t end = position + number_of_bits;
+    uint64_t first_byte = position / BYTE;
+    const uint64_t last_byte = (end - 1) / BYTE;
+
+    if (position % BYTE != 0 || first_byte == last_byte) {
+        m_data[first_byte] ^= range_mask(position, end);
+        first_byte++;
+    }
+
+    if (first_byte > last_byte)
+        return;
+
+    bit_kernels::get().bitwise_not(m_data + first_byte, end / BYTE - first_byte);
+
+    if (end % BYTE != 0) {
+        m_data[last_byte] ^= range_mask(last_byte * BYTE, end);
+    }
+}
+
+
+/**
+ * @throw std::out_of_range if @a position is greater than size()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::check_position(uint32_t position) const {
+    if (position > m_size_in_bits) {
+        throw std::out_of_range("position " + std::to_string(position) + " is out of range of bit_string of size " +
+                                std::to_string(m_size_in_bits));
+    }
+}
+
+
+/**
+ * @return The 64 bits starting at bit @a shift (0 to 7) of @a data, reads data[8] only if @a shift is not 0
+ */
+template<typename BitOrder>
+uint64_t basic_bit_string<BitOrder>::load_shifted_64(const uint8_t* data, uint32_t shift) {
+    const uint32_t word_bits = sizeof(uint64_t) * BYTE;
+    const uint64_t word = BitOrder::skip(BitOrder::load_64(data), shift);
+    if (shift == 0)
+        return word;
+    return word | BitOrder::delay(BitOrder::from_value(data[sizeof(uint64_t)], BYTE), word_bits - shift);
+}
+
+
+/**
+ * @return The 64 bits starting at @a position, the bits after the end of the buffer are zeros
+ */
+template<typename BitOrder>
+uint64_t basic_bit_string<BitOrder>::load_word(uint64_t position) const {
+    const uint64_t byte = position / BYTE;
+    const uint32_t shift = position % BYTE;
+
+    if (byte + sizeof(uint64_t) < m_capacity_in_bytes)
+        return load_shifted_64(m_data + byte, shift);
+
+    uint8_t buffer[sizeof(uint64_t) + 1] = {0};
+    if (byte < m_capacity_in_bytes)
+        memcpy(buffer, m_data + byte, m_capacity_in_bytes - byte);
+    return load_shifted_64(buffer, shift);
+}
+
+
+/**
+ * @throw std::length_error if @a number_of_bits is greater than 64
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::check_field_size(uint32_t number_of_bits) {
+    if (number_of_bits > sizeof(uint64_t) * BYTE) {
+        throw std::length_error("number_of_bits Must be between 0 and " + std::to_string(sizeof(uint64_t) * BYTE));
+    }
+}
+
+
+/**
+ * @throw std::out_of_range if the range of @a length bits starting at @a position exceeds size()
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::check_range(uint32_t position, uint32_t length) const {
+    if (uint64_t(position) + length > m_size_in_bits) {
+        throw std::out_of_range("range [" + std::to_string(position) + ", " +
+                                std::to_string(uint64_t(position) + length) +
+                                ") is out of range of bit_string of size " + std::to_string(m_size_in_bits));
+    }
+}
+
+
+/**
+ * @throw std::length_error if @a other has different size than this %bit_string
+ */
+template<typename BitOrder>
+void basic_bit_string<BitOrder>::check_same_size(const basic_bit_string& other) const {
+    if (m_size_in_bits != other.m_size_in_bits) {
+        throw std::length_error("bit_string sizes do not match " + std::to_string(m_size_in_bits) + " and " +
+                                std::to_string(other.m_size_in_bits));
+    }
+}
+
+template<typename BitOrder>
+uint64_t basic_bit_string<BitOrder>::min(uint64_t a, uint64_t b) {
     return (a < b) ? a : b;
 }
 
-uint64_t bit_string::max(uint64_t a, uint64_t b) {
+template<typename BitOrder>
+uint64_t basic_bit_string<BitOrder>::max(uint64_t a, uint64_t b) {
     return (a < b) ? b : a;
 }
 
 
+/**
+ * @return Bitwise AND of @a lhs and @a rhs
+ * @throw std::length_error if @a lhs and @a rhs have different sizes
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> operator &(basic_bit_string<BitOrder> lhs, const basic_bit_string<BitOrder>& rhs) {
+    return lhs &= rhs;
+}
+
+/**
+ * @return Bitwise OR of @a lhs and @a rhs
+ * @throw std::length_error if @a lhs and @a rhs have different sizes
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> operator |(basic_bit_string<BitOrder> lhs, const basic_bit_string<BitOrder>& rhs) {
+    return lhs |= rhs;
+}
+
+/**
+ * @return Bitwise XOR of @a lhs and @a rhs
+ * @throw std::length_error if @a lhs and @a rhs have different sizes
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> operator ^(basic_bit_string<BitOrder> lhs, const basic_bit_string<BitOrder>& rhs) {
+    return lhs ^= rhs;
+}
+
+
+/**
+ * Overload found by argument dependent lookup, so std::sort and the other algorithms swap without allocation
+ */
+template<typename BitOrder>
+void swap(basic_bit_string<BitOrder>& a, basic_bit_string<BitOrder>& b) noexcept {
+    a.swap(b);
+}
+
+
+/**
+ * @return The number of positions where @a a and @a b have different bits, i.e. (a ^ b).count() without
+ *         creating the temporary %bit_string
+ * @throw std::length_error if @a a and @a b have different sizes
+ */
+template<typename BitOrder>
+uint32_t hamming_distance(const basic_bit_string<BitOrder>& a, const basic_bit_string<BitOrder>& b) {
+    a.check_same_size(b);
+    a.fill_extra_bits_with_zeros();
+    b.fill_extra_bits_with_zeros();
+    uint32_t distance = 0;
+    bit_kernels::get().hamming_distances(a.m_data, b.m_data, 1, a.size_in_bytes(), &distance);
+    return distance;
+}
+
+
+/**
+ * Check if hamming_distance(a, b) <= @a threshold. <br>
+ * The bits are compared in blocks of 256 bytes, and it returns as soon as the threshold is exceeded,
+ * so different long %bit_string are rejected without reading all of them.
+ *
+ * @throw std::length_error if @a a and @a b have different sizes
+ */
+template<typename BitOrder>
+bool hamming_distance_at_most(const basic_bit_string<BitOrder>& a, const basic_bit_string<BitOrder>& b,
+                              uint32_t threshold) {
+    const uint32_t BLOCK_SIZE_IN_BYTES = 256;
+    a.check_same_size(b);
+    a.fill_extra_bits_with_zeros();
+    b.fill_extra_bits_with_zeros();
+    const bit_kernels& kernels = bit_kernels::get();
+    const uint32_t size_in_bytes = a.size_in_bytes();
+    uint64_t distance = 0;
+    for (uint32_t i = 0; i < size_in_bytes; i += BLOCK_SIZE_IN_BYTES) {
+        uint32_t block_distance = 0;
+        const uint32_t length = basic_bit_string<BitOrder>::min(BLOCK_SIZE_IN_BYTES, size_in_bytes - i);
+        kernels.hamming_distances(a.m_data + i, b.m_data + i, 1, length, &block_distance);
+        distance += block_distance;
+        if (distance > threshold) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * Jaccard similarity of the sets of positions of the set bits, |a & b| / |a | b|, which is the same as the
+ * Tanimoto coefficient of binary fingerprints. <br>
+ * It is computed from the popcounts only, |a & b| = (|a| + |b| - d) / 2 and |a | b| = (|a| + |b| + d) / 2
+ * where d = hamming_distance(a, b).
+ *
+ * @return A value in [0, 1], 1 if both @a a and @a b have no set bits
+ * @throw std::length_error if @a a and @a b have different sizes
+ */
+template<typename BitOrder>
+double jaccard_similarity(const basic_bit_string<BitOrder>& a, const basic_bit_string<BitOrder>& b) {
+    const uint64_t distance = hamming_distance(a, b);
+    const uint64_t total = uint64_t(a.count()) + b.count();
+    if (total == 0) {
+        return 1.0;
+    }
+    return double(total - distance) / double(total + distance);
+}
+
+
 /*===================================================================================================================*/
 /*---------------------------------------------- User Defined Literals ----------------------------------------------*/
 /*===================================================================================================================*/
@@ -1465,7 +2673,7 @@ uint64_t bit_string::max(uint64_t a, uint64_t b) {
  * @example std::cout << "101010"_B.length() ; -> 6
  * @example std::cout << "101010"_B.to_string() ; -> 101010
  */
-bit_string operator "" _B(const char* str, std::size_t length) {
+inline bit_string operator "" _B(const char* str, std::size_t length) {
     return bit_string::from_string(str, 0, length);
 }
 
@@ -1483,7 +2691,7 @@ bit_string operator "" _B(const char* str, std::size_t length) {
  * @example std::cout << "101010"_b.length() ; -> 6
  * @example std::cout << "101010"_b.to_string() ; -> 101010
  */
-bit_string operator "" _b(const char* str, std::size_t length) {
+inline bit_string operator "" _b(const char* str, std::size_t length) {
     return bit_string::from_string(str, 0, length);
 }
 
@@ -1501,7 +2709,7 @@ bit_string operator "" _b(const char* str, std::size_t length) {
  * @example std::cout << "abc"_D.length() ; -> 24
  * @example std::cout << "abc"_D.to_string() ; -> 011000010110001001100011
  */
-bit_string operator "" _D(const char* str, std::size_t length) {
+inline bit_string operator "" _D(const char* str, std::size_t length) {
     return bit_string::from_data(str, 0, length);
 }
 
@@ -1519,7 +2727,7 @@ bit_string operator "" _D(const char* str, std::size_t length) {
  * @example std::cout << "abc"_d.length() ; -> 24
  * @example std::cout << "abc"_d.to_string() ; -> 011000010110001001100011
  */
-bit_string operator "" _d(const char* str, std::size_t length) {
+inline bit_string operator "" _d(const char* str, std::size_t length) {
     return bit_string::from_data(str, 0, length);
 }
 
@@ -1529,17 +2737,19 @@ bit_string operator "" _d(const char* str, std::size_t length) {
 /*====================================================================================================================*/
 
 
-std::ostream& operator <<(std::ostream& output, const bit_string& bits) {
+template<typename BitOrder>
+std::ostream& operator <<(std::ostream& output, const basic_bit_string<BitOrder>& bits) {
     for (bool bit : bits) {
         output << (bit ? '1' : '0');
     }
     return output;
 }
 
-std::istream& operator >>(std::istream& input, bit_string& bits) {
+template<typename BitOrder>
+std::istream& operator >>(std::istream& input, basic_bit_string<BitOrder>& bits) {
     std::string str;
     input >> str;
-    bits = bit_string::from_string(str);
+    bits = basic_bit_string<BitOrder>::from_string(str);
     return input;
 }
 
@@ -1550,17 +2760,17 @@ std::istream& operator >>(std::istream& input, bit_string& bits) {
 namespace std {
 #ifdef __GNUC__  // GNU GCC Compiler
 
-    template<>
-    struct hash<bit_string> {
-        size_t operator ()(const bit_string& to_be_hashed) const {
+    template<typename BitOrder>
+    struct hash<basic_bit_string<BitOrder>> {
+        size_t operator ()(const basic_bit_string<BitOrder>& to_be_hashed) const {
             return std::_Hash_impl::hash(to_be_hashed.data(), to_be_hashed.size_in_bytes());
         }
     };
 
 #elif defined(_MSC_VER)  // Microsoft Visual Studio Compiler
-    template<>
-    struct hash<bit_string> {
-        size_t operator ()(const bit_string& to_be_hashed) const {
+    template<typename BitOrder>
+    struct hash<basic_bit_string<BitOrder>> {
+        size_t operator ()(const basic_bit_string<BitOrder>& to_be_hashed) const {
             return std::_Hash_array_representation(to_be_hashed.data(), to_be_hashed.size_in_bytes());
         }
     };
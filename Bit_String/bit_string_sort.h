@@ -0,0 +1,404 @@
+#ifndef BIT_STRING_SORT_H
+#define BIT_STRING_SORT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bit_string.h"
+
+/**
+ * A run of consecutive %bit_string found by bit_string_sort::group_by_prefix()
+ */
+struct prefix_group {
+    uint64_t first;          // Index of the first %bit_string of the group
+    uint64_t count;          // Number of %bit_string in the group
+    uint32_t prefix_length;  // Length of the longest common prefix of all the %bit_string of the group
+};
+
+
+/**
+ * Sorting and longest common prefix grouping of collections of %basic_bit_string, in lexicographic order of their
+ * bits: the first different bit decides, and a prefix is before the longer %bit_string, i.e. [0] < [01] < [1]. <br>
+ * sort() is a most significant digit radix sort on cached keys: the next 64 bits of every %bit_string are loaded once
+ * into an array of 16-byte entries (the whole key of a %bit_string of up to 64 bits is in its small buffer, not
+ * behind a pointer), which is partitioned 8 bits at a time by counting, small ranges being sorted by comparisons of
+ * their keys. Only the ranges whose keys are all equal load the following 64 bits of their %bit_string. The
+ * %bit_string are then moved to their place by swaps, without any allocation.
+ *
+ * With several threads, the keys are loaded in parallel and the largest ranges are partitioned until they are small
+ * enough to be sorted independently by the threads, the largest first.
+ *
+ * @example std::vector<bit_string> keys = ...;
+ *          bit_string_sort::sort(keys, 8);
+ *          for (const prefix_group& group : bit_string_sort::group_by_prefix(keys, 16))
+ *              build_child(keys, group.first, group.count, group.prefix_length);
+ */
+class bit_string_sort {
+
+public:
+
+    static const uint32_t BYTE = 8;
+    static const uint32_t WORD_BITS = 64;
+    static const uint32_t RADIX_BITS = 8;
+    static const uint32_t SMALL_RANGE = 64;  // Ranges sorted by comparisons of their keys
+    static const uint32_t TASKS_PER_THREAD = 16;
+
+    /**
+     * Lexicographic order of the bits, for std::sort, std::lower_bound or std::map
+     */
+    struct less {
+        template<typename BitOrder>
+        bool operator ()(const basic_bit_string<BitOrder>& a, const basic_bit_string<BitOrder>& b) const;
+    };
+
+    template<typename BitOrder>
+    static void sort(std::vector<basic_bit_string<BitOrder>>& strings, uint32_t threads = 1);
+
+    template<typename BitOrder>
+    static uint32_t common_prefix_length(const basic_bit_string<BitOrder>& a, const basic_bit_string<BitOrder>& b);
+
+    template<typename BitOrder>
+    static std::vector<uint32_t> longest_common_prefixes(const std::vector<basic_bit_string<BitOrder>>& sorted);
+
+    template<typename BitOrder>
+    static std::vector<prefix_group> group_by_prefix(const std::vector<basic_bit_string<BitOrder>>& sorted,
+                                                     uint32_t prefix_length);
+
+private:
+
+    // The next 64 bits of a bit_string from depth, the first at the most significant bit, and the number of them
+    // before its end. The bits after its end are zeros, so the (key, remaining) order is the order of the bits
+    struct entry {
+        uint64_t key;
+        uint32_t index;
+        uint32_t remaining;
+    };
+
+    // Entries [first, last) with equal bits before depth + 8 * byte
+    struct range {
+        uint64_t first;
+        uint64_t last;
+        uint32_t depth;
+        uint32_t byte;
+    };
+
+    template<typename BitOrder>
+    static void load_key(const basic_bit_string<BitOrder>& bits, uint32_t depth, entry& key);
+
+    template<typename BitOrder>
+    static void sort_range(const basic_bit_string<BitOrder>* strings, entry* entries, entry* scratch, range current,
+                           std::vector<range>* tasks, uint64_t task_size);
+
+    template<typename Function>
+    static void parallel_for(uint64_t count, uint32_t threads, Function function);
+
+    template<typename BitOrder>
+    static uint32_t sorted_prefix_length(const std::vector<basic_bit_string<BitOrder>>& sorted, uint64_t index);
+};
+
+
+/*===================================================================================================================*/
+/*----------------------------------------------------- Sorting -----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return True if the bits of @a a are before those of @a b
+ */
+template<typename BitOrder>
+bool bit_string_sort::less::operator ()(const basic_bit_string<BitOrder>& a,
+                                        const basic_bit_string<BitOrder>& b) const {
+    const uint32_t length = common_prefix_length(a, b);
+    if (length == a.size())
+        return length < b.size();
+    return length < b.size() && !a[length];
+}
+
+/**
+ * Sort @a strings in place in lexicographic order of their bits, equal %bit_string are in any order
+ *
+ * @param threads Number of threads sorting, 0 for std::thread::hardware_concurrency()
+ * @throw std::length_error if there are more than 2^32 - 1 %bit_string
+ */
+template<typename BitOrder>
+void bit_string_sort::sort(std::vector<basic_bit_string<BitOrder>>& strings, uint32_t threads) {
+    if (strings.size() > UINT32_MAX) {
+        throw std::length_error("Can not sort more than " + std::to_string(UINT32_MAX) + " bit_string");
+    }
+    const uint64_t n = strings.size();
+    if (n < 2)
+        return;
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = uint32_t(std::min<uint64_t>(threads, (n + SMALL_RANGE - 1) / SMALL_RANGE));
+
+    std::vector<entry> entries(n);
+    std::vector<entry> scratch(n);
+    const basic_bit_string<BitOrder>* data = strings.data();
+    parallel_for(n, threads, [&](uint64_t first, uint64_t last) {
+        for (uint64_t i = first; i < last; ++i) {
+            entries[i].index = uint32_t(i);
+            load_key(data[i], 0, entries[i]);
+        }
+    });
+
+    const range all = {0, n, 0, 0};
+    if (threads == 1) {
+        sort_range(data, entries.data(), scratch.data(), all, nullptr, 0);
+    } else {
+        // Partition until the ranges are small enough to balance the threads, then sort the largest ones first
+        std::vector<range> tasks;
+        const uint64_t task_size = std::max<uint64_t>(SMALL_RANGE, n / (uint64_t(threads) * TASKS_PER_THREAD));
+        sort_range(data, entries.data(), scratch.data(), all, &tasks, task_size);
+        std::sort(tasks.begin(), tasks.end(), [](const range& a, const range& b) {
+            return a.last - a.first > b.last - b.first;
+        });
+
+        std::atomic<uint64_t> next_task(0);
+        parallel_for(threads, threads, [&](uint64_t, uint64_t) {
+            for (uint64_t task = next_task++; task < tasks.size(); task = next_task++) {
+                sort_range(data, entries.data(), scratch.data(), tasks[task], nullptr, 0);
+            }
+        });
+    }
+
+    // The bit_strings are gathered in order into empty ones, then swapped back in sequence. The swaps do not depend
+    // on each other, unlike along the cycles of the permutation, so their cache misses overlap
+    std::vector<entry>().swap(scratch);
+    std::vector<basic_bit_string<BitOrder>> sorted(n);
+    parallel_for(n, threads, [&](uint64_t first, uint64_t last) {
+        for (uint64_t i = first; i < last; ++i) {
+            sorted[i].swap(strings[entries[i].index]);
+        }
+    });
+    parallel_for(n, threads, [&](uint64_t first, uint64_t last) {
+        for (uint64_t i = first; i < last; ++i) {
+            strings[i].swap(sorted[i]);
+        }
+    });
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------- Common Prefixes -------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return The number of leading bits equal in @a a and @a b, compared 64 bits at a time
+ */
+template<typename BitOrder>
+uint32_t bit_string_sort::common_prefix_length(const basic_bit_string<BitOrder>& a,
+                                               const basic_bit_string<BitOrder>& b) {
+    const uint32_t length = std::min(a.size(), b.size());
+    for (uint64_t position = 0; position < length; position += WORD_BITS) {
+        const uint64_t difference = a.load_word(position) ^ b.load_word(position);
+        if (difference)
+            return uint32_t(std::min<uint64_t>(length, position + BitOrder::first_one(difference)));
+    }
+    return length;
+}
+
+/**
+ * @return The length of the common prefix of every %bit_string of @a sorted and the previous one, 0 for the first,
+ *         i.e. the LCP array of a trie
+ * @throw std::domain_error if @a sorted is not sorted
+ */
+template<typename BitOrder>
+std::vector<uint32_t> bit_string_sort::longest_common_prefixes(const std::vector<basic_bit_string<BitOrder>>& sorted) {
+    std::vector<uint32_t> lengths(sorted.size(), 0);
+    for (uint64_t i = 1; i < sorted.size(); ++i) {
+        lengths[i] = sorted_prefix_length(sorted, i);
+    }
+    return lengths;
+}
+
+/**
+ * Group the consecutive %bit_string of @a sorted with the same first @a prefix_length bits, a %bit_string shorter
+ * than @a prefix_length is only grouped with the %bit_string equal to it. <br>
+ * i.e. the groups of [0, 00, 010, 011, 1] by their first 2 bits are [0], [00], [010, 011] and [1]
+ *
+ * @return The groups in order, with the length of the longest common prefix of each group
+ * @throw std::domain_error if @a sorted is not sorted
+ */
+template<typename BitOrder>
+std::vector<prefix_group> bit_string_sort::group_by_prefix(const std::vector<basic_bit_string<BitOrder>>& sorted,
+                                                           uint32_t prefix_length) {
+    std::vector<prefix_group> groups;
+    uint32_t previous_key_length = 0;
+    for (uint64_t i = 0; i < sorted.size(); ++i) {
+        const uint32_t key_length = std::min(sorted[i].size(), prefix_length);
+        const uint32_t length = i ? sorted_prefix_length(sorted, i) : 0;
+        if (i && key_length == previous_key_length && length >= key_length) {
+            groups.back().count++;
+            groups.back().prefix_length = std::min(groups.back().prefix_length, length);
+        } else {
+            const prefix_group group = {i, 1, sorted[i].size()};
+            groups.push_back(group);
+        }
+        previous_key_length = key_length;
+    }
+    return groups;
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------- Private Helpers -------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * Load the 64 bits of @a bits from @a depth into @a key, the first at the most significant bit whatever the BitOrder
+ */
+template<typename BitOrder>
+void bit_string_sort::load_key(const basic_bit_string<BitOrder>& bits, uint32_t depth, entry& key) {
+    const uint32_t remaining = bits.size() - depth;
+    uint64_t word = remaining ? bits.load_word(depth) : 0;
+    if (BitOrder::bit_shift(0) != BYTE - 1)
+        word = scalar_kernels::reverse_64(word);
+    key.key = remaining >= WORD_BITS ? word : word & ~(~uint64_t(0) >> remaining);
+    key.remaining = remaining < WORD_BITS ? remaining : WORD_BITS;
+}
+
+/**
+ * Sort the entries of @a current, partitioning on the byte @a current.byte of the keys or comparing the keys of a
+ * small range. Ranges whose keys are all equal are sorted by their remaining bits, and those with more bits load
+ * their next keys. <br>
+ * Every range but the largest is sorted recursively and the loop goes on with the largest, so the recursion depth is
+ * logarithmic. If @a tasks is given, the ranges of at most @a task_size entries are added to it instead.
+ */
+template<typename BitOrder>
+void bit_string_sort::sort_range(const basic_bit_string<BitOrder>* strings, entry* entries, entry* scratch,
+                                 range current, std::vector<range>* tasks, uint64_t task_size) {
+    range largest = {0, 0, 0, 0};
+    auto descend = [&](const range& next) {
+        if (next.last - next.first < 2)
+            return;
+        if (next.last - next.first <= largest.last - largest.first) {
+            sort_range(strings, entries, scratch, next, tasks, task_size);
+            return;
+        }
+        if (largest.last - largest.first >= 2)
+            sort_range(strings, entries, scratch, largest, tasks, task_size);
+        largest = next;
+    };
+
+    while (current.last - current.first > 1) {
+        if (tasks && current.last - current.first <= task_size) {
+            tasks->push_back(current);
+            return;
+        }
+        entry* first = entries + current.first;
+        entry* last = entries + current.last;
+        largest.first = largest.last = 0;
+
+        if (current.byte == WORD_BITS / RADIX_BITS) {
+            // Equal keys: the bit_strings ending within the key are sorted by length, the longer ones go deeper
+            std::sort(first, last, [](const entry& a, const entry& b) {
+                return a.remaining < b.remaining;
+            });
+            entry* longer = std::partition_point(first, last, [](const entry& key) {
+                return key.remaining < WORD_BITS;
+            });
+            current.first = uint64_t(longer - entries);
+            current.depth += WORD_BITS;
+            current.byte = 0;
+            if (last - longer > 1) {
+                for (entry* key = longer; key != last; ++key) {
+                    load_key(strings[key->index], current.depth, *key);
+                }
+            }
+            continue;
+        }
+
+        if (current.last - current.first <= SMALL_RANGE) {
+            std::sort(first, last, [](const entry& a, const entry& b) {
+                return a.key != b.key ? a.key < b.key : a.remaining < b.remaining;
+            });
+            // Runs of equal keys with at least two longer bit_strings
+            for (entry* run = first; run != last;) {
+                entry* end = run + 1;
+                while (end != last && end->key == run->key) {
+                    ++end;
+                }
+                if (end - run > 1 && (end - 2)->remaining == WORD_BITS) {
+                    const range next = {uint64_t(run - entries), uint64_t(end - entries), current.depth,
+                                        WORD_BITS / RADIX_BITS};
+                    descend(next);
+                }
+                run = end;
+            }
+        } else {
+            const uint32_t shift = WORD_BITS - RADIX_BITS * (current.byte + 1);
+            uint64_t counts[1u << RADIX_BITS] = {0};
+            for (entry* key = first; key != last; ++key) {
+                ++counts[(key->key >> shift) & 0xFF];
+            }
+            if (counts[(first->key >> shift) & 0xFF] == current.last - current.first) {
+                // A common byte, nothing to move
+                ++current.byte;
+                continue;
+            }
+
+            uint64_t offsets[1u << RADIX_BITS];
+            uint64_t offset = current.first;
+            for (uint32_t digit = 0; digit < (1u << RADIX_BITS); ++digit) {
+                offsets[digit] = offset;
+                offset += counts[digit];
+            }
+            for (entry* key = first; key != last; ++key) {
+                scratch[offsets[(key->key >> shift) & 0xFF]++] = *key;
+            }
+            memcpy(first, scratch + current.first, (current.last - current.first) * sizeof(entry));
+
+            offset = current.first;
+            for (uint32_t digit = 0; digit < (1u << RADIX_BITS); ++digit) {
+                const range next = {offset, offset + counts[digit], current.depth, current.byte + 1};
+                descend(next);
+                offset += counts[digit];
+            }
+        }
+        current = largest;
+    }
+}
+
+/**
+ * Call @a function(first, last) on @a threads contiguous chunks of [0, @a count), each in its own thread
+ */
+template<typename Function>
+void bit_string_sort::parallel_for(uint64_t count, uint32_t threads, Function function) {
+    const uint64_t chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (uint32_t t = 1; t < threads; ++t) {
+        workers.emplace_back(function, std::min(count, t * chunk), std::min(count, (t + 1) * chunk));
+    }
+    function(0, std::min(count, chunk));
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @return The common prefix length of sorted[index] and sorted[index - 1]
+ * @throw std::domain_error if sorted[index] is before sorted[index - 1]
+ */
+template<typename BitOrder>
+uint32_t bit_string_sort::sorted_prefix_length(const std::vector<basic_bit_string<BitOrder>>& sorted,
+                                               uint64_t index) {
+    const basic_bit_string<BitOrder>& previous = sorted[index - 1];
+    const basic_bit_string<BitOrder>& bits = sorted[index];
+    const uint32_t length = common_prefix_length(previous, bits);
+    if (length < previous.size() && (length == bits.size() || previous[length])) {
+        throw std::domain_error("bit_string Must be sorted, bit_string " + std::to_string(index) +
+                                " is before the previous one");
+    }
+    return length;
+}
+
+#endif //BIT_STRING_SORT_H
@@ -0,0 +1,95 @@
+#ifndef BIT_STRING_STATS_H
+#define BIT_STRING_STATS_H
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Opt-in instrumentation counters of %bit_string memory operations, recorded per thread. <br>
+ * Define @a BIT_STRING_ENABLE_STATS (or configure CMake with -DBIT_STRING_ENABLE_STATS=ON) to record them,
+ * otherwise the recording statements are removed at compile time and snapshot() always returns zeros.
+ *
+ * @example bit_string_stats::reset();
+ *          run_workload();
+ *          bit_string_stats stats = bit_string_stats::snapshot();
+ */
+struct bit_string_stats {
+
+    static const uint32_t HISTOGRAM_SIZE = 33;
+
+    uint64_t allocations = 0;         // Heap buffers allocated
+    uint64_t reallocations = 0;       // Heap buffers replaced by a bigger or smaller heap buffer
+    uint64_t deallocations = 0;       // Heap buffers freed
+    uint64_t bytes_copied = 0;        // Bytes copied with memcpy / memmove / shift_copy kernels
+    uint64_t small_buffer_hits = 0;   // Copies that fit in the small buffer (SSO) without touching the heap
+    uint64_t heap_buffers = 0;        // Copies that needed a heap buffer
+    uint64_t moves_stolen = 0;        // Moves that took the heap buffer of the other %bit_string without copying
+    uint64_t append_fast_path = 0;    // append(bit_string) to a byte aligned %bit_string
+    uint64_t append_slow_path = 0;    // append(bit_string) to a %bit_string with extra bits (bit shifting)
+    uint64_t substr_fast_path = 0;    // substr() starting at a byte boundary
+    uint64_t substr_slow_path = 0;    // substr() starting in the middle of a byte (bit shifting)
+
+    // allocation_size_histogram[i] is the number of heap allocations of size in [2^i, 2^(i+1)) bytes
+    uint64_t allocation_size_histogram[HISTOGRAM_SIZE] = {0};
+
+    static bit_string_stats snapshot();
+
+    static void reset();
+
+    static bit_string_stats& local();
+
+    static uint32_t histogram_bucket(uint64_t size_in_bytes);
+
+    void record_allocation(uint64_t size_in_bytes);
+};
+
+#ifdef BIT_STRING_ENABLE_STATS
+#define BIT_STRING_STATS(statement) do { bit_string_stats& stats = bit_string_stats::local(); statement; } while (0)
+#else
+#define BIT_STRING_STATS(statement) do {} while (0)
+#endif
+
+
+/**
+ * @return A copy of the counters recorded by the calling thread
+ */
+inline bit_string_stats bit_string_stats::snapshot() {
+    return local();
+}
+
+
+/**
+ * Reset all counters of the calling thread to zero
+ */
+inline void bit_string_stats::reset() {
+    local() = bit_string_stats();
+}
+
+
+/**
+ * @return The counters of the calling thread
+ */
+inline bit_string_stats& bit_string_stats::local() {
+    static thread_local bit_string_stats stats;
+    return stats;
+}
+
+
+/**
+ * @return The index of the histogram bucket of @a size_in_bytes, i.e. floor(log2(size_in_bytes))
+ */
+inline uint32_t bit_string_stats::histogram_bucket(uint64_t size_in_bytes) {
+    uint32_t bucket = 0;
+    while (size_in_bytes >>= 1) {
+        bucket++;
+    }
+    return bucket < HISTOGRAM_SIZE ? bucket : HISTOGRAM_SIZE - 1;
+}
+
+
+inline void bit_string_stats::record_allocation(uint64_t size_in_bytes) {
+    allocations++;
+    allocation_size_histogram[histogram_bucket(size_in_bytes)]++;
+}
+
+#endif //BIT_STRING_STATS_H
@@ -0,0 +1,118 @@
+#ifndef BIT_WRITER_H
+#define BIT_WRITER_H
+
+#include <cstdint>
+
+#include "bit_string.h"
+
+/**
+ * Appends fields to a %basic_bit_string through a 64-bit accumulator, for encoding streams of variable length
+ * codes. <br>
+ * The fields are gathered in a register and the %bit_string only grows by whole 64-bit words, so the cost of
+ * append_uint_64() is paid once per 64 bits instead of once per field.
+ *
+ * The bits written are pending until 64 of them are gathered, call flush() before using the %bit_string.
+ * The destructor flushes too.
+ *
+ * @example bit_writer writer(bits);
+ *          writer.write_bits(5, 3);
+ *          writer.flush();
+ */
+template<typename BitOrder>
+class basic_bit_writer {
+
+    basic_bit_string<BitOrder>* m_bits;
+    uint64_t m_buffer;  // The pending bits, the first one at the start of the word
+    uint32_t m_count;   // Number of pending bits, less than 64
+
+public:
+
+    static const uint32_t WORD_BITS = 64;
+
+    explicit basic_bit_writer(basic_bit_string<BitOrder>& bits);
+
+    basic_bit_writer(const basic_bit_writer&) = delete;
+
+    basic_bit_writer& operator =(const basic_bit_writer&) = delete;
+
+    ~basic_bit_writer();
+
+    void write_bits(uint64_t value, uint32_t number_of_bits);
+
+    void flush();
+
+    uint64_t size() const;
+};
+
+typedef basic_bit_writer<msb_first> bit_writer;
+typedef basic_bit_writer<lsb_first> lsb_bit_writer;
+
+
+/**
+ * @param bits The %bit_string to append to, the writer keeps a pointer to it
+ */
+template<typename BitOrder>
+basic_bit_writer<BitOrder>::basic_bit_writer(basic_bit_string<BitOrder>& bits)
+        : m_bits(&bits), m_buffer(0), m_count(0) {}
+
+/**
+ * Flush the pending bits, errors are ignored as a destructor must not throw, call flush() to get them
+ */
+template<typename BitOrder>
+basic_bit_writer<BitOrder>::~basic_bit_writer() {
+    try {
+        flush();
+    } catch (...) {
+    }
+}
+
+/**
+ * Append a field of @a number_of_bits, the same as bits.append_uint_64(value, number_of_bits)
+ *
+ * @param value Value of the field, bits above number_of_bits are ignored
+ * @param number_of_bits Size of the field, between 0 and 64
+ * @throw std::length_error if number_of_bits is greater than 64
+ */
+template<typename BitOrder>
+void basic_bit_writer<BitOrder>::write_bits(uint64_t value, uint32_t number_of_bits) {
+    if (number_of_bits > WORD_BITS) {
+        throw std::length_error("number_of_bits Must be between 0 and " + std::to_string(WORD_BITS));
+    }
+    if (number_of_bits == 0)
+        return;
+
+    const uint64_t field = BitOrder::from_value(value, number_of_bits);
+    m_buffer |= BitOrder::delay(field, m_count);
+    if (m_count + number_of_bits < WORD_BITS) {
+        m_count += number_of_bits;
+        return;
+    }
+
+    // The word is full, the rest of the field starts the next one
+    m_bits->append_uint_64(BitOrder::to_value(m_buffer, WORD_BITS), WORD_BITS);
+    const uint32_t written = WORD_BITS - m_count;
+    m_buffer = written < WORD_BITS ? BitOrder::skip(field, written) : 0;
+    m_count = number_of_bits - written;
+}
+
+/**
+ * Append the pending bits to the %bit_string
+ */
+template<typename BitOrder>
+void basic_bit_writer<BitOrder>::flush() {
+    if (m_count) {
+        m_bits->append_uint_64(BitOrder::to_value(m_buffer, m_count), m_count);
+        m_buffer = 0;
+        m_count = 0;
+    }
+}
+
+/**
+ * @return Size of the %bit_string after flush()
+ */
+template<typename BitOrder>
+uint64_t basic_bit_writer<BitOrder>::size() const {
+    return uint64_t(m_bits->size()) + m_count;
+}
+
+#endif //BIT_WRITER_H
@@ -0,0 +1,409 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "bit_string.h"
+
+/**
+ * Cache line blocked Bloom filter of 64-bit keys stored in a %bit_string. <br>
+ * The filter is an array of 512-bit blocks aligned to 64 bytes. A key selects one block with its hash, and all its
+ * number_of_hashes() bits are in that block, so a lookup touches a single cache line. The bits in the block are the
+ * top 9 bits of the low half of the hash multiplied by a different odd constant per bit (as the split block filters
+ * of Parquet), which are independent multiplications instead of a chain of hashes.
+ *
+ * insert() and contains() of arrays of keys run in batches: the hashes of a whole batch are computed and their
+ * blocks are prefetched first, then the blocks are probed, so the cache misses of a batch overlap.
+ *
+ * Keys are integers, hash other keys first (i.e. with std::hash). A key inserted is always found, a key not
+ * inserted is found with a probability close to the rate given to for_keys().
+ *
+ * @example blocked_bloom_filter filter = blocked_bloom_filter::for_keys(keys.size(), 0.01);
+ *          filter.insert(keys.data(), keys.size());
+ *          filter.contains(probes.data(), probes.size(), found.data());
+ */
+class blocked_bloom_filter {
+
+public:
+
+    static const uint32_t BYTE = 8;
+    static const uint32_t BLOCK_BITS = 512;
+    static const uint32_t BLOCK_BYTES = BLOCK_BITS / BYTE;
+    static const uint32_t MAX_HASHES = 16;
+    static const uint32_t DEFAULT_HASHES = 8;
+
+    // The blocks and the padding to align them must fit in a bit_string
+    static const uint32_t MAX_BLOCKS = UINT32_MAX / BLOCK_BITS - 1;
+
+private:
+
+    static const uint32_t BATCH_SIZE = 16;
+
+    // Number of bits of the header of serialize(), the number of blocks and the number of hashes
+    static const uint32_t HEADER_BITS = 40;
+
+    bit_string m_bits;
+    uint32_t m_offset_in_bytes = 0;  // Offset of the first block in m_bits, it is aligned to 64 bytes
+    uint32_t m_number_of_blocks = 0;
+    uint32_t m_number_of_hashes = 0;
+
+    static uint64_t hash(uint64_t key);
+
+    static uint32_t bit_in_block(uint64_t hash, uint32_t index);
+
+    static void prefetch(const uint8_t* block);
+
+    uint32_t block_index(uint64_t hash) const;
+
+    const uint8_t* blocks() const;
+
+    uint8_t* blocks();
+
+    void insert_hash(uint64_t hash);
+
+    bool contains_hash(uint64_t hash) const;
+
+    uint32_t aligned_offset() const;
+
+    void align(uint32_t offset_in_bytes);
+
+public:
+
+    blocked_bloom_filter(uint64_t number_of_bits, uint32_t number_of_hashes = DEFAULT_HASHES);
+
+    blocked_bloom_filter(const blocked_bloom_filter& other);
+
+    blocked_bloom_filter(blocked_bloom_filter&& other) = default;
+
+    blocked_bloom_filter& operator =(const blocked_bloom_filter& other);
+
+    blocked_bloom_filter& operator =(blocked_bloom_filter&& other) = default;
+
+    static blocked_bloom_filter for_keys(uint64_t number_of_keys, double false_positive_rate);
+
+/*===================================================================================================================*/
+
+    void insert(uint64_t key);
+
+    void insert(const uint64_t* keys, uint64_t count);
+
+    bool contains(uint64_t key) const;
+
+    uint64_t contains(const uint64_t* keys, uint64_t count, bool* results) const;
+
+    void clear();
+
+/*===================================================================================================================*/
+
+    bit_string serialize() const;
+
+    static blocked_bloom_filter deserialize(const bit_string& bits);
+
+/*===================================================================================================================*/
+
+    uint64_t size() const;
+
+    uint32_t number_of_blocks() const;
+
+    uint32_t number_of_hashes() const;
+
+    uint32_t count() const;
+};
+
+
+/**
+ * @param number_of_bits Size of the filter, rounded up to a multiple of 512 bits
+ * @param number_of_hashes Number of bits set per key, between 1 and 16
+ * @throw std::length_error if @a number_of_hashes is not between 1 and 16
+ * @throw std::length_error if the filter needs more than MAX_BLOCKS blocks
+ */
+inline blocked_bloom_filter::blocked_bloom_filter(uint64_t number_of_bits, uint32_t number_of_hashes) {
+    if (number_of_hashes == 0 || number_of_hashes > MAX_HASHES) {
+        throw std::length_error("number_of_hashes Must be between 1 and " + std::to_string(MAX_HASHES));
+    }
+    const uint64_t number_of_blocks = number_of_bits ? (number_of_bits + BLOCK_BITS - 1) / BLOCK_BITS : 1;
+    if (number_of_blocks > MAX_BLOCKS) {
+        throw std::length_error("Bloom filter of " + std::to_string(number_of_bits) + " bits is too large");
+    }
+
+    m_number_of_blocks = uint32_t(number_of_blocks);
+    m_number_of_hashes = number_of_hashes;
+
+    // One more block is allocated, so the blocks can start at the first byte aligned to 64 bytes
+    m_bits.resize((number_of_blocks + 1) * BLOCK_BITS, false);
+    m_offset_in_bytes = aligned_offset();
+}
+
+/**
+ * Copy @a other, the blocks are aligned again in the new %bit_string
+ */
+inline blocked_bloom_filter::blocked_bloom_filter(const blocked_bloom_filter& other)
+        : m_bits(other.m_bits), m_offset_in_bytes(other.m_offset_in_bytes),
+          m_number_of_blocks(other.m_number_of_blocks), m_number_of_hashes(other.m_number_of_hashes) {
+    align(m_offset_in_bytes);
+}
+
+inline blocked_bloom_filter& blocked_bloom_filter::operator =(const blocked_bloom_filter& other) {
+    if (this != &other) {
+        m_bits = other.m_bits;
+        m_offset_in_bytes = other.m_offset_in_bytes;
+        m_number_of_blocks = other.m_number_of_blocks;
+        m_number_of_hashes = other.m_number_of_hashes;
+        align(m_offset_in_bytes);
+    }
+    return *this;
+}
+
+/**
+ * Construct a filter sized for @a number_of_keys keys with a false positive rate close to @a false_positive_rate. <br>
+ * It uses -log2(rate) hashes and 1.44 * -log2(rate) bits per key as a classic Bloom filter, plus 10% for the
+ * blocking, which puts more keys in some blocks than in others.
+ *
+ * @throw std::domain_error if @a false_positive_rate is not between 0 and 1 (exclusive)
+ */
+inline blocked_bloom_filter blocked_bloom_filter::for_keys(uint64_t number_of_keys, double false_positive_rate) {
+    if (!(false_positive_rate > 0 && false_positive_rate < 1)) {
+        throw std::domain_error("false_positive_rate Must be between 0 and 1");
+    }
+    const double hashes = -std::log2(false_positive_rate);
+    const double bits_per_key = hashes / std::log(2.0) * 1.1;
+    const uint32_t number_of_hashes = uint32_t(std::min(double(MAX_HASHES), std::max(1.0, std::round(hashes))));
+    return blocked_bloom_filter(uint64_t(std::ceil(bits_per_key * double(number_of_keys))), number_of_hashes);
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------ Insert / Lookup --------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+inline void blocked_bloom_filter::insert(uint64_t key) {
+    insert_hash(hash(key));
+}
+
+/**
+ * Insert @a count keys, in batches whose blocks are prefetched before they are written
+ */
+inline void blocked_bloom_filter::insert(const uint64_t* keys, uint64_t count) {
+    uint64_t hashes[BATCH_SIZE];
+    for (uint64_t first = 0; first < count; first += BATCH_SIZE) {
+        const uint32_t batch = count - first < BATCH_SIZE ? uint32_t(count - first) : BATCH_SIZE;
+        for (uint32_t i = 0; i < batch; ++i) {
+            hashes[i] = hash(keys[first + i]);
+            prefetch(blocks() + uint64_t(block_index(hashes[i])) * BLOCK_BYTES);
+        }
+        for (uint32_t i = 0; i < batch; ++i) {
+            insert_hash(hashes[i]);
+        }
+    }
+}
+
+/**
+ * @return true if @a key may have been inserted, false if it was certainly not
+ */
+inline bool blocked_bloom_filter::contains(uint64_t key) const {
+    return contains_hash(hash(key));
+}
+
+/**
+ * Look up @a count keys, in batches whose blocks are prefetched before they are probed
+ *
+ * @param results results[i] is set to contains(keys[i])
+ * @return Number of keys found
+ */
+inline uint64_t blocked_bloom_filter::contains(const uint64_t* keys, uint64_t count, bool* results) const {
+    uint64_t hashes[BATCH_SIZE];
+    uint64_t found = 0;
+    for (uint64_t first = 0; first < count; first += BATCH_SIZE) {
+        const uint32_t batch = count - first < BATCH_SIZE ? uint32_t(count - first) : BATCH_SIZE;
+        for (uint32_t i = 0; i < batch; ++i) {
+            hashes[i] = hash(keys[first + i]);
+            prefetch(blocks() + uint64_t(block_index(hashes[i])) * BLOCK_BYTES);
+        }
+        for (uint32_t i = 0; i < batch; ++i) {
+            results[first + i] = contains_hash(hashes[i]);
+            found += results[first + i];
+        }
+    }
+    return found;
+}
+
+/**
+ * Remove all keys
+ */
+inline void blocked_bloom_filter::clear() {
+    memset(blocks(), 0, uint64_t(m_number_of_blocks) * BLOCK_BYTES);
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------- Serialization ---------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return The filter as a %bit_string: the number of blocks (32 bits), the number of hashes (8 bits) and the bytes of
+ * the blocks, write it with data() and size_in_bytes() and read it back with bit_string::from_data()
+ */
+inline bit_string blocked_bloom_filter::serialize() const {
+    bit_string bits;
+    bits.reserve(HEADER_BITS + uint64_t(m_number_of_blocks) * BLOCK_BITS);
+    bits.append_uint_32(m_number_of_blocks);
+    bits.append_uint_16(uint16_t(m_number_of_hashes), BYTE);
+    bits.append_data(blocks(), m_number_of_blocks * BLOCK_BYTES);
+    return bits;
+}
+
+/**
+ * @param bits A filter written by serialize()
+ * @throw std::logic_error if @a bits is not a valid filter
+ */
+inline blocked_bloom_filter blocked_bloom_filter::deserialize(const bit_string& bits) {
+    if (bits.size() < HEADER_BITS) {
+        throw std::logic_error("bit_string is not a serialized Bloom filter");
+    }
+    const uint64_t number_of_blocks = bits.get_bits(0, 32);
+    const uint32_t number_of_hashes = uint32_t(bits.get_bits(32, BYTE));
+    if (number_of_blocks == 0 || number_of_blocks > MAX_BLOCKS || number_of_hashes == 0 ||
+        number_of_hashes > MAX_HASHES || bits.size() != HEADER_BITS + number_of_blocks * BLOCK_BITS) {
+        throw std::logic_error("bit_string is not a serialized Bloom filter");
+    }
+
+    blocked_bloom_filter filter(number_of_blocks * BLOCK_BITS, number_of_hashes);
+    memcpy(filter.blocks(), bits.data() + HEADER_BITS / BYTE, number_of_blocks * BLOCK_BYTES);
+    return filter;
+}
+
+
+/*===================================================================================================================*/
+/*-------------------------------------------------- Capacity -------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return Number of bits of the filter, without the alignment padding
+ */
+inline uint64_t blocked_bloom_filter::size() const {
+    return uint64_t(m_number_of_blocks) * BLOCK_BITS;
+}
+
+inline uint32_t blocked_bloom_filter::number_of_blocks() const {
+    return m_number_of_blocks;
+}
+
+inline uint32_t blocked_bloom_filter::number_of_hashes() const {
+    return m_number_of_hashes;
+}
+
+/**
+ * @return Number of bits set, i.e. to estimate the fill ratio as count() / size()
+ */
+inline uint32_t blocked_bloom_filter::count() const {
+    return uint32_t(bit_kernels::get().popcount(blocks(), uint64_t(m_number_of_blocks) * BLOCK_BYTES));
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------- Private Helpers ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return @a key mixed by the finalizer of MurmurHash3, every bit of the key changes half of the bits of the hash
+ */
+inline uint64_t blocked_bloom_filter::hash(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ull;
+    key ^= key >> 33;
+    return key;
+}
+
+/**
+ * @return Position in the block (0 to 511) of the @a index-th bit of the key of @a hash
+ */
+inline uint32_t blocked_bloom_filter::bit_in_block(uint64_t hash, uint32_t index) {
+    static const uint32_t SALTS[MAX_HASHES] = {
+            0x47B6137Bu, 0x44974D91u, 0x8824AD5Bu, 0xA2B7289Du, 0x705495C7u, 0x2DF1424Bu, 0x9EFC4947u, 0x5C6BFB31u,
+            0x9E3779B1u, 0x85EBCA77u, 0xC2B2AE3Du, 0x27D4EB2Fu, 0x165667B1u, 0xD3A2646Du, 0xFD7046C5u, 0xB55A4F09u
+    };
+    return (uint32_t(hash) * SALTS[index]) >> (32 - 9);
+}
+
+/**
+ * Hint the CPU to load the cache line of @a block, it does nothing on compilers without a prefetch builtin
+ */
+inline void blocked_bloom_filter::prefetch(const uint8_t* block) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(block);
+#elif defined(_MSC_VER) && defined(BIT_STRING_X86)
+    _mm_prefetch(reinterpret_cast<const char*>(block), _MM_HINT_T0);
+#else
+    (void) block;
+#endif
+}
+
+/**
+ * @return Index of the block of the key of @a hash, the high half of the hash scaled to the number of blocks
+ */
+inline uint32_t blocked_bloom_filter::block_index(uint64_t hash) const {
+    return uint32_t(((hash >> 32) * m_number_of_blocks) >> 32);
+}
+
+inline const uint8_t* blocked_bloom_filter::blocks() const {
+    return m_bits.data() + m_offset_in_bytes;
+}
+
+inline uint8_t* blocked_bloom_filter::blocks() {
+    return &m_bits.at_byte(m_offset_in_bytes);
+}
+
+inline void blocked_bloom_filter::insert_hash(uint64_t hash) {
+    uint8_t* block = blocks() + uint64_t(block_index(hash)) * BLOCK_BYTES;
+    for (uint32_t i = 0; i < m_number_of_hashes; ++i) {
+        const uint32_t position = bit_in_block(hash, i);
+        block[position / BYTE] |= 1u << msb_first::bit_shift(position % BYTE);
+    }
+}
+
+/**
+ * All the bits of the key are tested without branches, a single test decides at the end
+ */
+inline bool blocked_bloom_filter::contains_hash(uint64_t hash) const {
+    const uint8_t* block = blocks() + uint64_t(block_index(hash)) * BLOCK_BYTES;
+    uint32_t missing = 0;
+    for (uint32_t i = 0; i < m_number_of_hashes; ++i) {
+        const uint32_t position = bit_in_block(hash, i);
+        missing |= ~block[position / BYTE] & (1u << msb_first::bit_shift(position % BYTE));
+    }
+    return missing == 0;
+}
+
+/**
+ * @return Offset of the first byte of m_bits aligned to 64 bytes
+ */
+inline uint32_t blocked_bloom_filter::aligned_offset() const {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(m_bits.data());
+    return uint32_t((BLOCK_BYTES - address % BLOCK_BYTES) % BLOCK_BYTES);
+}
+
+/**
+ * Move the blocks, which are at @a offset_in_bytes in m_bits, to aligned_offset(). <br>
+ * A copy of the %bit_string has the same bytes at a different address, so the blocks may need to move.
+ */
+inline void blocked_bloom_filter::align(uint32_t offset_in_bytes) {
+    const uint32_t offset = aligned_offset();
+    if (offset != offset_in_bytes) {
+        uint8_t* data = &m_bits.at_byte(0);
+        memmove(data + offset, data + offset_in_bytes, uint64_t(m_number_of_blocks) * BLOCK_BYTES);
+    }
+    m_offset_in_bytes = offset;
+}
+
+#endif //BLOOM_FILTER_H
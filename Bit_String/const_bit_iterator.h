@@ -3,7 +3,8 @@
 
 #include "bit_iterator_base.h"
 
-class const_bit_iterator : public bit_iterator_base {
+template<typename BitOrder>
+class basic_const_bit_iterator : public bit_iterator_base<BitOrder> {
 
 public:
 
@@ -13,59 +14,61 @@ public:
     using pointer = const bool *;
     using reference = bool;
 
-    const_bit_iterator() : bit_iterator_base(0, nullptr) {}
+    basic_const_bit_iterator() : bit_iterator_base<BitOrder>(0, nullptr) {}
 
-    const_bit_iterator(uint64_t position, uint8_t * data) : bit_iterator_base(position, data) {}
+    basic_const_bit_iterator(uint64_t position, uint8_t * data) : bit_iterator_base<BitOrder>(position, data) {}
 
-    const_bit_iterator& operator ++() {
-        bit_iterator_base::increment();
+    basic_const_bit_iterator& operator ++() {
+        bit_iterator_base<BitOrder>::increment();
         return *this;
     }
 
-    const_bit_iterator operator ++(int) {
+    basic_const_bit_iterator operator ++(int) {
 
-        const_bit_iterator temp = *this;
-        bit_iterator_base::increment();
+        basic_const_bit_iterator temp = *this;
+        bit_iterator_base<BitOrder>::increment();
         return temp;
     }
 
-    const_bit_iterator& operator --() {
-        bit_iterator_base::decrement();
+    basic_const_bit_iterator& operator --() {
+        bit_iterator_base<BitOrder>::decrement();
         return *this;
     }
 
-    const_bit_iterator operator --(int) {
+    basic_const_bit_iterator operator --(int) {
 
-        const_bit_iterator temp = *this;
-        bit_iterator_base::decrement();
+        basic_const_bit_iterator temp = *this;
+        bit_iterator_base<BitOrder>::decrement();
         return temp;
     }
 
-    const_bit_iterator& operator +=(const difference_type diff) {
-        bit_iterator_base::increment(diff);
+    basic_const_bit_iterator& operator +=(const difference_type diff) {
+        bit_iterator_base<BitOrder>::increment(diff);
         return *this;
     }
 
-    const_bit_iterator operator +(const difference_type diff) {
-        const_bit_iterator temp = *this;
+    basic_const_bit_iterator operator +(const difference_type diff) {
+        basic_const_bit_iterator temp = *this;
         return temp += diff;
     }
 
-    const_bit_iterator& operator -=(const difference_type diff) {
-        bit_iterator_base::decrement(diff);
+    basic_const_bit_iterator& operator -=(const difference_type diff) {
+        bit_iterator_base<BitOrder>::decrement(diff);
         return *this;
     }
 
-    const_bit_iterator operator -(const difference_type diff) {
-        const_bit_iterator temp = *this;
+    basic_const_bit_iterator operator -(const difference_type diff) {
+        basic_const_bit_iterator temp = *this;
         return temp -= diff;
     }
 
     bool operator *() const {
-        return bool(bit_reference(get_position() , m_data));
+        return bool(basic_bit_reference<BitOrder>(this->get_position() , this->m_data));
     }
 
 };
 
 
+typedef basic_const_bit_iterator<msb_first> const_bit_iterator;
+
 #endif //CONST_BIT_ITERATOR_H
@@ -0,0 +1,185 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BIT_STRING_X86 1
+#if defined(__x86_64__) || defined(_M_X64)
+#define BIT_STRING_X86_64 1  // 64-bit only intrinsics (_mm_popcnt_u64, _mm256_extract_epi64, ...)
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Allow compiling a single function for a specific instruction set without compiling the whole program with -march
+#if defined(BIT_STRING_X86) && (defined(__GNUC__) || defined(__clang__))
+#define BIT_STRING_TARGET(instruction_sets) __attribute__((target(instruction_sets)))
+#else
+#define BIT_STRING_TARGET(instruction_sets)
+#endif
+
+/**
+ * SIMD levels used to select the bulk kernels, ordered from the least to the most capable.
+ */
+enum class simd_level : uint8_t {
+    scalar = 0,
+    sse4_2 = 1,
+    avx2 = 2,
+    avx512 = 3
+};
+
+/**
+ * Instruction set extensions supported by the running CPU <b>and</b> enabled by the operating system.
+ * Detected once on first use via the @a cpuid instruction.
+ */
+struct cpu_features {
+    bool sse4_2 = false;
+    bool popcnt = false;
+    bool pclmul = false;
+    bool avx2 = false;
+    bool bmi2 = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool avx512vpopcntdq = false;
+
+    static const cpu_features& get();
+
+    simd_level max_simd_level() const;
+
+    static const char* level_name(simd_level level);
+
+    static bool parse_level(const char* name, simd_level& level);
+
+private:
+
+    static cpu_features detect();
+
+#ifdef BIT_STRING_X86
+
+    static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t registers[4]);
+
+    static uint64_t xgetbv();
+
+#endif
+};
+
+
+/**
+ * @return The features of the running CPU, detected only once.
+ */
+inline const cpu_features& cpu_features::get() {
+    static const cpu_features features = detect();
+    return features;
+}
+
+
+/**
+ * @return The most capable SIMD level that can run on this CPU
+ */
+inline simd_level cpu_features::max_simd_level() const {
+    if (avx512f && avx512bw && avx2 && popcnt)
+        return simd_level::avx512;
+    if (avx2 && popcnt)
+        return simd_level::avx2;
+    if (sse4_2 && popcnt)
+        return simd_level::sse4_2;
+    return simd_level::scalar;
+}
+
+
+/**
+ * @return Human readable name of @a level, the same name accepted by parse_level()
+ */
+inline const char* cpu_features::level_name(simd_level level) {
+    switch (level) {
+        case simd_level::sse4_2:
+            return "sse4.2";
+        case simd_level::avx2:
+            return "avx2";
+        case simd_level::avx512:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
+
+
+/**
+ * Converts @a name ("scalar", "sse4.2", "avx2" or "avx512") to simd_level
+ *
+ * @return True if @a name is a known level, otherwise @a level is not modified
+ */
+inline bool cpu_features::parse_level(const char* name, simd_level& level) {
+    const simd_level levels[] = {simd_level::scalar, simd_level::sse4_2, simd_level::avx2, simd_level::avx512};
+    for (simd_level candidate : levels) {
+        if (strcmp(name, level_name(candidate)) == 0) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+inline cpu_features cpu_features::detect() {
+    cpu_features features;
+#ifdef BIT_STRING_X86
+    uint32_t registers[4]; // eax, ebx, ecx, edx
+
+    cpuid(0, 0, registers);
+    const uint32_t max_leaf = registers[0];
+
+    cpuid(1, 0, registers);
+    features.sse4_2 = registers[2] & (1u << 20);
+    features.popcnt = registers[2] & (1u << 23);
+    features.pclmul = registers[2] & (1u << 1);
+
+    const bool os_saves_ymm = (registers[2] & (1u << 27)) && (registers[2] & (1u << 28)) && (xgetbv() & 0x6) == 0x6;
+    const bool os_saves_zmm = os_saves_ymm && (xgetbv() & 0xE0) == 0xE0;
+
+    if (max_leaf >= 7) {
+        cpuid(7, 0, registers);
+        features.avx2 = os_saves_ymm && (registers[1] & (1u << 5));
+        features.bmi2 = registers[1] & (1u << 8);
+        features.avx512f = os_saves_zmm && (registers[1] & (1u << 16));
+        features.avx512bw = os_saves_zmm && (registers[1] & (1u << 30));
+        features.avx512vpopcntdq = os_saves_zmm && (registers[2] & (1u << 14));
+    }
+#endif
+    return features;
+}
+
+#ifdef BIT_STRING_X86
+
+inline void cpu_features::cpuid(uint32_t leaf, uint32_t subleaf, uint32_t registers[4]) {
+#if defined(_MSC_VER)
+    int result[4];
+    __cpuidex(result, leaf, subleaf);
+    memcpy(registers, result, sizeof(result));
+#else
+    __asm__ volatile("cpuid"
+    : "=a"(registers[0]), "=b"(registers[1]), "=c"(registers[2]), "=d"(registers[3])
+    : "a"(leaf), "c"(subleaf));
+#endif
+}
+
+/**
+ * @return The extended control register XCR0, which tells which register states the operating system saves
+ */
+inline uint64_t cpu_features::xgetbv() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (uint64_t(edx) << 32) | eax;
+#endif
+}
+
+#endif
+
+#endif //CPU_FEATURES_H
@@ -0,0 +1,556 @@
+#ifndef CRC_H
+#define CRC_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bit_string.h"
+
+/**
+ * Parameters of a CRC in the Rocksoft model, as listed by the CRC RevEng catalogue
+ */
+struct crc_parameters {
+    uint32_t width;        // Degree of the polynomial, 1 to 64
+    uint64_t polynomial;   // Coefficients of the polynomial without x^width, the most significant bit is x^(width - 1)
+    uint64_t initial;      // Value of the register before the first bit
+    bool reflect_input;    // Bytes are consumed from their least significant bit
+    bool reflect_output;   // The register is reflected before xor_output
+    uint64_t xor_output;   // Xored to the (reflected) register to give the CRC
+};
+
+// Check value (CRC of the bytes "123456789") in the comments
+const crc_parameters CRC_8_SMBUS = {8, 0x07, 0, false, false, 0};                               // 0xF4
+const crc_parameters CRC_16_ARC = {16, 0x8005, 0, true, true, 0};                               // 0xBB3D
+const crc_parameters CRC_16_IBM_3740 = {16, 0x1021, 0xFFFF, false, false, 0};                   // 0x29B1
+const crc_parameters CRC_16_KERMIT = {16, 0x1021, 0, true, true, 0};                            // 0x2189
+const crc_parameters CRC_32_ISO_HDLC = {32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF};    // 0xCBF43926
+const crc_parameters CRC_32_ISCSI = {32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF};       // 0xE3069283
+const crc_parameters CRC_32_BZIP2 = {32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF};     // 0xFC891918
+const crc_parameters CRC_64_ECMA_182 = {64, 0x42F0E1EBA9EA3693ull, 0, false, false, 0};         // 0x6C40DF5F0B497347
+const crc_parameters CRC_64_XZ = {64, 0x42F0E1EBA9EA3693ull, ~0ull, true, true, ~0ull};         // 0x995DC9BBDF1939FA
+
+
+/**
+ * Table driven CRC of any width up to 64 bits, over bytes or over the bits of a %basic_bit_string. <br>
+ * A CRC is the remainder of the division of the message by the polynomial, so it is defined on a stream of bits:
+ * the bits of a %basic_bit_string are consumed in their order, and raw bytes from their most significant bit, or
+ * from the least significant one if reflect_input. So the bytes of a %bit_string (msb_first) give the CRC of the
+ * bytes for the CRCs that do not reflect the input, and those of a %lsb_bit_string for the others.
+ *
+ * The whole bytes are consumed 8 at a time by slicing-by-8 tables, with a register shifting towards the most
+ * significant bits for bytes starting from their most significant bit and towards the least significant one
+ * otherwise, and the bits of a partial byte are consumed one at a time. Buffers of 128 bytes and more are folded
+ * first 64 bytes at a time with carry-less multiplications (PCLMULQDQ) when the CPU supports them, then the last
+ * 16 bytes of the folded remainder go through the tables.
+ *
+ * The register is passed around in the form of the Rocksoft model (not reflected), so a CRC can be computed
+ * incrementally, a piece of a %bit_string at a time, through update() or a crc_engine::state.
+ *
+ * @example crc_engine crc32(CRC_32_ISO_HDLC);
+ *          uint64_t checksum = crc32.compute(frame);
+ *          crc_engine::state running(crc32);
+ *          running.update(header).update(payload);
+ *          uint64_t same = running.value();
+ */
+class crc_engine {
+
+public:
+
+    class state;
+
+    static const uint32_t BYTE = 8;
+    static const uint32_t WORD_BITS = 64;
+    static const uint32_t SLICES = 8;
+    static const uint32_t FOLD_BYTES = 64;  // Bytes folded at a time, 4 lanes of 128 bits
+
+private:
+
+    crc_parameters m_parameters;
+    uint64_t m_mask;                    // The low width bits
+    uint64_t m_polynomial_left;         // Polynomial at the most significant bits of a word
+    uint64_t m_polynomial_reflected;    // Polynomial reflected at the least significant bits of a word
+    std::vector<uint64_t> m_tables;     // SLICES tables of 256 words for each direction of the register
+    uint64_t m_fold_left[4];            // x^(64 + 512), x^512, x^(64 + 128), x^128 mod P
+    uint64_t m_fold_reflected[4];       // x^(64 + 512 - 1), x^(512 - 1), x^(64 + 128 - 1), x^(128 - 1) mod P reflected
+
+    const uint64_t* table_left(uint32_t slice) const;
+
+    const uint64_t* table_reflected(uint32_t slice) const;
+
+    uint64_t power_of_x(uint32_t exponent) const;
+
+    uint64_t update_bytes(uint64_t crc_register, const uint8_t* data, uint64_t length, bool msb_first) const;
+
+    uint64_t update_left(uint64_t left_register, const uint8_t* data, uint64_t length) const;
+
+    uint64_t update_reflected(uint64_t reflected_register, const uint8_t* data, uint64_t length) const;
+
+    static uint64_t reverse_64(uint64_t value);
+
+    static bool use_pclmul();
+
+#ifdef BIT_STRING_X86
+
+    BIT_STRING_TARGET("pclmul,ssse3")
+    static void fold_left(uint64_t left_register, const uint8_t* data, uint64_t length, const uint64_t* constants,
+                          uint8_t* remainder);
+
+    BIT_STRING_TARGET("pclmul,ssse3")
+    static void fold_reflected(uint64_t reflected_register, const uint8_t* data, uint64_t length,
+                               const uint64_t* constants, uint8_t* remainder);
+
+#endif
+
+public:
+
+    explicit crc_engine(const crc_parameters& parameters);
+
+/*===================================================================================================================*/
+
+    uint64_t initial() const;
+
+    template<typename BitOrder>
+    uint64_t update(uint64_t crc_register, const basic_bit_string<BitOrder>& bits) const;
+
+    template<typename BitOrder>
+    uint64_t update(uint64_t crc_register, const basic_bit_string<BitOrder>& bits, uint32_t start,
+                    uint32_t length) const;
+
+    uint64_t update(uint64_t crc_register, const void* data, uint64_t length) const;
+
+    uint64_t update_bit(uint64_t crc_register, bool bit) const;
+
+    uint64_t finish(uint64_t crc_register) const;
+
+    template<typename BitOrder>
+    uint64_t compute(const basic_bit_string<BitOrder>& bits) const;
+
+    uint64_t compute(const void* data, uint64_t length) const;
+
+    const crc_parameters& parameters() const;
+};
+
+
+/**
+ * Running CRC of a stream of bits given in pieces, e.g. the bits appended to a %bit_string since the last update
+ */
+class crc_engine::state {
+
+    const crc_engine* m_engine;
+    uint64_t m_register;
+
+public:
+
+    explicit state(const crc_engine& engine);
+
+    template<typename BitOrder>
+    state& update(const basic_bit_string<BitOrder>& bits);
+
+    template<typename BitOrder>
+    state& update(const basic_bit_string<BitOrder>& bits, uint32_t start, uint32_t length);
+
+    state& update(const void* data, uint64_t length);
+
+    state& update_bit(bool bit);
+
+    uint64_t value() const;
+
+    void reset();
+};
+
+
+/*===================================================================================================================*/
+/*-------------------------------------------------- Constructor ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * Build the slicing tables and the folding constants of the CRC of @a parameters
+ * @throw std::domain_error if the width is not between 1 and 64
+ */
+inline crc_engine::crc_engine(const crc_parameters& parameters) : m_parameters(parameters) {
+    if (parameters.width == 0 || parameters.width > WORD_BITS) {
+        throw std::domain_error("CRC width Must be between 1 and " + std::to_string(WORD_BITS));
+    }
+    const uint32_t width = parameters.width;
+    m_mask = ~uint64_t(0) >> (WORD_BITS - width);
+    m_parameters.polynomial &= m_mask;
+    m_parameters.initial &= m_mask;
+    m_parameters.xor_output &= m_mask;
+    m_polynomial_left = m_parameters.polynomial << (WORD_BITS - width);
+    m_polynomial_reflected = reverse_64(m_parameters.polynomial) >> (WORD_BITS - width);
+
+    // Table j gives the register change of a byte followed by j zero bytes
+    m_tables.resize(2 * SLICES * 256);
+    uint64_t* left = m_tables.data();
+    uint64_t* reflected = m_tables.data() + SLICES * 256;
+    for (uint32_t byte = 0; byte < 256; ++byte) {
+        uint64_t left_register = uint64_t(byte) << (WORD_BITS - BYTE);
+        uint64_t reflected_register = byte;
+        for (uint32_t i = 0; i < BYTE; ++i) {
+            left_register = (left_register << 1) ^ ((left_register >> (WORD_BITS - 1)) ? m_polynomial_left : 0);
+            reflected_register = (reflected_register >> 1) ^ ((reflected_register & 1u) ? m_polynomial_reflected : 0);
+        }
+        left[byte] = left_register;
+        reflected[byte] = reflected_register;
+    }
+    for (uint32_t slice = 1; slice < SLICES; ++slice) {
+        for (uint32_t byte = 0; byte < 256; ++byte) {
+            const uint64_t previous_left = left[(slice - 1) * 256 + byte];
+            const uint64_t previous_reflected = reflected[(slice - 1) * 256 + byte];
+            left[slice * 256 + byte] = (previous_left << BYTE) ^ left[previous_left >> (WORD_BITS - BYTE)];
+            reflected[slice * 256 + byte] = (previous_reflected >> BYTE) ^ reflected[previous_reflected & 0xFF];
+        }
+    }
+
+    // A lane of 128 bits is moved forward by multiplying its two halves by powers of x. The reflected product of two
+    // reflected words is one bit short, so the powers are one less
+    const uint32_t distances[2] = {FOLD_BYTES * BYTE, 128};
+    for (uint32_t i = 0; i < 2; ++i) {
+        m_fold_left[2 * i] = power_of_x(distances[i] + WORD_BITS);
+        m_fold_left[2 * i + 1] = power_of_x(distances[i]);
+        m_fold_reflected[2 * i] = reverse_64(power_of_x(distances[i] + WORD_BITS - 1));
+        m_fold_reflected[2 * i + 1] = reverse_64(power_of_x(distances[i] - 1));
+    }
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------------- Checksum -----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return The register before the first bit, to be passed to update()
+ */
+inline uint64_t crc_engine::initial() const {
+    return m_parameters.initial;
+}
+
+/**
+ * @return The register after the bits of @a bits
+ */
+template<typename BitOrder>
+uint64_t crc_engine::update(uint64_t crc_register, const basic_bit_string<BitOrder>& bits) const {
+    return update(crc_register, bits, 0, bits.size());
+}
+
+/**
+ * Consume the bits of @a bits in [start, start + length), the whole bytes through the tables and the bits of the
+ * first and last partial bytes one at a time
+ *
+ * @return The register after these bits
+ * @throw std::out_of_range if the range exceeds bits.size()
+ */
+template<typename BitOrder>
+uint64_t crc_engine::update(uint64_t crc_register, const basic_bit_string<BitOrder>& bits, uint32_t start,
+                            uint32_t length) const {
+    if (uint64_t(start) + length > bits.size()) {
+        throw std::out_of_range("Range [" + std::to_string(start) + ", " + std::to_string(uint64_t(start) + length) +
+                                ") is out of range of size " + std::to_string(bits.size()));
+    }
+    uint32_t position = start;
+    const uint32_t end = start + length;
+    while (position < end && position % BYTE) {
+        crc_register = update_bit(crc_register, bits[position++]);
+    }
+    const uint32_t whole_bytes = (end - position) / BYTE;
+    if (whole_bytes) {
+        const bool msb_first = BitOrder::bit_shift(0) == BYTE - 1;
+        crc_register = update_bytes(crc_register, bits.data() + position / BYTE, whole_bytes, msb_first);
+        position += whole_bytes * BYTE;
+    }
+    while (position < end) {
+        crc_register = update_bit(crc_register, bits[position++]);
+    }
+    return crc_register;
+}
+
+/**
+ * @return The register after the @a length bytes at @a data, each from its most significant bit or from its least
+ * significant one if reflect_input
+ */
+inline uint64_t crc_engine::update(uint64_t crc_register, const void* data, uint64_t length) const {
+    return update_bytes(crc_register, static_cast<const uint8_t*>(data), length, !m_parameters.reflect_input);
+}
+
+/**
+ * @return The register after the single bit @a bit
+ */
+inline uint64_t crc_engine::update_bit(uint64_t crc_register, bool bit) const {
+    const bool divide = ((crc_register >> (m_parameters.width - 1)) & 1u) != bit;
+    crc_register = (crc_register << 1) & m_mask;
+    return divide ? crc_register ^ m_parameters.polynomial : crc_register;
+}
+
+/**
+ * @return The CRC of the register after the last bit, reflected if reflect_output and xored with xor_output
+ */
+inline uint64_t crc_engine::finish(uint64_t crc_register) const {
+    if (m_parameters.reflect_output)
+        crc_register = reverse_64(crc_register) >> (WORD_BITS - m_parameters.width);
+    return crc_register ^ m_parameters.xor_output;
+}
+
+/**
+ * @return The CRC of the bits of @a bits
+ */
+template<typename BitOrder>
+uint64_t crc_engine::compute(const basic_bit_string<BitOrder>& bits) const {
+    return finish(update(initial(), bits));
+}
+
+/**
+ * @return The CRC of the @a length bytes at @a data
+ */
+inline uint64_t crc_engine::compute(const void* data, uint64_t length) const {
+    return finish(update(initial(), data, length));
+}
+
+inline const crc_parameters& crc_engine::parameters() const {
+    return m_parameters;
+}
+
+
+/*===================================================================================================================*/
+/*----------------------------------------------------- State -------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @param engine The CRC to compute, it must outlive the state
+ */
+inline crc_engine::state::state(const crc_engine& engine) : m_engine(&engine), m_register(engine.initial()) {}
+
+template<typename BitOrder>
+crc_engine::state& crc_engine::state::update(const basic_bit_string<BitOrder>& bits) {
+    m_register = m_engine->update(m_register, bits);
+    return *this;
+}
+
+/**
+ * @throw std::out_of_range if the range exceeds bits.size()
+ */
+template<typename BitOrder>
+crc_engine::state& crc_engine::state::update(const basic_bit_string<BitOrder>& bits, uint32_t start,
+                                             uint32_t length) {
+    m_register = m_engine->update(m_register, bits, start, length);
+    return *this;
+}
+
+inline crc_engine::state& crc_engine::state::update(const void* data, uint64_t length) {
+    m_register = m_engine->update(m_register, data, length);
+    return *this;
+}
+
+inline crc_engine::state& crc_engine::state::update_bit(bool bit) {
+    m_register = m_engine->update_bit(m_register, bit);
+    return *this;
+}
+
+/**
+ * @return The CRC of the bits consumed so far
+ */
+inline uint64_t crc_engine::state::value() const {
+    return m_engine->finish(m_register);
+}
+
+inline void crc_engine::state::reset() {
+    m_register = m_engine->initial();
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------- Private Helpers ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+inline const uint64_t* crc_engine::table_left(uint32_t slice) const {
+    return m_tables.data() + slice * 256;
+}
+
+inline const uint64_t* crc_engine::table_reflected(uint32_t slice) const {
+    return m_tables.data() + (SLICES + slice) * 256;
+}
+
+/**
+ * @return x^exponent mod P, the coefficient of x^i at bit i
+ */
+inline uint64_t crc_engine::power_of_x(uint32_t exponent) const {
+    uint64_t power = uint64_t(1) << (WORD_BITS - m_parameters.width);  // 1 at the most significant bits
+    for (uint32_t i = 0; i < exponent; ++i) {
+        power = (power << 1) ^ ((power >> (WORD_BITS - 1)) ? m_polynomial_left : 0);
+    }
+    return power >> (WORD_BITS - m_parameters.width);
+}
+
+/**
+ * Consume whole bytes with the register shifting towards the first bit of the bytes
+ */
+inline uint64_t crc_engine::update_bytes(uint64_t crc_register, const uint8_t* data, uint64_t length,
+                                         bool msb_first) const {
+    const uint32_t unused_bits = WORD_BITS - m_parameters.width;
+    if (msb_first) {
+        const uint64_t left_register = update_left(crc_register << unused_bits, data, length);
+        return left_register >> unused_bits;
+    }
+    const uint64_t reflected_register = update_reflected(reverse_64(crc_register) >> unused_bits, data, length);
+    return reverse_64(reflected_register) >> unused_bits;
+}
+
+/**
+ * Slicing-by-8 with the register at the most significant bits, the next 8 bytes are xored to it as a big endian word
+ */
+inline uint64_t crc_engine::update_left(uint64_t left_register, const uint8_t* data, uint64_t length) const {
+#ifdef BIT_STRING_X86
+    if (length >= 2 * FOLD_BYTES && use_pclmul()) {
+        const uint64_t folded = length / FOLD_BYTES * FOLD_BYTES;
+        uint8_t remainder[16];
+        fold_left(left_register, data, folded, m_fold_left, remainder);
+        left_register = update_left(0, remainder, sizeof(remainder));
+        data += folded;
+        length -= folded;
+    }
+#endif
+
+    const uint64_t* t0 = table_left(0);
+    for (; length >= SLICES; length -= SLICES, data += SLICES) {
+        const uint64_t word = left_register ^ msb_first::load_64(data);
+        left_register = table_left(7)[word >> 56] ^ table_left(6)[(word >> 48) & 0xFF] ^
+                        table_left(5)[(word >> 40) & 0xFF] ^ table_left(4)[(word >> 32) & 0xFF] ^
+                        table_left(3)[(word >> 24) & 0xFF] ^ table_left(2)[(word >> 16) & 0xFF] ^
+                        table_left(1)[(word >> 8) & 0xFF] ^ t0[word & 0xFF];
+    }
+    for (; length > 0; --length, ++data) {
+        left_register = (left_register << BYTE) ^ t0[(left_register >> (WORD_BITS - BYTE)) ^ *data];
+    }
+    return left_register;
+}
+
+/**
+ * Slicing-by-8 with the register reflected at the least significant bits, the next 8 bytes are xored to it as a
+ * little endian word
+ */
+inline uint64_t crc_engine::update_reflected(uint64_t reflected_register, const uint8_t* data,
+                                             uint64_t length) const {
+#ifdef BIT_STRING_X86
+    if (length >= 2 * FOLD_BYTES && use_pclmul()) {
+        const uint64_t folded = length / FOLD_BYTES * FOLD_BYTES;
+        uint8_t remainder[16];
+        fold_reflected(reflected_register, data, folded, m_fold_reflected, remainder);
+        reflected_register = update_reflected(0, remainder, sizeof(remainder));
+        data += folded;
+        length -= folded;
+    }
+#endif
+
+    const uint64_t* t0 = table_reflected(0);
+    for (; length >= SLICES; length -= SLICES, data += SLICES) {
+        const uint64_t word = reflected_register ^ lsb_first::load_64(data);
+        reflected_register = table_reflected(7)[word & 0xFF] ^ table_reflected(6)[(word >> 8) & 0xFF] ^
+                             table_reflected(5)[(word >> 16) & 0xFF] ^ table_reflected(4)[(word >> 24) & 0xFF] ^
+                             table_reflected(3)[(word >> 32) & 0xFF] ^ table_reflected(2)[(word >> 40) & 0xFF] ^
+                             table_reflected(1)[(word >> 48) & 0xFF] ^ t0[word >> 56];
+    }
+    for (; length > 0; --length, ++data) {
+        reflected_register = (reflected_register >> BYTE) ^ t0[(reflected_register ^ *data) & 0xFF];
+    }
+    return reflected_register;
+}
+
+/**
+ * @return @a value with bit i moved to bit 63 - i
+ */
+inline uint64_t crc_engine::reverse_64(uint64_t value) {
+    return scalar_kernels::reverse_64(value);
+}
+
+/**
+ * @return True if the CPU has PCLMULQDQ and the SIMD kernels were not forced down to scalar
+ */
+inline bool crc_engine::use_pclmul() {
+    return cpu_features::get().pclmul && cpu_features::get().sse4_2 && bit_kernels::get().level != simd_level::scalar;
+}
+
+#ifdef BIT_STRING_X86
+
+/**
+ * Fold @a length bytes (a multiple of 64, at least 128) into a 128-bit remainder with the same CRC, as 4 lanes of
+ * 16 bytes moved forward by 64 bytes: a lane A = H * x^64 + L becomes H * (x^(64 + 512) mod P) + L * (x^512 mod P),
+ * of degree < 128, xored with the next 16 bytes. The lanes are then folded into one 16 bytes apart. <br>
+ * The bytes are big endian 128-bit integers, the register is xored to the first 8 bytes.
+ *
+ * @param remainder The 16 bytes left, in the same order as the input
+ */
+inline void crc_engine::fold_left(uint64_t left_register, const uint8_t* data, uint64_t length,
+                                  const uint64_t* constants, uint8_t* remainder) {
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m128i far = _mm_set_epi64x(int64_t(constants[0]), int64_t(constants[1]));
+    const __m128i near = _mm_set_epi64x(int64_t(constants[2]), int64_t(constants[3]));
+
+    __m128i lanes[4];
+    for (uint32_t i = 0; i < 4; ++i) {
+        lanes[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), reverse);
+    }
+    lanes[0] = _mm_xor_si128(lanes[0], _mm_set_epi64x(int64_t(left_register), 0));
+
+    for (uint64_t offset = FOLD_BYTES; offset < length; offset += FOLD_BYTES) {
+        for (uint32_t i = 0; i < 4; ++i) {
+            const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset + 16 * i));
+            const __m128i high = _mm_clmulepi64_si128(lanes[i], far, 0x11);
+            const __m128i low = _mm_clmulepi64_si128(lanes[i], far, 0x00);
+            lanes[i] = _mm_xor_si128(_mm_xor_si128(high, low), _mm_shuffle_epi8(next, reverse));
+        }
+    }
+
+    __m128i folded = lanes[0];
+    for (uint32_t i = 1; i < 4; ++i) {
+        const __m128i high = _mm_clmulepi64_si128(folded, near, 0x11);
+        const __m128i low = _mm_clmulepi64_si128(folded, near, 0x00);
+        folded = _mm_xor_si128(_mm_xor_si128(high, low), lanes[i]);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(remainder), _mm_shuffle_epi8(folded, reverse));
+}
+
+/**
+ * Same as fold_left() with reflected bytes: the bytes are little endian 128-bit integers whose bit 0 is the first
+ * bit of the stream, the first 8 bytes (low half) have the highest powers of x, and the register is xored to them.
+ * The reflected products are one bit short, which the constants make up for.
+ *
+ * @param remainder The 16 bytes left, in the same order as the input
+ */
+inline void crc_engine::fold_reflected(uint64_t reflected_register, const uint8_t* data, uint64_t length,
+                                       const uint64_t* constants, uint8_t* remainder) {
+    const __m128i far = _mm_set_epi64x(int64_t(constants[1]), int64_t(constants[0]));
+    const __m128i near = _mm_set_epi64x(int64_t(constants[3]), int64_t(constants[2]));
+
+    __m128i lanes[4];
+    for (uint32_t i = 0; i < 4; ++i) {
+        lanes[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i));
+    }
+    lanes[0] = _mm_xor_si128(lanes[0], _mm_set_epi64x(0, int64_t(reflected_register)));
+
+    for (uint64_t offset = FOLD_BYTES; offset < length; offset += FOLD_BYTES) {
+        for (uint32_t i = 0; i < 4; ++i) {
+            const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset + 16 * i));
+            const __m128i high = _mm_clmulepi64_si128(lanes[i], far, 0x11);
+            const __m128i low = _mm_clmulepi64_si128(lanes[i], far, 0x00);
+            lanes[i] = _mm_xor_si128(_mm_xor_si128(high, low), next);
+        }
+    }
+
+    __m128i folded = lanes[0];
+    for (uint32_t i = 1; i < 4; ++i) {
+        const __m128i high = _mm_clmulepi64_si128(folded, near, 0x11);
+        const __m128i low = _mm_clmulepi64_si128(folded, near, 0x00);
+        folded = _mm_xor_si128(_mm_xor_si128(high, low), lanes[i]);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(remainder), folded);
+}
+
+#endif // BIT_STRING_X86
+
+#endif //CRC_H
@@ -0,0 +1,566 @@
+#ifndef ELIAS_FANO_H
+#define ELIAS_FANO_H
+
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bit_string.h"
+
+/**
+ * Non-decreasing sequence of integers in Elias-Fano encoding, i.e. a sorted list of document ids of an inverted
+ * index. <br>
+ * Every value is split in its low L = floor(log2(universe / size)) bits, stored back to back in the low %bit_string,
+ * and its high bits h, stored in unary in the high %bit_string by setting the bit h + i for the i-th value. The
+ * sequence takes at most 2 + L bits per value, close to the minimum for a sorted sequence of this universe.
+ *
+ * The position of every 256th one and every 256th zero of the high bits are sampled, so access(i) (the i-th one) and
+ * next_geq(x) (the first one after the zero of bucket x >> L) scan a few words from a sample. Iterators move forward
+ * by scanning the high bits a word at a time, and skip_to() jumps over whole buckets by counting zeros of words,
+ * which is how intersection() skips the parts of a long sequence that are not in a short one.
+ *
+ * @example elias_fano_sequence ids(sorted_ids.data(), sorted_ids.size());
+ *          uint64_t id = ids.next_geq(1000);
+ *          std::vector<uint64_t> common = intersection(ids, other_ids);
+ */
+class elias_fano_sequence {
+
+public:
+
+    class const_iterator;
+
+    static const uint32_t BYTE = 8;
+    static const uint32_t WORD_BITS = 64;
+    static const uint32_t SAMPLE_RATE = 256;
+
+    // Returned by next_geq() when there is no such value
+    static const uint64_t npos = UINT64_MAX;
+
+private:
+
+    bit_string m_high;
+    bit_string m_low;
+    uint64_t m_size = 0;
+    uint64_t m_universe = 0;
+    uint32_t m_low_bits = 0;
+    std::vector<uint32_t> m_one_samples;   // m_one_samples[j] is the position of the one number j * SAMPLE_RATE
+    std::vector<uint32_t> m_zero_samples;  // m_zero_samples[j] is the position of the zero number j * SAMPLE_RATE
+
+    void build(const uint64_t* values, uint64_t count, uint64_t universe);
+
+    void sample();
+
+    static uint32_t select_in_word(uint64_t word, uint32_t rank);
+
+    static uint32_t select_in_byte(uint8_t byte, uint32_t rank);
+
+    uint64_t find_one(uint64_t position, uint64_t rank) const;
+
+    uint64_t find_zero(uint64_t position, uint64_t rank) const;
+
+    uint64_t select_one(uint64_t rank) const;
+
+    uint64_t select_zero(uint64_t rank) const;
+
+    uint64_t low(uint64_t index) const;
+
+public:
+
+    elias_fano_sequence() = default;
+
+    elias_fano_sequence(const uint64_t* values, uint64_t count, uint64_t universe = 0);
+
+    elias_fano_sequence(const uint32_t* values, uint64_t count, uint64_t universe = 0);
+
+/*===================================================================================================================*/
+
+    uint64_t access(uint64_t index) const;
+
+    uint64_t operator [](uint64_t index) const;
+
+    uint64_t next_geq(uint64_t value) const;
+
+    const_iterator lower_bound(uint64_t value) const;
+
+    const_iterator begin() const;
+
+    const_iterator end() const;
+
+/*===================================================================================================================*/
+
+    bool empty() const;
+
+    uint64_t size() const;
+
+    uint64_t universe() const;
+
+    uint32_t low_bits() const;
+
+    uint64_t size_in_bits() const;
+};
+
+std::vector<uint64_t> intersection(const elias_fano_sequence& a, const elias_fano_sequence& b);
+
+
+/**
+ * Forward iterator over the values of an %elias_fano_sequence, it keeps the position of the current value in the
+ * high bits, so moving to the next value scans the high bits from there.
+ */
+class elias_fano_sequence::const_iterator {
+
+    const elias_fano_sequence* m_sequence = nullptr;
+    uint64_t m_index = 0;
+    uint64_t m_position = 0;       // Position of the one of the current value in the high bits
+    uint64_t m_word_position = 0;  // Position of the word of the high bits holding m_position
+    uint64_t m_word = 0;           // Bits of that word after m_position
+    uint64_t m_value = 0;
+
+    void move_to(uint64_t index, uint64_t position);
+
+    void set_current(uint64_t index, uint64_t position);
+
+public:
+
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = int64_t;
+    using value_type = uint64_t;
+    using pointer = const uint64_t*;
+    using reference = uint64_t;
+
+    const_iterator() = default;
+
+    const_iterator(const elias_fano_sequence* sequence, uint64_t index, uint64_t position);
+
+    uint64_t operator *() const;
+
+    uint64_t index() const;
+
+    const_iterator& operator ++();
+
+    const_iterator operator ++(int);
+
+    void skip_to(uint64_t value);
+
+    bool operator ==(const const_iterator& other) const;
+
+    bool operator !=(const const_iterator& other) const;
+};
+
+
+/**
+ * @param values Non-decreasing values
+ * @param count Number of values
+ * @param universe A bound greater than all values, 0 to use the last value + 1
+ * @throw std::domain_error if the values are not non-decreasing or not less than @a universe
+ * @throw std::length_error if the encoding exceeds the maximum size of a %bit_string
+ */
+inline elias_fano_sequence::elias_fano_sequence(const uint64_t* values, uint64_t count, uint64_t universe) {
+    build(values, count, universe);
+}
+
+/**
+ * @copydoc elias_fano_sequence(const uint64_t*, uint64_t, uint64_t)
+ */
+inline elias_fano_sequence::elias_fano_sequence(const uint32_t* values, uint64_t count, uint64_t universe) {
+    std::vector<uint64_t> wide(values, values + count);
+    build(wide.data(), count, universe);
+}
+
+
+/*===================================================================================================================*/
+/*--------------------------------------------------- Access --------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return The value at @a index
+ * @throw std::out_of_range if @a index is greater than or equal size()
+ */
+inline uint64_t elias_fano_sequence::access(uint64_t index) const {
+    if (index >= m_size) {
+        throw std::out_of_range("index " + std::to_string(index) + " is out of range of elias_fano_sequence of size " +
+                                std::to_string(m_size));
+    }
+    return ((select_one(index) - index) << m_low_bits) | low(index);
+}
+
+inline uint64_t elias_fano_sequence::operator [](uint64_t index) const {
+    return access(index);
+}
+
+/**
+ * @return The first value greater than or equal @a value, npos if there is none
+ */
+inline uint64_t elias_fano_sequence::next_geq(uint64_t value) const {
+    const const_iterator it = lower_bound(value);
+    return it == end() ? npos : *it;
+}
+
+/**
+ * @return Iterator to the first value greater than or equal @a value, end() if there is none
+ */
+inline elias_fano_sequence::const_iterator elias_fano_sequence::lower_bound(uint64_t value) const {
+    if (m_size == 0 || value >= m_universe)
+        return end();
+
+    // The values of the bucket h = value >> L start after the zero number h - 1 of the high bits, which end with the
+    // zero of the bucket of the last value, so the buckets after it (when the universe is larger) have no values
+    const uint64_t bucket = value >> m_low_bits;
+    if (bucket >= m_high.size() - m_size)
+        return end();
+    const uint64_t start = bucket == 0 ? 0 : select_zero(bucket - 1) + 1;
+
+    const_iterator it(this, start - bucket, find_one(start, 0));
+    it.skip_to(value);
+    return it;
+}
+
+inline elias_fano_sequence::const_iterator elias_fano_sequence::begin() const {
+    return m_size ? const_iterator(this, 0, find_one(0, 0)) : end();
+}
+
+inline elias_fano_sequence::const_iterator elias_fano_sequence::end() const {
+    return const_iterator(this, m_size, 0);
+}
+
+
+/*===================================================================================================================*/
+/*-------------------------------------------------- Capacity -------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+inline bool elias_fano_sequence::empty() const {
+    return m_size == 0;
+}
+
+inline uint64_t elias_fano_sequence::size() const {
+    return m_size;
+}
+
+/**
+ * @return The bound of the values, all of them are less than it
+ */
+inline uint64_t elias_fano_sequence::universe() const {
+    return m_universe;
+}
+
+/**
+ * @return Number of low bits L of every value
+ */
+inline uint32_t elias_fano_sequence::low_bits() const {
+    return m_low_bits;
+}
+
+/**
+ * @return Size of the encoding, the high and low bits and the samples
+ */
+inline uint64_t elias_fano_sequence::size_in_bits() const {
+    return uint64_t(m_high.size()) + m_low.size() + (m_one_samples.size() + m_zero_samples.size()) * 32;
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------------- Iterator -----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+inline elias_fano_sequence::const_iterator::const_iterator(const elias_fano_sequence* sequence, uint64_t index,
+                                                           uint64_t position) : m_sequence(sequence) {
+    move_to(index, position);
+}
+
+inline uint64_t elias_fano_sequence::const_iterator::operator *() const {
+    return m_value;
+}
+
+/**
+ * @return Index of the current value in the sequence
+ */
+inline uint64_t elias_fano_sequence::const_iterator::index() const {
+    return m_index;
+}
+
+inline elias_fano_sequence::const_iterator& elias_fano_sequence::const_iterator::operator ++() {
+    if (m_index + 1 == m_sequence->m_size) {
+        m_index = m_sequence->m_size;
+        return *this;
+    }
+    while (m_word == 0) {
+        m_word_position += WORD_BITS;
+        m_word = m_sequence->m_high.load_word(m_word_position);
+    }
+    const uint32_t first = msb_first::first_one(m_word);
+    m_word &= ~msb_first::head_mask_64(first + 1);
+    set_current(m_index + 1, m_word_position + first);
+    return *this;
+}
+
+inline elias_fano_sequence::const_iterator elias_fano_sequence::const_iterator::operator ++(int) {
+    const_iterator temp = *this;
+    ++*this;
+    return temp;
+}
+
+/**
+ * Move forward to the first value greater than or equal @a value, or to the end. <br>
+ * The buckets before the one of @a value are skipped by counting zeros of the high bits a word at a time from the
+ * current position, or from a sample if the bucket is far.
+ */
+inline void elias_fano_sequence::const_iterator::skip_to(uint64_t value) {
+    const elias_fano_sequence& sequence = *m_sequence;
+    if (m_index == sequence.m_size || m_value >= value)
+        return;
+    if (value >= sequence.m_universe) {
+        move_to(sequence.m_size, 0);
+        return;
+    }
+
+    const uint64_t bucket = value >> sequence.m_low_bits;
+    if (bucket >= sequence.m_high.size() - sequence.m_size) {
+        // After the bucket of the last value
+        move_to(sequence.m_size, 0);
+        return;
+    }
+    const uint64_t current_bucket = m_position - m_index;
+    if (bucket > current_bucket) {
+        // Start after the zero number bucket - 1, there are bucket - current_bucket zeros after m_position before it
+        const uint64_t zeros = bucket - current_bucket;
+        const uint64_t start = 1 + (zeros > SAMPLE_RATE ? sequence.select_zero(bucket - 1)
+                                                        : sequence.find_zero(m_position + 1, zeros - 1));
+        move_to(start - bucket, sequence.find_one(start, 0));
+    }
+
+    while (m_index < sequence.m_size && m_value < value) {
+        ++*this;
+    }
+}
+
+inline bool elias_fano_sequence::const_iterator::operator ==(const const_iterator& other) const {
+    return m_index == other.m_index && m_sequence == other.m_sequence;
+}
+
+inline bool elias_fano_sequence::const_iterator::operator !=(const const_iterator& other) const {
+    return !(*this == other);
+}
+
+/**
+ * Make the value at @a index, whose one is at @a position of the high bits, the current one and load its word
+ */
+inline void elias_fano_sequence::const_iterator::move_to(uint64_t index, uint64_t position) {
+    if (index == m_sequence->m_size) {
+        m_index = index;
+        return;
+    }
+    m_word_position = position / WORD_BITS * WORD_BITS;
+    const uint32_t offset = uint32_t(position - m_word_position);
+    m_word = m_sequence->m_high.load_word(m_word_position) & ~msb_first::head_mask_64(offset + 1);
+    set_current(index, position);
+}
+
+inline void elias_fano_sequence::const_iterator::set_current(uint64_t index, uint64_t position) {
+    m_index = index;
+    m_position = position;
+    m_value = ((position - index) << m_sequence->m_low_bits) | m_sequence->low(index);
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------- Intersection ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * Intersect two sequences by walking the shorter one and skipping to its values in the longer one with
+ * const_iterator::skip_to(), so the cost depends on the size of the shorter sequence and on the words of the high
+ * bits of the longer one between its values. A value repeated in both sequences is reported min(count) times.
+ *
+ * @return The values in both @a a and @a b, in increasing order
+ */
+inline std::vector<uint64_t> intersection(const elias_fano_sequence& a, const elias_fano_sequence& b) {
+    const elias_fano_sequence& shorter = a.size() <= b.size() ? a : b;
+    const elias_fano_sequence& longer = a.size() <= b.size() ? b : a;
+
+    std::vector<uint64_t> common;
+    elias_fano_sequence::const_iterator i = shorter.begin();
+    elias_fano_sequence::const_iterator j = longer.begin();
+    const elias_fano_sequence::const_iterator shorter_end = shorter.end();
+    const elias_fano_sequence::const_iterator longer_end = longer.end();
+
+    while (i != shorter_end) {
+        j.skip_to(*i);
+        if (j == longer_end)
+            break;
+        if (*j == *i) {
+            common.push_back(*i);
+            ++i;
+            ++j;
+        } else {
+            i.skip_to(*j);
+        }
+    }
+    return common;
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------- Private Helpers ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+inline void elias_fano_sequence::build(const uint64_t* values, uint64_t count, uint64_t universe) {
+    for (uint64_t i = 1; i < count; ++i) {
+        if (values[i] < values[i - 1])
+            throw std::domain_error("values of elias_fano_sequence Must be non-decreasing");
+    }
+    if (count && universe == 0) {
+        if (values[count - 1] == UINT64_MAX)
+            throw std::domain_error("values of elias_fano_sequence Must be less than " + std::to_string(UINT64_MAX));
+        universe = values[count - 1] + 1;
+    }
+    if (count && values[count - 1] >= universe) {
+        throw std::domain_error("values of elias_fano_sequence Must be less than the universe " +
+                                std::to_string(universe));
+    }
+
+    m_size = count;
+    m_universe = universe;
+    m_low_bits = count && universe > count ? WORD_BITS - 1 - msb_first::first_one(universe / count) : 0;
+
+    const uint64_t high_bits = count ? count + (values[count - 1] >> m_low_bits) + 1 : 0;
+    const uint64_t low_bits = count * m_low_bits;
+    if (high_bits > UINT32_MAX || low_bits > UINT32_MAX) {
+        throw std::length_error("elias_fano_sequence of " + std::to_string(count) + " values is too large");
+    }
+
+    m_high.resize(high_bits, false);
+    m_low.reserve(low_bits);
+    for (uint64_t i = 0; i < count; ++i) {
+        m_high[uint32_t((values[i] >> m_low_bits) + i)] = true;
+        m_low.append_uint_64(values[i], m_low_bits);
+    }
+    sample();
+}
+
+/**
+ * Record the positions of every SAMPLE_RATE-th one and zero of the high bits, a word at a time
+ */
+inline void elias_fano_sequence::sample() {
+    uint64_t ones = 0;
+    uint64_t zeros = 0;
+    for (uint64_t position = 0; position < m_high.size(); position += WORD_BITS) {
+        const uint32_t valid = m_high.size() - position < WORD_BITS ? uint32_t(m_high.size() - position) : WORD_BITS;
+        const uint64_t word = m_high.load_word(position) & msb_first::head_mask_64(valid);
+        const uint64_t word_zeros = ~word & msb_first::head_mask_64(valid);
+        const uint32_t word_ones = uint32_t(scalar_kernels::popcount_64(word));
+
+        for (uint64_t rank = m_one_samples.size() * SAMPLE_RATE; rank < ones + word_ones; rank += SAMPLE_RATE) {
+            m_one_samples.push_back(uint32_t(position + select_in_word(word, uint32_t(rank - ones))));
+        }
+        for (uint64_t rank = m_zero_samples.size() * SAMPLE_RATE; rank < zeros + valid - word_ones;
+             rank += SAMPLE_RATE) {
+            m_zero_samples.push_back(uint32_t(position + select_in_word(word_zeros, uint32_t(rank - zeros))));
+        }
+        ones += word_ones;
+        zeros += valid - word_ones;
+    }
+}
+
+/**
+ * Broadword select: the counts of ones of the bytes are summed in parallel, the byte of the one is the number of
+ * prefix sums less than or equal @a rank, and the one is found in that byte by a table lookup.
+ *
+ * @return Index (from the start of the word) of the one number @a rank of @a word, which has more than @a rank ones
+ */
+inline uint32_t elias_fano_sequence::select_in_word(uint64_t word, uint32_t rank) {
+    const uint64_t ONES_STEP_8 = 0x0101010101010101ull;
+    const uint64_t MSBS_STEP_8 = 0x8080808080808080ull;
+
+    // Byte i of bytes is byte i of the word from its start, so the prefix sums grow towards the most significant
+    const uint64_t bytes = scalar_kernels::byte_swap_64(word);
+    uint64_t counts = bytes - ((bytes >> 1) & 0x5555555555555555ull);
+    counts = (counts & 0x3333333333333333ull) + ((counts >> 2) & 0x3333333333333333ull);
+    counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    const uint64_t prefix_sums = counts * ONES_STEP_8;
+
+    const uint64_t before = ((rank * ONES_STEP_8) | MSBS_STEP_8) - prefix_sums;
+    const uint32_t shift = uint32_t((((before & MSBS_STEP_8) >> 7) * ONES_STEP_8) >> 53) & ~7u;
+    const uint32_t byte_rank = rank - uint32_t(((prefix_sums << 8) >> shift) & 0xFF);
+    return shift + select_in_byte(uint8_t(bytes >> shift), byte_rank);
+}
+
+/**
+ * @return Index (from the start of the byte) of the one number @a rank of @a byte, which has more than @a rank ones
+ */
+inline uint32_t elias_fano_sequence::select_in_byte(uint8_t byte, uint32_t rank) {
+    struct table {
+        uint8_t index[BYTE][256];
+
+        table() {
+            for (uint32_t value = 0; value < 256; ++value) {
+                for (uint32_t i = 0, ones = 0; i < BYTE; ++i) {
+                    if (value & msb_first::delay(0x80u, i))
+                        index[ones++][value] = uint8_t(i);
+                }
+            }
+        }
+    };
+    static const table select_table;
+    return select_table.index[rank][byte];
+}
+
+/**
+ * @return Position of the one number @a rank counted from @a position of the high bits, which must exist
+ */
+inline uint64_t elias_fano_sequence::find_one(uint64_t position, uint64_t rank) const {
+    uint64_t word = m_high.load_word(position);
+    uint64_t ones = scalar_kernels::popcount_64(word);
+    while (rank >= ones) {
+        rank -= ones;
+        position += WORD_BITS;
+        word = m_high.load_word(position);
+        ones = scalar_kernels::popcount_64(word);
+    }
+    return position + select_in_word(word, uint32_t(rank));
+}
+
+/**
+ * @return Position of the zero number @a rank counted from @a position of the high bits, which must exist
+ */
+inline uint64_t elias_fano_sequence::find_zero(uint64_t position, uint64_t rank) const {
+    uint64_t word = ~m_high.load_word(position);
+    uint64_t zeros = scalar_kernels::popcount_64(word);
+    while (rank >= zeros) {
+        rank -= zeros;
+        position += WORD_BITS;
+        word = ~m_high.load_word(position);
+        zeros = scalar_kernels::popcount_64(word);
+    }
+    return position + select_in_word(word, uint32_t(rank));
+}
+
+/**
+ * @return Position of the one number @a rank of the high bits, scanning from the closest sample before it
+ */
+inline uint64_t elias_fano_sequence::select_one(uint64_t rank) const {
+    const uint64_t sample = rank / SAMPLE_RATE;
+    return find_one(m_one_samples[sample], rank - sample * SAMPLE_RATE);
+}
+
+/**
+ * @return Position of the zero number @a rank of the high bits, scanning from the closest sample before it
+ */
+inline uint64_t elias_fano_sequence::select_zero(uint64_t rank) const {
+    const uint64_t sample = rank / SAMPLE_RATE;
+    return find_zero(m_zero_samples[sample], rank - sample * SAMPLE_RATE);
+}
+
+/**
+ * @return The low bits of the value at @a index
+ */
+inline uint64_t elias_fano_sequence::low(uint64_t index) const {
+    return m_low_bits ? msb_first::to_value(m_low.load_word(index * m_low_bits), m_low_bits) : 0;
+}
+
+#endif //ELIAS_FANO_H
@@ -0,0 +1,74 @@
+#ifndef FINGERPRINT_SEARCH_H
+#define FINGERPRINT_SEARCH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "bit_string.h"
+
+/**
+ * A fingerprint found by nearest_fingerprints()
+ */
+struct fingerprint_match {
+    uint64_t index;     // Index of the fingerprint in the searched array
+    uint32_t distance;  // Hamming distance to the query
+
+    bool operator <(const fingerprint_match& other) const {
+        return distance != other.distance ? distance < other.distance : index < other.index;
+    }
+};
+
+
+/**
+ * Find the @a k fingerprints nearest (in hamming distance) to @a query in a contiguous array of @a count
+ * fingerprints of query.size_in_bytes() bytes each, as laid out by copying bit_string::data() of %bit_string of the
+ * same size back to back. <br>
+ * The unused bits of the last byte of every fingerprint must be zeros, as they are in bit_string::data().
+ *
+ * The distances are computed in batches by the SIMD kernels (VPOPCNTQ with AVX-512, a nibble lookup table with AVX2,
+ * POPCNT otherwise), then every batch is merged into a max heap of the best @a k matches, which only needs a single
+ * comparison for most fingerprints.
+ *
+ * @return Up to @a k matches sorted by distance, ties are sorted by index
+ *
+ * @example std::vector<fingerprint_match> matches = nearest_fingerprints(query, database.data(), n, 10);
+ */
+template<typename BitOrder>
+std::vector<fingerprint_match> nearest_fingerprints(const basic_bit_string<BitOrder>& query,
+                                                    const uint8_t* fingerprints, uint64_t count, uint32_t k) {
+    const uint32_t BATCH_SIZE = 256;
+    const uint64_t length = query.size_in_bytes();
+
+    // Clear the unused bits of the query, so they do not count as differences
+    query.fill_extra_bits_with_zeros();
+
+    std::vector<fingerprint_match> heap;
+    if (k == 0) {
+        return heap;
+    }
+    heap.reserve(k);
+
+    const bit_kernels& kernels = bit_kernels::get();
+    uint32_t distances[BATCH_SIZE];
+    for (uint64_t first = 0; first < count; first += BATCH_SIZE) {
+        const uint64_t batch = std::min<uint64_t>(BATCH_SIZE, count - first);
+        kernels.hamming_distances(query.data(), fingerprints + first * length, batch, length, distances);
+        for (uint64_t j = 0; j < batch; ++j) {
+            const fingerprint_match match = {first + j, distances[j]};
+            if (heap.size() < k) {
+                heap.push_back(match);
+                std::push_heap(heap.begin(), heap.end());
+            } else if (match < heap.front()) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = match;
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+    return heap;
+}
+
+#endif //FINGERPRINT_SEARCH_H
@@ -0,0 +1,303 @@
+#ifndef GF2_H
+#define GF2_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bit_matrix.h"
+
+/**
+ * Dense linear algebra over GF(2) on %basic_bit_matrix, where addition is XOR and multiplication is AND. <br>
+ * Every row operation adds (XORs) whole rows with the SIMD bitwise_xor kernel, and both the product and the
+ * elimination use the Method of Four Russians: the 2^8 sums of a group of 8 rows are tabulated once, then every
+ * other row is updated with a single table row selected by its 8 bits in the group, instead of up to 8 row
+ * additions. Both cost O(n^3 / (64 * 8)) word operations for n x n matrices.
+ *
+ * @example bit_matrix a = ...;
+ *          bit_string x;
+ *          if (gf2::solve(a, b, x))
+ *              assert(gf2::multiply(a, x) == b);
+ */
+class gf2 {
+
+public:
+
+    static const uint32_t BYTE = 8;
+    static const uint32_t WORD_BITS = 64;
+    static const uint32_t GROUP_BITS = 8;  // Rows combined by a table of the Method of Four Russians
+
+    template<typename BitOrder>
+    static basic_bit_string<BitOrder> multiply(const basic_bit_matrix<BitOrder>& a,
+                                               const basic_bit_string<BitOrder>& x);
+
+    template<typename BitOrder>
+    static basic_bit_matrix<BitOrder> multiply(const basic_bit_matrix<BitOrder>& a,
+                                               const basic_bit_matrix<BitOrder>& b);
+
+    template<typename BitOrder>
+    static uint32_t row_reduce(basic_bit_matrix<BitOrder>& matrix);
+
+    template<typename BitOrder>
+    static uint32_t rank(basic_bit_matrix<BitOrder> matrix);
+
+    template<typename BitOrder>
+    static bool solve(const basic_bit_matrix<BitOrder>& a, const basic_bit_string<BitOrder>& b,
+                      basic_bit_string<BitOrder>& x);
+
+private:
+
+    template<typename BitOrder>
+    static bool get_bit(const uint8_t* row, uint32_t column);
+
+    template<typename BitOrder>
+    static uint32_t first_one(const uint8_t* row, uint32_t number_of_words);
+};
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------- Multiplication --------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return The product @a a * @a x, bit i is the parity of the AND of the row i of @a a and @a x
+ * @throw std::length_error if the size of @a x is not the number of columns of @a a
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> gf2::multiply(const basic_bit_matrix<BitOrder>& a, const basic_bit_string<BitOrder>& x) {
+    if (x.size() != a.number_of_columns()) {
+        throw std::length_error("bit_string of size " + std::to_string(x.size()) + " can not multiply a matrix of " +
+                                std::to_string(a.number_of_columns()) + " columns");
+    }
+
+    // The vector padded to whole words as a row of the matrix, the parity does not depend on the order of the bits
+    const uint32_t words = a.words_per_row();
+    std::vector<uint64_t> vector(words, 0);
+    x.fill_extra_bits_with_zeros();
+    if (x.size())
+        memcpy(vector.data(), x.data(), x.size_in_bytes());
+
+    basic_bit_string<BitOrder> product(a.number_of_rows(), false);
+    for (uint32_t i = 0; i < a.number_of_rows(); ++i) {
+        const uint8_t* row = a[i].data();
+        uint64_t sum = 0;
+        for (uint32_t k = 0; k < words; ++k) {
+            uint64_t word;
+            memcpy(&word, row + k * sizeof(uint64_t), sizeof(word));
+            sum ^= word & vector[k];
+        }
+        product[i] = scalar_kernels::popcount_64(sum) & 1u;
+    }
+    return product;
+}
+
+/**
+ * Method of Four Russians: for every group of 8 rows of @a b, the 256 sums of its rows are tabulated (each from a
+ * smaller one plus one row), then every row of the product adds the sum selected by its 8 bits of @a a in the group.
+ *
+ * @return The product @a a * @a b
+ * @throw std::length_error if the number of columns of @a a is not the number of rows of @a b
+ */
+template<typename BitOrder>
+basic_bit_matrix<BitOrder> gf2::multiply(const basic_bit_matrix<BitOrder>& a, const basic_bit_matrix<BitOrder>& b) {
+    if (a.number_of_columns() != b.number_of_rows()) {
+        throw std::length_error("matrix of " + std::to_string(a.number_of_columns()) + " columns can not multiply " +
+                                "a matrix of " + std::to_string(b.number_of_rows()) + " rows");
+    }
+
+    basic_bit_matrix<BitOrder> product(a.number_of_rows(), b.number_of_columns());
+    const uint64_t row_bytes = uint64_t(b.words_per_row()) * sizeof(uint64_t);
+    if (row_bytes == 0)
+        return product;  // No columns, and no table of sums to build
+    const bit_kernels& kernels = bit_kernels::get();
+    std::vector<uint8_t> table(row_bytes << GROUP_BITS);
+
+    for (uint32_t first = 0; first < b.number_of_rows(); first += GROUP_BITS) {
+        const uint32_t rows = b.number_of_rows() - first < GROUP_BITS ? b.number_of_rows() - first : GROUP_BITS;
+
+        // The sum of index has the rows of b whose bits are set in index, as the field returned by get_bits(), so
+        // the bit i of index is the row of b at_bit[i]
+        uint32_t at_bit[GROUP_BITS];
+        for (uint32_t t = 0; t < rows; ++t) {
+            const uint64_t bit = BitOrder::to_value(BitOrder::delay(BitOrder::head_mask_64(1), t), rows);
+            at_bit[scalar_kernels::trailing_zeros_64(bit)] = first + t;
+        }
+        for (uint32_t i = 0; i < rows; ++i) {
+            const uint64_t bit = uint64_t(1) << i;
+            uint8_t* sums = table.data() + bit * row_bytes;
+            memcpy(sums, table.data(), bit * row_bytes);
+            for (uint64_t index = 0; index < bit; ++index) {
+                kernels.bitwise_xor(sums + index * row_bytes, b[at_bit[i]].data(), row_bytes);
+            }
+        }
+
+        for (uint32_t i = 0; i < a.number_of_rows(); ++i) {
+            const uint64_t index = a[i].get_bits(first, rows);
+            if (index)
+                kernels.bitwise_xor(product[i].data(), table.data() + index * row_bytes, row_bytes);
+        }
+    }
+    return product;
+}
+
+
+/*===================================================================================================================*/
+/*--------------------------------------------------- Elimination ---------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * Transform @a matrix in place to its reduced row echelon form: the first rank() rows have a leading one in
+ * increasing columns, which is the only one of its column, and the other rows are zeros. <br>
+ * The columns are eliminated by groups of 8 (Method of Four Russians). Up to 8 pivots of the group are found, the
+ * candidate rows being reduced by the pivots found before them, and the pivots are reduced to have a single one in
+ * the pivot columns. Then the 2^pivots sums of the pivots are tabulated, and every other row adds the sum selected
+ * by its bits in the pivot columns, from the first word of the group as the pivots are zeros before it.
+ *
+ * @return The rank of @a matrix
+ */
+template<typename BitOrder>
+uint32_t gf2::row_reduce(basic_bit_matrix<BitOrder>& matrix) {
+    const uint32_t rows = matrix.number_of_rows();
+    const uint32_t columns = matrix.number_of_columns();
+    const uint32_t words = matrix.words_per_row();
+    const bit_kernels& kernels = bit_kernels::get();
+    if (rows == 0 || columns == 0)
+        return 0;
+
+    std::vector<uint8_t> table(uint64_t(words) * sizeof(uint64_t) << GROUP_BITS);
+    uint32_t pivot_columns[GROUP_BITS];
+    uint32_t rank = 0;
+
+    for (uint32_t first = 0; first < columns && rank < rows; first += GROUP_BITS) {
+        const uint32_t last = columns - first < GROUP_BITS ? columns : first + GROUP_BITS;
+        const uint32_t offset = first / WORD_BITS * sizeof(uint64_t);  // Bytes of the rows before the group
+        const uint64_t length = uint64_t(words) * sizeof(uint64_t) - offset;
+        uint32_t pivots = 0;
+
+        for (uint32_t column = first; column < last && rank + pivots < rows; ++column) {
+            for (uint32_t i = rank + pivots; i < rows; ++i) {
+                uint8_t* row = matrix[i].data();
+                for (uint32_t p = 0; p < pivots; ++p) {
+                    if (get_bit<BitOrder>(row, pivot_columns[p]))
+                        kernels.bitwise_xor(row + offset, matrix[rank + p].data() + offset, length);
+                }
+                if (!get_bit<BitOrder>(row, column))
+                    continue;
+
+                const uint32_t pivot = rank + pivots;
+                matrix.swap_rows(i, pivot);
+                const uint8_t* pivot_row = matrix[pivot].data();
+                for (uint32_t p = 0; p < pivots; ++p) {
+                    uint8_t* other = matrix[rank + p].data();
+                    if (get_bit<BitOrder>(other, column))
+                        kernels.bitwise_xor(other + offset, pivot_row + offset, length);
+                }
+                pivot_columns[pivots++] = column;
+                break;
+            }
+        }
+        if (pivots == 0)
+            continue;
+
+        // The sum of index has the pivots p whose bit p is set in index
+        for (uint32_t p = 0; p < pivots; ++p) {
+            const uint64_t bit = uint64_t(1) << p;
+            uint8_t* sums = table.data() + bit * length;
+            memcpy(sums, table.data(), bit * length);
+            for (uint64_t index = 0; index < bit; ++index) {
+                kernels.bitwise_xor(sums + index * length, matrix[rank + p].data() + offset, length);
+            }
+        }
+
+        for (uint32_t i = 0; i < rows; ++i) {
+            if (i == rank)
+                i += pivots;
+            if (i >= rows)
+                break;
+            uint8_t* row = matrix[i].data();
+            uint64_t index = 0;
+            for (uint32_t p = 0; p < pivots; ++p) {
+                index |= uint64_t(get_bit<BitOrder>(row, pivot_columns[p])) << p;
+            }
+            if (index)
+                kernels.bitwise_xor(row + offset, table.data() + index * length, length);
+        }
+        rank += pivots;
+    }
+    return rank;
+}
+
+/**
+ * @return The rank of @a matrix, the number of its linearly independent rows
+ */
+template<typename BitOrder>
+uint32_t gf2::rank(basic_bit_matrix<BitOrder> matrix) {
+    return row_reduce(matrix);
+}
+
+/**
+ * Solve @a a * @a x = @a b by reducing the augmented matrix [a | b], the free variables of @a x are zeros.
+ *
+ * @param x Set to a solution if there is one
+ * @return True if the system has a solution
+ * @throw std::length_error if the size of @a b is not the number of rows of @a a
+ */
+template<typename BitOrder>
+bool gf2::solve(const basic_bit_matrix<BitOrder>& a, const basic_bit_string<BitOrder>& b,
+                basic_bit_string<BitOrder>& x) {
+    const uint32_t rows = a.number_of_rows();
+    const uint32_t columns = a.number_of_columns();
+    if (b.size() != rows) {
+        throw std::length_error("bit_string of size " + std::to_string(b.size()) + " is not a right hand side of a " +
+                                "matrix of " + std::to_string(rows) + " rows");
+    }
+
+    basic_bit_matrix<BitOrder> augmented(rows, columns + 1);
+    for (uint32_t i = 0; i < rows; ++i) {
+        if (columns)
+            memcpy(augmented[i].data(), a[i].data(), a[i].size_in_bytes());
+        augmented[i][columns] = b[i];
+    }
+
+    const uint32_t rank = row_reduce(augmented);
+    basic_bit_string<BitOrder> solution(columns, false);
+    for (uint32_t i = 0; i < rank; ++i) {
+        const uint32_t pivot = first_one<BitOrder>(augmented[i].data(), augmented.words_per_row());
+        if (pivot == columns)
+            return false;  // The row 0 = 1
+        solution[pivot] = augmented[i][columns];
+    }
+    x = std::move(solution);
+    return true;
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------- Private Helpers ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+template<typename BitOrder>
+bool gf2::get_bit(const uint8_t* row, uint32_t column) {
+    return (row[column / BYTE] >> BitOrder::bit_shift(column % BYTE)) & 1u;
+}
+
+/**
+ * @return The column of the first one of a non zero @a row
+ */
+template<typename BitOrder>
+uint32_t gf2::first_one(const uint8_t* row, uint32_t number_of_words) {
+    for (uint32_t k = 0; k < number_of_words; ++k) {
+        const uint64_t word = BitOrder::load_64(row + k * sizeof(uint64_t));
+        if (word)
+            return k * WORD_BITS + BitOrder::first_one(word);
+    }
+    return number_of_words * WORD_BITS;
+}
+
+#endif //GF2_H
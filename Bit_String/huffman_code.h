@@ -0,0 +1,570 @@
+#ifndef HUFFMAN_CODE_H
+#define HUFFMAN_CODE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bit_string.h"
+#include "bit_reader.h"
+#include "bit_writer.h"
+#include "integer_codes.h"
+
+/**
+ * Canonical Huffman code of an alphabet of symbols 0 to number_of_symbols() - 1. <br>
+ * A canonical code is fully defined by the code lengths: the codes of the same length are consecutive integers in the
+ * order of the symbols, and shorter codes come first (as in DEFLATE). So only code_lengths() must be stored with the
+ * encoded data to rebuild the code with from_code_lengths().
+ *
+ * The code of a symbol is stored first bit first, so it is the integer code(symbol) appended with
+ * append_uint_64(code, length) to a %bit_string, and is bit reversed in a %lsb_bit_string.
+ * basic_huffman_encoder and basic_huffman_decoder do the coding.
+ *
+ * @example huffman_code code = huffman_code::from_frequencies(frequencies);
+ *          huffman_encoder(code).encode(text.data(), text.size(), bits);
+ */
+class huffman_code {
+
+    std::vector<uint8_t> m_lengths;
+    std::vector<uint32_t> m_codes;
+    uint32_t m_max_code_length;
+
+    explicit huffman_code(const std::vector<uint8_t>& code_lengths);
+
+    static std::vector<uint8_t> code_lengths_of(const std::vector<uint64_t>& frequencies, uint32_t max_code_length);
+
+public:
+
+    static const uint32_t MAX_CODE_LENGTH = 32;
+    static const uint32_t DEFAULT_MAX_CODE_LENGTH = 15;
+    static const uint32_t MAX_SYMBOLS = 1u << 24;
+
+    static huffman_code from_frequencies(const std::vector<uint64_t>& frequencies,
+                                         uint32_t max_code_length = DEFAULT_MAX_CODE_LENGTH);
+
+    static huffman_code from_code_lengths(const std::vector<uint8_t>& code_lengths);
+
+    template<typename Symbol>
+    static std::vector<uint64_t> count_frequencies(const Symbol* symbols, uint64_t count, uint32_t number_of_symbols);
+
+    uint32_t number_of_symbols() const;
+
+    uint32_t code_length(uint32_t symbol) const;
+
+    uint32_t code(uint32_t symbol) const;
+
+    uint32_t max_code_length() const;
+
+    const std::vector<uint8_t>& code_lengths() const;
+};
+
+
+/**
+ * Build the optimal code of symbols with these @a frequencies whose codes are at most @a max_code_length bits. <br>
+ * Symbols with a frequency of 0 get no code, if a single symbol has a code its length is 1.
+ *
+ * @param frequencies Number of occurrences of every symbol
+ * @param max_code_length Maximum length of a code, between 1 and 32, longer codes are shortened as in JPEG (K.3)
+ * @throw std::length_error if max_code_length is not between 1 and 32, if there are more than 2^24 symbols or more
+ *        symbols with a frequency than 2^max_code_length
+ */
+inline huffman_code huffman_code::from_frequencies(const std::vector<uint64_t>& frequencies, uint32_t max_code_length) {
+    if (max_code_length == 0 || max_code_length > MAX_CODE_LENGTH) {
+        throw std::length_error("max_code_length Must be between 1 and " + std::to_string(MAX_CODE_LENGTH));
+    }
+    if (frequencies.size() > MAX_SYMBOLS) {
+        throw std::length_error("huffman_code supports at most " + std::to_string(MAX_SYMBOLS) + " symbols");
+    }
+    return huffman_code(code_lengths_of(frequencies, max_code_length));
+}
+
+/**
+ * Rebuild a canonical code from the code length of every symbol, 0 for symbols without a code
+ *
+ * @throw std::length_error if a length is greater than 32 or if there are more than 2^24 symbols
+ * @throw std::logic_error if the lengths are not of a prefix code (more codes than the lengths allow)
+ */
+inline huffman_code huffman_code::from_code_lengths(const std::vector<uint8_t>& code_lengths) {
+    if (code_lengths.size() > MAX_SYMBOLS) {
+        throw std::length_error("huffman_code supports at most " + std::to_string(MAX_SYMBOLS) + " symbols");
+    }
+    return huffman_code(code_lengths);
+}
+
+/**
+ * @return The number of occurrences of every symbol of @a symbols
+ * @throw std::out_of_range if a symbol is not less than @a number_of_symbols
+ */
+template<typename Symbol>
+std::vector<uint64_t> huffman_code::count_frequencies(const Symbol* symbols, uint64_t count,
+                                                      uint32_t number_of_symbols) {
+    std::vector<uint64_t> frequencies(number_of_symbols);
+    for (uint64_t i = 0; i < count; ++i) {
+        if (uint64_t(symbols[i]) >= number_of_symbols) {
+            throw std::out_of_range("symbol " + std::to_string(uint64_t(symbols[i])) +
+                                    " is out of range of an alphabet of size " + std::to_string(number_of_symbols));
+        }
+        frequencies[symbols[i]]++;
+    }
+    return frequencies;
+}
+
+/**
+ * Assign the canonical codes of @a code_lengths
+ */
+inline huffman_code::huffman_code(const std::vector<uint8_t>& code_lengths)
+        : m_lengths(code_lengths), m_codes(code_lengths.size()), m_max_code_length(0) {
+    std::vector<uint64_t> count_of_length(MAX_CODE_LENGTH + 1);
+    for (uint8_t length : m_lengths) {
+        if (length > MAX_CODE_LENGTH) {
+            throw std::length_error("code length Must be between 0 and " + std::to_string(MAX_CODE_LENGTH));
+        }
+        count_of_length[length]++;
+        m_max_code_length = std::max<uint32_t>(m_max_code_length, length);
+    }
+    count_of_length[0] = 0;
+
+    // First code of every length, the codes of a length follow the ones of the previous length shifted left
+    std::vector<uint64_t> next_code(MAX_CODE_LENGTH + 1);
+    uint64_t code = 0;
+    for (uint32_t length = 1; length <= MAX_CODE_LENGTH; ++length) {
+        code = (code + count_of_length[length - 1]) << 1;
+        next_code[length] = code;
+        if (code + count_of_length[length] > (uint64_t(1) << length)) {
+            throw std::logic_error("code lengths are not of a prefix code, there are too many codes of length " +
+                                   std::to_string(length));
+        }
+    }
+
+    for (uint32_t symbol = 0; symbol < m_lengths.size(); ++symbol) {
+        if (m_lengths[symbol]) {
+            m_codes[symbol] = uint32_t(next_code[m_lengths[symbol]]++);
+        }
+    }
+}
+
+/**
+ * Huffman code lengths by merging the two least frequent nodes of two sorted queues (leaves and merged nodes), then
+ * limited to @a max_code_length by moving pairs of the longest codes under shorter ones.
+ */
+inline std::vector<uint8_t> huffman_code::code_lengths_of(const std::vector<uint64_t>& frequencies,
+                                                          uint32_t max_code_length) {
+    std::vector<uint8_t> lengths(frequencies.size());
+
+    // Used symbols, least frequent first
+    std::vector<uint32_t> symbols;
+    for (uint32_t symbol = 0; symbol < frequencies.size(); ++symbol) {
+        if (frequencies[symbol])
+            symbols.push_back(symbol);
+    }
+    if (symbols.empty())
+        return lengths;
+    if (symbols.size() == 1) {
+        lengths[symbols[0]] = 1;
+        return lengths;
+    }
+    if (max_code_length < 32 && symbols.size() > (uint64_t(1) << max_code_length)) {
+        throw std::length_error(std::to_string(symbols.size()) + " symbols do not fit in codes of " +
+                                std::to_string(max_code_length) + " bits");
+    }
+    std::stable_sort(symbols.begin(), symbols.end(), [&](uint32_t a, uint32_t b) {
+        return frequencies[a] < frequencies[b];
+    });
+
+    // Nodes 0 to n - 1 are the leaves in the order of symbols, the merged nodes follow in increasing weight
+    const uint32_t n = uint32_t(symbols.size());
+    std::vector<uint64_t> weight(2 * n - 1);
+    std::vector<uint32_t> parent(2 * n - 1);
+    for (uint32_t i = 0; i < n; ++i) {
+        weight[i] = frequencies[symbols[i]];
+    }
+    uint32_t leaf = 0, merged = n;
+    for (uint32_t node = n; node < 2 * n - 1; ++node) {
+        uint32_t children[2];
+        for (uint32_t& child : children) {
+            child = leaf < n && (merged == node || weight[leaf] <= weight[merged]) ? leaf++ : merged++;
+            parent[child] = node;
+        }
+        weight[node] = weight[children[0]] + weight[children[1]];
+    }
+
+    // Depth of every node from the root (the last node), then the number of leaves of every length
+    std::vector<uint32_t> depth(2 * n - 1);
+    std::vector<uint64_t> count_of_length(2 * n);
+    uint32_t longest = 0;
+    for (uint32_t node = 2 * n - 2; node-- > 0;) {
+        depth[node] = depth[parent[node]] + 1;
+        if (node < n) {
+            count_of_length[depth[node]]++;
+            longest = std::max(longest, depth[node]);
+        }
+    }
+
+    // Every pair of leaves of the longest length is replaced by a leaf one bit shorter, which makes room by
+    // becoming the sibling of a leaf of a shorter length that moves one level down
+    for (uint32_t length = longest; length > max_code_length; --length) {
+        while (count_of_length[length] > 0) {
+            uint32_t shorter = length - 2;
+            while (count_of_length[shorter] == 0) {
+                shorter--;
+            }
+            count_of_length[length] -= 2;
+            count_of_length[length - 1]++;
+            count_of_length[shorter + 1] += 2;
+            count_of_length[shorter]--;
+        }
+    }
+
+    // The most frequent symbols get the shortest codes
+    uint32_t length = 1;
+    for (uint32_t i = n; i-- > 0;) {
+        while (count_of_length[length] == 0) {
+            length++;
+        }
+        count_of_length[length]--;
+        lengths[symbols[i]] = uint8_t(length);
+    }
+    return lengths;
+}
+
+/**
+ * @return Size of the alphabet
+ */
+inline uint32_t huffman_code::number_of_symbols() const {
+    return uint32_t(m_lengths.size());
+}
+
+/**
+ * @return Length of the code of @a symbol, 0 if it has no code
+ * @throw std::out_of_range if symbol is not less than number_of_symbols()
+ */
+inline uint32_t huffman_code::code_length(uint32_t symbol) const {
+    return m_lengths.at(symbol);
+}
+
+/**
+ * @return The code of @a symbol as an integer of code_length(symbol) bits, its most significant bit is the first bit
+ * @throw std::out_of_range if symbol is not less than number_of_symbols()
+ */
+inline uint32_t huffman_code::code(uint32_t symbol) const {
+    return m_codes.at(symbol);
+}
+
+/**
+ * @return Length of the longest code
+ */
+inline uint32_t huffman_code::max_code_length() const {
+    return m_max_code_length;
+}
+
+/**
+ * @return Code length of every symbol, enough to rebuild the code with from_code_lengths()
+ */
+inline const std::vector<uint8_t>& huffman_code::code_lengths() const {
+    return m_lengths;
+}
+
+
+/*====================================================================================================================*/
+/*--------------------------------------------------- Encoder --------------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * Encodes symbols with a huffman_code into a %basic_bit_string, through a 64-bit accumulator (basic_bit_writer) so
+ * a symbol costs a table lookup and a few shifts.
+ */
+template<typename BitOrder>
+class basic_huffman_encoder {
+
+    // Per symbol: the code as a field of BitOrder in the high bits, its length in the low 8 bits (0 if no code)
+    std::vector<uint64_t> m_table;
+
+    static const uint32_t LENGTH_BITS = 8;
+
+public:
+
+    explicit basic_huffman_encoder(const huffman_code& code);
+
+    template<typename Symbol>
+    void encode(const Symbol* symbols, uint64_t count, basic_bit_string<BitOrder>& bits) const;
+
+    template<typename Symbol>
+    uint64_t encoded_size(const Symbol* symbols, uint64_t count) const;
+};
+
+typedef basic_huffman_encoder<msb_first> huffman_encoder;
+typedef basic_huffman_encoder<lsb_first> lsb_huffman_encoder;
+
+
+template<typename BitOrder>
+basic_huffman_encoder<BitOrder>::basic_huffman_encoder(const huffman_code& code) : m_table(code.number_of_symbols()) {
+    for (uint32_t symbol = 0; symbol < code.number_of_symbols(); ++symbol) {
+        const uint32_t length = code.code_length(symbol);
+        if (length == 0)
+            continue;
+
+        // The code first bit first, as a field of BitOrder
+        uint64_t word = 0;
+        for (uint32_t i = 0; i < length; ++i) {
+            if ((code.code(symbol) >> (length - 1 - i)) & 1u)
+                word |= BitOrder::delay(BitOrder::head_mask_64(1), i);
+        }
+        m_table[symbol] = (BitOrder::to_value(word, length) << LENGTH_BITS) | length;
+    }
+}
+
+/**
+ * Append the codes of @a count @a symbols to @a bits
+ *
+ * @throw std::out_of_range if a symbol has no code or is not less than the number of symbols of the code, the codes
+ *        of the symbols before it are appended
+ */
+template<typename BitOrder>
+template<typename Symbol>
+void basic_huffman_encoder<BitOrder>::encode(const Symbol* symbols, uint64_t count,
+                                             basic_bit_string<BitOrder>& bits) const {
+    basic_bit_writer<BitOrder> writer(bits);
+    for (uint64_t i = 0; i < count; ++i) {
+        const uint64_t symbol = uint64_t(symbols[i]);
+        const uint64_t entry = symbol < m_table.size() ? m_table[symbol] : 0;
+        if (entry == 0) {
+            throw std::out_of_range("symbol " + std::to_string(symbol) + " has no huffman code");
+        }
+        writer.write_bits(entry >> LENGTH_BITS, uint32_t(entry & 0xFF));
+    }
+    writer.flush();
+}
+
+/**
+ * @return Size in bits of the codes of @a count @a symbols
+ * @throw std::out_of_range if a symbol has no code or is not less than the number of symbols of the code
+ */
+template<typename BitOrder>
+template<typename Symbol>
+uint64_t basic_huffman_encoder<BitOrder>::encoded_size(const Symbol* symbols, uint64_t count) const {
+    uint64_t size = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        const uint64_t symbol = uint64_t(symbols[i]);
+        const uint32_t length = symbol < m_table.size() ? uint32_t(m_table[symbol] & 0xFF) : 0;
+        if (length == 0) {
+            throw std::out_of_range("symbol " + std::to_string(symbol) + " has no huffman code");
+        }
+        size += length;
+    }
+    return size;
+}
+
+
+/*====================================================================================================================*/
+/*--------------------------------------------------- Decoder --------------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * Decodes symbols of a huffman_code from a basic_bit_reader with multi-level lookup tables. <br>
+ * The root table is indexed by the next 11 bits of the stream and resolves all the codes of up to 11 bits in one
+ * probe. Longer codes link to a sub table indexed by the following bits (at most 11 more), so codes of up to 22 bits
+ * take two probes.
+ */
+template<typename BitOrder>
+class basic_huffman_decoder {
+
+    // An entry is either a symbol: (symbol << 8) | code length, or a link: (offset << 8) | LINK | bits of the sub
+    // table. 0 is an invalid code. The entries are 64 bits as the offsets of 2^24 symbols need more than 24 bits
+    std::vector<uint64_t> m_table;
+    uint32_t m_root_bits;
+
+    static const uint32_t LINK = 0x80;
+    static const uint32_t ENTRY_BITS = 8;
+
+    void build_table(const huffman_code& code, const std::vector<uint64_t>& words, const std::vector<uint32_t>& symbols,
+                     uint32_t depth, uint32_t offset, uint32_t table_bits);
+
+public:
+
+    static const uint32_t TABLE_BITS = 11;
+
+    explicit basic_huffman_decoder(const huffman_code& code);
+
+    uint32_t decode(uint64_t window, uint32_t available, uint64_t& symbol) const;
+
+    uint32_t read(basic_bit_reader<BitOrder>& reader) const;
+
+    template<typename Symbol>
+    void read(basic_bit_reader<BitOrder>& reader, Symbol* symbols, uint64_t count) const;
+};
+
+typedef basic_huffman_decoder<msb_first> huffman_decoder;
+typedef basic_huffman_decoder<lsb_first> lsb_huffman_decoder;
+
+
+template<typename BitOrder>
+basic_huffman_decoder<BitOrder>::basic_huffman_decoder(const huffman_code& code)
+        : m_root_bits(code.max_code_length() < TABLE_BITS ? code.max_code_length() : TABLE_BITS) {
+    if (m_root_bits == 0)
+        m_root_bits = 1;
+
+    // Every code as a word of BitOrder, first bit at the start of the word
+    std::vector<uint64_t> words(code.number_of_symbols());
+    std::vector<uint32_t> symbols;
+    for (uint32_t symbol = 0; symbol < code.number_of_symbols(); ++symbol) {
+        const uint32_t length = code.code_length(symbol);
+        if (length == 0)
+            continue;
+        for (uint32_t i = 0; i < length; ++i) {
+            if ((code.code(symbol) >> (length - 1 - i)) & 1u)
+                words[symbol] |= BitOrder::delay(BitOrder::head_mask_64(1), i);
+        }
+        symbols.push_back(symbol);
+    }
+
+    m_table.resize(uint32_t(1) << m_root_bits);
+    build_table(code, words, symbols, 0, 0, m_root_bits);
+}
+
+/**
+ * Fill the table of 2^table_bits entries at @a offset with @a symbols, whose codes start with the same @a depth bits
+ */
+template<typename BitOrder>
+void basic_huffman_decoder<BitOrder>::build_table(const huffman_code& code, const std::vector<uint64_t>& words,
+                                                  const std::vector<uint32_t>& symbols, uint32_t depth,
+                                                  uint32_t offset, uint32_t table_bits) {
+    typedef code_fields<BitOrder> fields;
+
+    // Codes longer than the table, grouped by their index in the table
+    std::vector<std::vector<uint32_t>> longer(uint32_t(1) << table_bits);
+
+    for (uint32_t symbol : symbols) {
+        const uint32_t length = code.code_length(symbol);
+        if (length - depth > table_bits) {
+            longer[fields::field(words[symbol], depth, table_bits)].push_back(symbol);
+            continue;
+        }
+
+        // All the indices starting with the rest of the code
+        const uint32_t rest = length - depth;
+        const uint64_t prefix = fields::field(words[symbol], depth, rest);
+        const uint64_t entry = (uint64_t(symbol) << ENTRY_BITS) | length;
+        for (uint64_t suffix = 0; suffix < (uint64_t(1) << (table_bits - rest)); ++suffix) {
+            m_table[offset + fields::join(prefix, rest, suffix, table_bits - rest)] = entry;
+        }
+    }
+
+    for (uint32_t index = 0; index < longer.size(); ++index) {
+        if (longer[index].empty())
+            continue;
+        uint32_t longest = 0;
+        for (uint32_t symbol : longer[index]) {
+            longest = std::max(longest, code.code_length(symbol));
+        }
+        const uint32_t sub_bits = longest - depth - table_bits < TABLE_BITS ? longest - depth - table_bits : TABLE_BITS;
+        const uint32_t sub_offset = uint32_t(m_table.size());
+        m_table.resize(m_table.size() + (uint32_t(1) << sub_bits));
+        m_table[offset + index] = (uint64_t(sub_offset) << ENTRY_BITS) | LINK | sub_bits;
+        build_table(code, words, longer[index], depth + table_bits, sub_offset, sub_bits);
+    }
+}
+
+/**
+ * Decode a symbol from the first @a available bits of @a window (a word of BitOrder, bits after them are ignored)
+ *
+ * @return Length of the code, or 0 if it is longer than @a available or invalid
+ */
+template<typename BitOrder>
+uint32_t basic_huffman_decoder<BitOrder>::decode(uint64_t window, uint32_t available, uint64_t& symbol) const {
+    uint64_t entry = m_table[BitOrder::to_value(window, m_root_bits)];
+    uint32_t depth = m_root_bits;
+    while (entry & LINK) {
+        const uint32_t bits = uint32_t(entry & (LINK - 1));
+        entry = m_table[(entry >> ENTRY_BITS) + code_fields<BitOrder>::field(window, depth, bits)];
+        depth += bits;
+    }
+
+    const uint32_t length = uint32_t(entry & (LINK - 1));
+    if (length > available)
+        return 0;
+    symbol = entry >> ENTRY_BITS;
+    return length;
+}
+
+/**
+ * Read the next symbol
+ *
+ * @throw std::out_of_range if the stream ends in the middle of a code
+ * @throw std::logic_error if the next bits are not a code
+ */
+template<typename BitOrder>
+uint32_t basic_huffman_decoder<BitOrder>::read(basic_bit_reader<BitOrder>& reader) const {
+    uint64_t symbol;
+    const uint32_t length = decode(reader.peek(), code_word::WORD_BITS, symbol);
+    if (length == 0) {
+        throw std::logic_error("invalid huffman code at position " + std::to_string(reader.position()));
+    }
+    reader.skip(length);
+    return uint32_t(symbol);
+}
+
+/**
+ * Read the next @a count symbols into @a symbols. <br>
+ * The bit buffer is refilled as in basic_bit_reader::decode_buffered(), to at least 56 bits, then the codes found in
+ * the root table are decoded one after the other from the buffer (5 codes of at most 11 bits per refill), which keeps
+ * the refill out of the dependency chain of the codes. A longer code is decoded through its sub tables right after a
+ * refill, and the last 8 bytes of the stream are read with read().
+ *
+ * @throw std::out_of_range if the stream ends before @a count codes
+ * @throw std::logic_error if the stream contains an invalid code
+ */
+template<typename BitOrder>
+template<typename Symbol>
+void basic_huffman_decoder<BitOrder>::read(basic_bit_reader<BitOrder>& reader, Symbol* symbols, uint64_t count) const {
+    const uint32_t BYTE = 8;
+    const uint32_t WORD_BITS = code_word::WORD_BITS;
+    const uint32_t root_codes = (WORD_BITS - BYTE) / m_root_bits;
+    const uint8_t* data = reader.bits().data();
+    const uint8_t* end = data + reader.bits().size_in_bytes();
+
+    // The buffer holds the bits [next * 8 - available, next * 8) of the stream in its first available bits
+    const uint8_t* next = data + reader.position() / BYTE;
+    uint64_t buffer = 0;
+    uint32_t available = 0;
+    uint32_t skipped = reader.position() % BYTE;
+
+    uint64_t i = 0;
+    while (i < count && next + sizeof(uint64_t) <= end) {
+        buffer |= BitOrder::delay(BitOrder::load_64(next), available);
+        next += (WORD_BITS - 1 - available) / BYTE;
+        available |= WORD_BITS - BYTE;
+        buffer = BitOrder::skip(buffer, skipped);
+        available -= skipped;
+        skipped = 0;
+
+        uint64_t entry = m_table[BitOrder::to_value(buffer, m_root_bits)];
+        if (entry & LINK || entry == 0) {
+            // At least 49 bits are available, more than the longest code
+            uint64_t symbol;
+            const uint32_t length = decode(buffer, available, symbol);
+            if (length == 0)
+                break;
+            symbols[i++] = Symbol(symbol);
+            buffer = BitOrder::skip(buffer, length);
+            available -= length;
+            continue;
+        }
+
+        for (uint32_t k = 0; k < root_codes && i < count && !(entry & LINK) && entry; ++k) {
+            const uint32_t length = uint32_t(entry & (LINK - 1));
+            symbols[i++] = Symbol(entry >> ENTRY_BITS);
+            buffer = BitOrder::skip(buffer, length);
+            available -= length;
+            entry = m_table[BitOrder::to_value(buffer, m_root_bits)];
+        }
+    }
+    reader.seek(uint32_t((next - data) * BYTE - available + skipped));
+
+    for (; i < count; ++i) {
+        symbols[i] = Symbol(read(reader));
+    }
+}
+
+#endif //HUFFMAN_CODE_H
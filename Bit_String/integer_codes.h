@@ -0,0 +1,547 @@
+#ifndef INTEGER_CODES_H
+#define INTEGER_CODES_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "bit_string.h"
+#include "bit_reader.h"
+
+/**
+ * Universal codes of unsigned integers: unary, Elias gamma, Elias delta, Rice (Golomb with a power of 2 divisor) and
+ * LEB128. <br>
+ * Every code is a small object with the same members:
+ *  - append(bits, value) appends the code of @a value to a %basic_bit_string with a single masked word write when
+ *    it fits in 64 bits, the length of the unary prefix comes from a count of leading zeros
+ *  - length(value) is the size of the code in bits
+ *  - read(reader) decodes the next value from a basic_bit_reader
+ *  - decode(window, available, value) decodes a code from the first @a available bits of a 64-bit window of the
+ *    stream and returns its length, or 0 if the code is not complete in the window
+ *
+ * append_codes() and read_codes() encode and decode arrays, read_codes() decodes from the bit buffer of
+ * basic_bit_reader::decode_buffered() instead of a basic_bit_reader call per code.
+ *
+ * The fields of a code are appended as with append_uint_64(), so with msb_first the codes are the textbook ones,
+ * i.e. the Elias gamma code of 9 is [000 1001]. With lsb_first the fields are stored least significant bit first.
+ *
+ * @example elias_gamma_code gamma;
+ *          gamma.append(bits, 9);
+ *          bit_reader reader(bits);
+ *          uint64_t value = gamma.read(reader);
+ */
+
+
+/**
+ * Word size and bit lengths shared by the codes
+ */
+struct code_word {
+
+    static const uint32_t WORD_BITS = 64;
+
+    /**
+     * @return floor(log2(value)), @a value must not be 0
+     */
+    static uint32_t log2(uint64_t value) {
+        return WORD_BITS - 1 - scalar_kernels::leading_zeros_64(value);
+    }
+};
+
+
+/**
+ * Fields of the codes as integers of @a BitOrder, to be appended with append_uint_64() and read from a window
+ */
+template<typename BitOrder>
+struct code_fields : code_word {
+
+    /**
+     * @return Field of (@a zeros + 1) bits made of @a zeros zeros then a one, @a zeros is at most 63
+     */
+    static uint64_t unary(uint32_t zeros) {
+        return BitOrder::to_value(BitOrder::delay(BitOrder::head_mask_64(1), zeros), zeros + 1);
+    }
+
+    /**
+     * @return Field of (@a first_bits + @a second_bits) bits, at most 64, made of the field @a first then @a second
+     */
+    static uint64_t join(uint64_t first, uint32_t first_bits, uint64_t second, uint32_t second_bits) {
+        if (second_bits == 0)
+            return first;
+        if (first_bits == 0)
+            return second;
+        const uint64_t word = BitOrder::from_value(first, first_bits) |
+                              BitOrder::delay(BitOrder::from_value(second, second_bits), first_bits);
+        return BitOrder::to_value(word, first_bits + second_bits);
+    }
+
+    /**
+     * @return Field of @a number_of_bits starting at bit @a start of @a window, start + number_of_bits is at most 64
+     */
+    static uint64_t field(uint64_t window, uint32_t start, uint32_t number_of_bits) {
+        return number_of_bits ? BitOrder::to_value(BitOrder::skip(window, start), number_of_bits) : 0;
+    }
+};
+
+
+/*====================================================================================================================*/
+/*--------------------------------------------------- Unary Code -----------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * @a value zeros followed by a one, i.e. 3 is [0001]
+ */
+struct unary_code {
+
+    template<typename BitOrder>
+    void append(basic_bit_string<BitOrder>& bits, uint64_t value) const;
+
+    uint64_t length(uint64_t value) const;
+
+    template<typename BitOrder>
+    uint32_t decode(uint64_t window, uint32_t available, uint64_t& value) const;
+
+    template<typename BitOrder>
+    uint64_t read(basic_bit_reader<BitOrder>& reader) const;
+};
+
+
+template<typename BitOrder>
+void unary_code::append(basic_bit_string<BitOrder>& bits, uint64_t value) const {
+    const uint32_t word_bits = code_fields<BitOrder>::WORD_BITS;
+    for (; value >= word_bits; value -= word_bits) {
+        bits.append_uint_64(0, word_bits);
+    }
+    bits.append_uint_64(code_fields<BitOrder>::unary(value), value + 1);
+}
+
+inline uint64_t unary_code::length(uint64_t value) const {
+    return value + 1;
+}
+
+template<typename BitOrder>
+uint32_t unary_code::decode(uint64_t window, uint32_t available, uint64_t& value) const {
+    const uint32_t zeros = BitOrder::first_one(window);
+    if (zeros >= available)
+        return 0;
+    value = zeros;
+    return zeros + 1;
+}
+
+/**
+ * @throw std::out_of_range if the code does not end before the end of the stream
+ */
+template<typename BitOrder>
+uint64_t unary_code::read(basic_bit_reader<BitOrder>& reader) const {
+    const uint32_t word_bits = code_fields<BitOrder>::WORD_BITS;
+    uint64_t value = 0;
+    uint64_t window = reader.peek();
+    // Whole words of zeros, skip() throws if the stream ends before the one
+    while (window == 0) {
+        reader.skip(word_bits);
+        value += word_bits;
+        window = reader.peek();
+    }
+    const uint32_t zeros = BitOrder::first_one(window);
+    reader.skip(zeros + 1);
+    return value + zeros;
+}
+
+
+/*====================================================================================================================*/
+/*------------------------------------------------ Elias Gamma Code --------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * For value >= 1 with N = floor(log2(value)): N zeros, a one, then the N low bits of value,
+ * i.e. 9 is [000 1 001], 1 is [1]
+ */
+struct elias_gamma_code {
+
+    template<typename BitOrder>
+    void append(basic_bit_string<BitOrder>& bits, uint64_t value) const;
+
+    uint64_t length(uint64_t value) const;
+
+    template<typename BitOrder>
+    uint32_t decode(uint64_t window, uint32_t available, uint64_t& value) const;
+
+    template<typename BitOrder>
+    uint64_t read(basic_bit_reader<BitOrder>& reader) const;
+};
+
+
+/**
+ * @throw std::domain_error if @a value is 0
+ */
+template<typename BitOrder>
+void elias_gamma_code::append(basic_bit_string<BitOrder>& bits, uint64_t value) const {
+    typedef code_fields<BitOrder> fields;
+    if (value == 0) {
+        throw std::domain_error("Elias gamma code is defined for values greater than 0");
+    }
+
+    const uint32_t n = fields::log2(value);
+    if (2 * n + 1 <= fields::WORD_BITS) {
+        bits.append_uint_64(fields::join(fields::unary(n), n + 1, value, n), 2 * n + 1);
+    } else {
+        bits.append_uint_64(fields::unary(n), n + 1);
+        bits.append_uint_64(value, n);
+    }
+}
+
+inline uint64_t elias_gamma_code::length(uint64_t value) const {
+    return 2 * code_word::log2(value) + 1;
+}
+
+template<typename BitOrder>
+uint32_t elias_gamma_code::decode(uint64_t window, uint32_t available, uint64_t& value) const {
+    typedef code_fields<BitOrder> fields;
+    const uint32_t n = BitOrder::first_one(window);
+    if (2 * n + 1 > available)
+        return 0;
+    value = (uint64_t(1) << n) | fields::field(window, n + 1, n);
+    return 2 * n + 1;
+}
+
+/**
+ * @throw std::out_of_range if the code does not end before the end of the stream
+ * @throw std::length_error if the value does not fit in 64 bits
+ */
+template<typename BitOrder>
+uint64_t elias_gamma_code::read(basic_bit_reader<BitOrder>& reader) const {
+    uint64_t value;
+    const uint32_t length = decode<BitOrder>(reader.peek(), code_fields<BitOrder>::WORD_BITS, value);
+    if (length) {
+        reader.skip(length);
+        return value;
+    }
+
+    // The code is longer than 64 bits
+    const uint64_t n = unary_code().read(reader);
+    if (n >= code_fields<BitOrder>::WORD_BITS) {
+        throw std::length_error("Elias gamma code of " + std::to_string(2 * n + 1) + " bits exceeds 64 bit values");
+    }
+    return (uint64_t(1) << n) | reader.read_bits(uint32_t(n));
+}
+
+
+/*====================================================================================================================*/
+/*------------------------------------------------ Elias Delta Code --------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * For value >= 1 with N = floor(log2(value)): the Elias gamma code of N + 1, then the N low bits of value,
+ * i.e. 9 is [00 1 00 001], 1 is [1]
+ */
+struct elias_delta_code {
+
+    template<typename BitOrder>
+    void append(basic_bit_string<BitOrder>& bits, uint64_t value) const;
+
+    uint64_t length(uint64_t value) const;
+
+    template<typename BitOrder>
+    uint32_t decode(uint64_t window, uint32_t available, uint64_t& value) const;
+
+    template<typename BitOrder>
+    uint64_t read(basic_bit_reader<BitOrder>& reader) const;
+};
+
+
+/**
+ * @throw std::domain_error if @a value is 0
+ */
+template<typename BitOrder>
+void elias_delta_code::append(basic_bit_string<BitOrder>& bits, uint64_t value) const {
+    typedef code_fields<BitOrder> fields;
+    if (value == 0) {
+        throw std::domain_error("Elias delta code is defined for values greater than 0");
+    }
+
+    const uint32_t n = fields::log2(value);
+    const uint32_t l = fields::log2(n + 1);
+    const uint32_t gamma_bits = 2 * l + 1;
+    const uint64_t gamma = fields::join(fields::unary(l), l + 1, n + 1, l);
+    if (gamma_bits + n <= fields::WORD_BITS) {
+        bits.append_uint_64(fields::join(gamma, gamma_bits, value, n), gamma_bits + n);
+    } else {
+        bits.append_uint_64(gamma, gamma_bits);
+        bits.append_uint_64(value, n);
+    }
+}
+
+inline uint64_t elias_delta_code::length(uint64_t value) const {
+    typedef code_word fields;
+    const uint32_t n = fields::log2(value);
+    return 2 * fields::log2(n + 1) + 1 + n;
+}
+
+template<typename BitOrder>
+uint32_t elias_delta_code::decode(uint64_t window, uint32_t available, uint64_t& value) const {
+    typedef code_fields<BitOrder> fields;
+    const uint32_t l = BitOrder::first_one(window);
+    const uint32_t gamma_bits = 2 * l + 1;
+    if (gamma_bits > available)
+        return 0;
+    const uint64_t n = ((uint64_t(1) << l) | fields::field(window, l + 1, l)) - 1;
+    if (gamma_bits + n > available)
+        return 0;
+    value = (uint64_t(1) << n) | fields::field(window, gamma_bits, uint32_t(n));
+    return gamma_bits + uint32_t(n);
+}
+
+/**
+ * @throw std::out_of_range if the code does not end before the end of the stream
+ * @throw std::length_error if the value does not fit in 64 bits
+ */
+template<typename BitOrder>
+uint64_t elias_delta_code::read(basic_bit_reader<BitOrder>& reader) const {
+    uint64_t value;
+    const uint32_t length = decode<BitOrder>(reader.peek(), code_fields<BitOrder>::WORD_BITS, value);
+    if (length) {
+        reader.skip(length);
+        return value;
+    }
+
+    // The code is longer than 64 bits
+    const uint64_t n = elias_gamma_code().read(reader) - 1;
+    if (n >= code_fields<BitOrder>::WORD_BITS) {
+        throw std::length_error("Elias delta code of a " + std::to_string(n + 1) + " bit value exceeds 64 bit values");
+    }
+    return (uint64_t(1) << n) | reader.read_bits(uint32_t(n));
+}
+
+
+/*====================================================================================================================*/
+/*---------------------------------------------------- Rice Code -----------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * Golomb code with a divisor of 2^k: the quotient value >> k in unary, then the k low bits of value,
+ * i.e. with k = 2, 9 is [001 01]
+ */
+class rice_code {
+
+    uint32_t m_k;
+
+public:
+
+    explicit rice_code(uint32_t k);
+
+    uint32_t k() const;
+
+    template<typename BitOrder>
+    void append(basic_bit_string<BitOrder>& bits, uint64_t value) const;
+
+    uint64_t length(uint64_t value) const;
+
+    template<typename BitOrder>
+    uint32_t decode(uint64_t window, uint32_t available, uint64_t& value) const;
+
+    template<typename BitOrder>
+    uint64_t read(basic_bit_reader<BitOrder>& reader) const;
+};
+
+
+/**
+ * @param k Number of low bits stored in binary, between 0 and 63
+ * @throw std::length_error if k is greater than 63
+ */
+inline rice_code::rice_code(uint32_t k) : m_k(k) {
+    if (k >= code_word::WORD_BITS) {
+        throw std::length_error("k Must be between 0 and " + std::to_string(code_word::WORD_BITS - 1));
+    }
+}
+
+inline uint32_t rice_code::k() const {
+    return m_k;
+}
+
+template<typename BitOrder>
+void rice_code::append(basic_bit_string<BitOrder>& bits, uint64_t value) const {
+    typedef code_fields<BitOrder> fields;
+    const uint64_t quotient = value >> m_k;
+    if (quotient + 1 + m_k <= fields::WORD_BITS) {
+        const uint32_t zeros = uint32_t(quotient);
+        bits.append_uint_64(fields::join(fields::unary(zeros), zeros + 1, value, m_k), zeros + 1 + m_k);
+    } else {
+        unary_code().append(bits, quotient);
+        bits.append_uint_64(value, m_k);
+    }
+}
+
+inline uint64_t rice_code::length(uint64_t value) const {
+    return (value >> m_k) + 1 + m_k;
+}
+
+template<typename BitOrder>
+uint32_t rice_code::decode(uint64_t window, uint32_t available, uint64_t& value) const {
+    typedef code_fields<BitOrder> fields;
+    const uint32_t zeros = BitOrder::first_one(window);
+    if (zeros + 1 + m_k > available)
+        return 0;
+    value = (uint64_t(zeros) << m_k) | fields::field(window, zeros + 1, m_k);
+    return zeros + 1 + m_k;
+}
+
+/**
+ * @throw std::out_of_range if the code does not end before the end of the stream
+ */
+template<typename BitOrder>
+uint64_t rice_code::read(basic_bit_reader<BitOrder>& reader) const {
+    uint64_t value;
+    const uint32_t length = decode<BitOrder>(reader.peek(), code_fields<BitOrder>::WORD_BITS, value);
+    if (length) {
+        reader.skip(length);
+        return value;
+    }
+
+    // The quotient is too long for a single window
+    const uint64_t quotient = unary_code().read(reader);
+    return (quotient << m_k) | reader.read_bits(m_k);
+}
+
+
+/*====================================================================================================================*/
+/*--------------------------------------------------- LEB128 Code ----------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * Unsigned LEB128 (varint): groups of 7 bits from the least significant one, one per byte with the most significant
+ * bit of the byte set on all but the last byte, i.e. 300 is [1010 1100  0000 0010]. <br>
+ * Every byte is appended as append_uint_64(byte, 8), so a byte aligned code in bit_string::data() is the standard
+ * byte sequence for both bit orders.
+ */
+struct leb128_code {
+
+    static const uint32_t MAX_BYTES = 10;
+
+    template<typename BitOrder>
+    void append(basic_bit_string<BitOrder>& bits, uint64_t value) const;
+
+    uint64_t length(uint64_t value) const;
+
+    template<typename BitOrder>
+    uint32_t decode(uint64_t window, uint32_t available, uint64_t& value) const;
+
+    template<typename BitOrder>
+    uint64_t read(basic_bit_reader<BitOrder>& reader) const;
+};
+
+
+template<typename BitOrder>
+void leb128_code::append(basic_bit_string<BitOrder>& bits, uint64_t value) const {
+    typedef code_fields<BitOrder> fields;
+    const uint32_t BYTE = 8;
+    const uint32_t bytes_per_word = fields::WORD_BITS / BYTE;
+
+    // Up to 8 bytes per write, only values of more than 56 bits need a second one
+    uint32_t bytes = uint32_t(length(value) / BYTE);
+    while (bytes) {
+        const uint32_t chunk = bytes < bytes_per_word ? bytes : bytes_per_word;
+        uint64_t field = 0;
+        for (uint32_t i = 0; i < chunk; ++i, value >>= 7) {
+            const uint64_t byte = (value & 0x7F) | (i + 1 < bytes ? 0x80 : 0);
+            field = fields::join(field, i * BYTE, byte, BYTE);
+        }
+        bits.append_uint_64(field, chunk * BYTE);
+        bytes -= chunk;
+    }
+}
+
+inline uint64_t leb128_code::length(uint64_t value) const {
+    const uint32_t BYTE = 8;
+    return value ? (code_word::log2(value) / 7 + 1) * BYTE : BYTE;
+}
+
+template<typename BitOrder>
+uint32_t leb128_code::decode(uint64_t window, uint32_t available, uint64_t& value) const {
+    typedef code_fields<BitOrder> fields;
+    const uint32_t BYTE = 8;
+    uint64_t result = 0;
+    for (uint32_t i = 0; (i + 1) * BYTE <= available; ++i) {
+        const uint64_t byte = fields::field(window, i * BYTE, BYTE);
+        result |= (byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80)) {
+            value = result;
+            return (i + 1) * BYTE;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @throw std::out_of_range if the code does not end before the end of the stream
+ * @throw std::length_error if the code is longer than 10 bytes or the value does not fit in 64 bits
+ */
+template<typename BitOrder>
+uint64_t leb128_code::read(basic_bit_reader<BitOrder>& reader) const {
+    const uint32_t BYTE = 8;
+    uint64_t value;
+    const uint32_t length = decode<BitOrder>(reader.peek(), code_fields<BitOrder>::WORD_BITS, value);
+    if (length) {
+        reader.skip(length);
+        return value;
+    }
+
+    // Values of more than 56 bits, a byte at a time
+    value = 0;
+    for (uint32_t i = 0; i < MAX_BYTES; ++i) {
+        const uint64_t byte = reader.read_bits(BYTE);
+        if (i + 1 == MAX_BYTES && byte > 1)
+            break;
+        value |= (byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80))
+            return value;
+    }
+    throw std::length_error("LEB128 code exceeds 64 bit values");
+}
+
+
+/*====================================================================================================================*/
+/*------------------------------------------------- Batched Coding ---------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * Append the codes of @a count @a values to @a bits, reserving the space of all of them first
+ *
+ * @example append_codes(rice_code(4), bits, gaps.data(), gaps.size());
+ */
+template<typename Code, typename BitOrder>
+void append_codes(const Code& code, basic_bit_string<BitOrder>& bits, const uint64_t* values, uint64_t count) {
+    uint64_t total = bits.size();
+    for (uint64_t i = 0; i < count; ++i) {
+        total += code.length(values[i]);
+    }
+    if (total <= UINT32_MAX)
+        bits.reserve(total);
+
+    for (uint64_t i = 0; i < count; ++i) {
+        code.append(bits, values[i]);
+    }
+}
+
+/**
+ * Decode the next @a count values of @a reader into @a values. <br>
+ * The codes are decoded by basic_bit_reader::decode_buffered() from a bit buffer refilled without branches, only
+ * codes longer than the buffer and the last bytes of the stream fall back to Code::read().
+ *
+ * @throw std::out_of_range if the stream ends before @a count codes, and the errors of Code::read()
+ *
+ * @example read_codes(elias_gamma_code(), reader, gaps.data(), gaps.size());
+ */
+template<typename Code, typename BitOrder>
+void read_codes(const Code& code, basic_bit_reader<BitOrder>& reader, uint64_t* values, uint64_t count) {
+    uint64_t i = 0;
+    while (i < count) {
+        uint64_t* first = values + i;
+        i += reader.decode_buffered(count - i, [&](uint64_t buffer, uint32_t available, uint64_t index) {
+            return code.template decode<BitOrder>(buffer, available, first[index]);
+        });
+        if (i < count) {
+            values[i++] = code.read(reader);
+        }
+    }
+}
+
+#endif //INTEGER_CODES_H
@@ -0,0 +1,661 @@
+#ifndef PACKED_INT_VECTOR_H
+#define PACKED_INT_VECTOR_H
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <stdexcept>
+
+#include "bit_string.h"
+
+/**
+ * Array of unsigned integers of a fixed bit width (1 to 64, chosen at runtime) packed back to back in a %bit_string.
+ * <br> Element i occupies bits [i * width, (i + 1) * width) of the storage, most significant bit first, so the
+ * storage is the same as calling bit_string::append_uint_64(value, width) for every element.
+ *
+ * get() and set() are O(1) with a single unaligned load / store, unpack() and pack() convert ranges of elements
+ * from / to plain uint64_t arrays in bulk.
+ *
+ * @example packed_int_vector ids(20);
+ *          ids.push_back(1000000);
+ *          uint64_t id = ids[0];
+ */
+class packed_int_vector {
+
+public:
+
+    /**
+     * Proxy to a single element, similar to bit_reference
+     */
+    class reference {
+
+        packed_int_vector* m_vector;
+        uint32_t m_index;
+
+    public:
+
+        reference(packed_int_vector* vector, uint32_t index) : m_vector(vector), m_index(index) {}
+
+        operator uint64_t() const {
+            return m_vector->get(m_index);
+        }
+
+        reference& operator =(uint64_t value) {
+            m_vector->set(m_index, value);
+            return *this;
+        }
+
+        reference& operator =(const reference& other) {
+            return *this = uint64_t(other);
+        }
+    };
+
+    /**
+     * Random access iterator over the elements, parameterized by the vector and value access (const or not)
+     */
+    template<typename Vector, typename Reference>
+    class iterator_base {
+
+        Vector* m_vector;
+        uint32_t m_index;
+
+    public:
+
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = long long;
+        using value_type = uint64_t;
+        using pointer = void;
+        using reference = Reference;
+
+        iterator_base() : m_vector(nullptr), m_index(0) {}
+
+        iterator_base(Vector* vector, uint32_t index) : m_vector(vector), m_index(index) {}
+
+        Reference operator *() const {
+            return (*m_vector)[m_index];
+        }
+
+        Reference operator [](difference_type diff) const {
+            return (*m_vector)[m_index + diff];
+        }
+
+        iterator_base& operator ++() {
+            m_index++;
+            return *this;
+        }
+
+        iterator_base operator ++(int) {
+            iterator_base temp = *this;
+            m_index++;
+            return temp;
+        }
+
+        iterator_base& operator --() {
+            m_index--;
+            return *this;
+        }
+
+        iterator_base operator --(int) {
+            iterator_base temp = *this;
+            m_index--;
+            return temp;
+        }
+
+        iterator_base& operator +=(difference_type diff) {
+            m_index += diff;
+            return *this;
+        }
+
+        iterator_base& operator -=(difference_type diff) {
+            m_index -= diff;
+            return *this;
+        }
+
+        iterator_base operator +(difference_type diff) const {
+            iterator_base temp = *this;
+            return temp += diff;
+        }
+
+        iterator_base operator -(difference_type diff) const {
+            iterator_base temp = *this;
+            return temp -= diff;
+        }
+
+        difference_type operator -(const iterator_base& rhs) const {
+            return difference_type(m_index) - difference_type(rhs.m_index);
+        }
+
+        bool operator ==(const iterator_base& rhs) const {
+            return m_vector == rhs.m_vector && m_index == rhs.m_index;
+        }
+
+        bool operator !=(const iterator_base& rhs) const {
+            return !(rhs == *this);
+        }
+
+        bool operator <(const iterator_base& rhs) const {
+            return m_index < rhs.m_index;
+        }
+
+        bool operator >(const iterator_base& rhs) const {
+            return rhs < *this;
+        }
+
+        bool operator <=(const iterator_base& rhs) const {
+            return !(rhs < *this);
+        }
+
+        bool operator >=(const iterator_base& rhs) const {
+            return !(*this < rhs);
+        }
+    };
+
+    typedef iterator_base<packed_int_vector, reference>           iterator;
+    typedef iterator_base<const packed_int_vector, uint64_t>      const_iterator;
+
+    static const uint32_t MAX_WIDTH = sizeof(uint64_t) * bit_string::BYTE;
+
+private:
+
+    bit_string m_bits;
+    uint32_t m_width;
+
+public:
+
+/*------------------------------------------ Constructors , Factory methods ------------------------------------------*/
+
+    explicit packed_int_vector(uint32_t width);
+
+    packed_int_vector(uint32_t width, uint32_t number_of_elements, uint64_t value = 0);
+
+/*---------------------------------------------------- Insertions ----------------------------------------------------*/
+
+    void push_back(uint64_t value);
+
+    void pop_back();
+
+    void append(const uint64_t* values, uint32_t number_of_elements);
+
+/*--------------------------------------------------- Data Access ---------------------------------------------------*/
+
+    uint64_t get(uint32_t index) const;
+
+    void set(uint32_t index, uint64_t value);
+
+    uint64_t at(uint32_t index) const;
+
+    reference at(uint32_t index);
+
+    uint64_t operator [](uint32_t index) const;
+
+    reference operator [](uint32_t index);
+
+    uint64_t front() const;
+
+    uint64_t back() const;
+
+    void unpack(uint32_t first, uint32_t number_of_elements, uint64_t* out) const;
+
+    void pack(uint32_t first, uint32_t number_of_elements, const uint64_t* values);
+
+    const bit_string& bits() const;
+
+/*---------------------------------------------------- Iterators ----------------------------------------------------*/
+
+    iterator begin();
+
+    const_iterator begin() const;
+
+    iterator end();
+
+    const_iterator end() const;
+
+    const_iterator cbegin() const;
+
+    const_iterator cend() const;
+
+/*------------------------------------------------------ Other ------------------------------------------------------*/
+
+    bool operator ==(const packed_int_vector& other) const;
+
+    bool operator !=(const packed_int_vector& other) const;
+
+    void resize(uint32_t number_of_elements, uint64_t value = 0);
+
+    void reserve(uint32_t number_of_elements);
+
+    void clear();
+
+    bool empty() const;
+
+    uint32_t size() const;
+
+    uint32_t capacity() const;
+
+    uint32_t width() const;
+
+    uint64_t max_value() const;
+
+private:
+
+    static uint64_t load_field(const uint8_t* data, uint64_t position, uint32_t right_shift);
+
+    bool is_word_accessible(uint64_t position) const;
+
+    void check_index(uint32_t index) const;
+
+    void check_range(uint32_t first, uint32_t number_of_elements) const;
+};
+
+inline void swap(packed_int_vector::reference x, packed_int_vector::reference y) {
+    uint64_t temp = x;
+    x = y;
+    y = temp;
+}
+
+inline void swap(packed_int_vector::reference x, uint64_t& y) {
+    uint64_t temp = x;
+    x = y;
+    y = temp;
+}
+
+inline void swap(uint64_t& x, packed_int_vector::reference y) {
+    uint64_t temp = x;
+    x = y;
+    y = temp;
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------ Constructors , Factory methods ------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * Constructs an empty %packed_int_vector of elements of @a width bits
+ *
+ * @param width Number of bits of every element, between 1 and 64
+ * @throw std::length_error if @a width is not between 1 and 64
+ */
+inline packed_int_vector::packed_int_vector(uint32_t width) : m_width(width) {
+    if (width == 0 || width > MAX_WIDTH) {
+        throw std::length_error("width Must be between 1 and " + std::to_string(MAX_WIDTH));
+    }
+}
+
+
+/**
+ * Constructs %packed_int_vector contains @a number_of_elements elements of @a width bits initialized with @a value
+ *
+ * @throw std::length_error if @a width is not between 1 and 64
+ */
+inline packed_int_vector::packed_int_vector(uint32_t width, uint32_t number_of_elements, uint64_t value)
+        : packed_int_vector(width) {
+    resize(number_of_elements, value);
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------------- Insertions ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * Add an element to the end, only the least significant width() bits of @a value are stored
+ */
+inline void packed_int_vector::push_back(uint64_t value) {
+    m_bits.append_uint_64(value & max_value(), m_width);
+}
+
+
+/**
+ * Removes the last element
+ */
+inline void packed_int_vector::pop_back() {
+    m_bits.pop_back(m_width);
+}
+
+
+/**
+ * Add @a number_of_elements elements from @a values to the end, reallocates at most once
+ */
+inline void packed_int_vector::append(const uint64_t* values, uint32_t number_of_elements) {
+    const uint32_t first = size();
+    m_bits.insert(m_bits.size(), number_of_elements * m_width, false);
+    pack(first, number_of_elements, values);
+}
+
+
+/*===================================================================================================================*/
+/*--------------------------------------------------- Data Access ---------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return The element at @a index, which is not checked when the element is read by a single load, use at() for a
+ *         checked access
+ * @throw std::out_of_range if @a index is not less than size() and the element is read by bit_string::get_bits()
+ *        instead (widths greater than 57 and the last bytes of the storage)
+ */
+inline uint64_t packed_int_vector::get(uint32_t index) const {
+    const uint64_t position = uint64_t(index) * m_width;
+    if (m_width <= MAX_WIDTH - bit_string::BYTE + 1 && is_word_accessible(position)) {
+        return load_field(m_bits.m_data, position, MAX_WIDTH - m_width);
+    }
+    return m_bits.get_bits(position, m_width);
+}
+
+
+/**
+ * Set the element at @a index to the least significant width() bits of @a value
+ * @throw std::out_of_range if @a index is not less than size()
+ */
+inline void packed_int_vector::set(uint32_t index, uint64_t value) {
+    m_bits.set_bits(uint64_t(index) * m_width, m_width, value);
+}
+
+
+/**
+ * @return The element at @a index
+ * @throw std::out_of_range if @a index is not less than size()
+ */
+inline uint64_t packed_int_vector::at(uint32_t index) const {
+    check_index(index);
+    return get(index);
+}
+
+
+/**
+ * @return Read/write reference to the element at @a index
+ * @throw std::out_of_range if @a index is not less than size()
+ */
+inline packed_int_vector::reference packed_int_vector::at(uint32_t index) {
+    check_index(index);
+    return reference(this, index);
+}
+
+
+inline uint64_t packed_int_vector::operator [](uint32_t index) const {
+    return get(index);
+}
+
+
+inline packed_int_vector::reference packed_int_vector::operator [](uint32_t index) {
+    return reference(this, index);
+}
+
+
+inline uint64_t packed_int_vector::front() const {
+    return get(0);
+}
+
+
+inline uint64_t packed_int_vector::back() const {
+    return get(size() - 1);
+}
+
+
+/**
+ * Copy @a number_of_elements elements starting at @a first to @a out. <br>
+ * Every element is read with one unaligned 64-bit load and a shift pair, 4 elements per iteration.
+ *
+ * @throw std::out_of_range if the range exceeds size()
+ */
+inline void packed_int_vector::unpack(uint32_t first, uint32_t number_of_elements, uint64_t* out) const {
+    check_range(first, number_of_elements);
+
+    const uint8_t* data = m_bits.m_data;
+    const uint32_t width = m_width;
+    const uint32_t right_shift = MAX_WIDTH - width;
+    uint64_t position = uint64_t(first) * width;
+    uint32_t i = 0;
+
+    // Elements with width > 57 may span 9 bytes, and the last elements may be too close to the end of the buffer
+    if (width <= MAX_WIDTH - bit_string::BYTE + 1) {
+        for (; i + 4 <= number_of_elements && is_word_accessible(position + 3 * width); i += 4) {
+            out[i] = load_field(data, position, right_shift);
+            out[i + 1] = load_field(data, position + width, right_shift);
+            out[i + 2] = load_field(data, position + 2 * width, right_shift);
+            out[i + 3] = load_field(data, position + 3 * width, right_shift);
+            position += 4 * width;
+        }
+    }
+
+    for (; i < number_of_elements; ++i) {
+        out[i] = m_bits.get_bits(position, width);
+        position += width;
+    }
+}
+
+
+/**
+ * Overwrite @a number_of_elements elements starting at @a first with @a values,
+ * only the least significant width() bits of every value are stored. <br>
+ * The elements are accumulated in a 64-bit register which is stored whenever it is full, so every byte is written
+ * once and there are no overlapping read-modify-write stores.
+ *
+ * @throw std::out_of_range if the range exceeds size()
+ */
+inline void packed_int_vector::pack(uint32_t first, uint32_t number_of_elements, const uint64_t* values) {
+    check_range(first, number_of_elements);
+    if (number_of_elements == 0)
+        return;
+
+    const uint32_t width = m_width;
+    const uint64_t mask = max_value();
+    const uint64_t position = uint64_t(first) * width;
+    uint8_t* output = m_bits.m_data + position / bit_string::BYTE;
+
+    // Start with the bits before the first element in its byte, so they are written back unchanged
+    uint32_t accumulated_bits = position % bit_string::BYTE;
+    uint64_t accumulator = accumulated_bits ? output[0] >> (bit_string::BYTE - accumulated_bits) : 0;
+
+    for (uint32_t i = 0; i < number_of_elements; ++i) {
+        const uint64_t value = values[i] & mask;
+        if (accumulated_bits + width < MAX_WIDTH) {
+            accumulator = (accumulator << width) | value;
+            accumulated_bits += width;
+        } else {
+            // The accumulator is full, store it and keep the remaining low bits of the value
+            const uint32_t remaining_bits = accumulated_bits + width - MAX_WIDTH;
+            const uint64_t word = accumulated_bits ? (accumulator << (MAX_WIDTH - accumulated_bits)) |
+                                                     (value >> remaining_bits) : value;
+            msb_first::store_64(output, word);
+            output += sizeof(uint64_t);
+            accumulator = remaining_bits ? value & (~uint64_t(0) >> (MAX_WIDTH - remaining_bits)) : 0;
+            accumulated_bits = remaining_bits;
+        }
+    }
+
+    if (accumulated_bits == 0)
+        return;
+
+    // Flush the complete bytes, then merge the last partial byte with the bits after the range
+    accumulator <<= MAX_WIDTH - accumulated_bits;
+    for (; accumulated_bits >= bit_string::BYTE; accumulated_bits -= bit_string::BYTE) {
+        *output++ = uint8_t(accumulator >> (MAX_WIDTH - bit_string::BYTE));
+        accumulator <<= bit_string::BYTE;
+    }
+    if (accumulated_bits) {
+        const uint8_t kept_bits = 0xFF >> accumulated_bits;
+        *output = uint8_t(accumulator >> (MAX_WIDTH - bit_string::BYTE)) | (*output & kept_bits);
+    }
+}
+
+
+/**
+ * @return The underlying storage, the elements packed back to back
+ */
+inline const bit_string& packed_int_vector::bits() const {
+    return m_bits;
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------------- Iterators ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+inline packed_int_vector::iterator packed_int_vector::begin() {
+    return iterator(this, 0);
+}
+
+
+inline packed_int_vector::const_iterator packed_int_vector::begin() const {
+    return const_iterator(this, 0);
+}
+
+
+inline packed_int_vector::iterator packed_int_vector::end() {
+    return iterator(this, size());
+}
+
+
+inline packed_int_vector::const_iterator packed_int_vector::end() const {
+    return const_iterator(this, size());
+}
+
+
+inline packed_int_vector::const_iterator packed_int_vector::cbegin() const {
+    return begin();
+}
+
+
+inline packed_int_vector::const_iterator packed_int_vector::cend() const {
+    return end();
+}
+
+
+/*===================================================================================================================*/
+/*------------------------------------------------------ Other ------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+inline bool packed_int_vector::operator ==(const packed_int_vector& other) const {
+    return m_width == other.m_width && m_bits == other.m_bits;
+}
+
+
+inline bool packed_int_vector::operator !=(const packed_int_vector& other) const {
+    return !(*this == other);
+}
+
+
+/**
+ * Resizes the %packed_int_vector to @a number_of_elements, new elements are initialized with @a value
+ */
+inline void packed_int_vector::resize(uint32_t number_of_elements, uint64_t value) {
+    const uint32_t old_size = size();
+    if (number_of_elements <= old_size) {
+        m_bits.pop_back((old_size - number_of_elements) * m_width);
+        return;
+    }
+
+    m_bits.reserve(uint64_t(number_of_elements) * m_width);
+    value &= max_value();
+    if (value == 0 || value == max_value()) { // All bits of the new elements are the same
+        m_bits.insert(m_bits.size(), (number_of_elements - old_size) * m_width, value != 0);
+        return;
+    }
+
+    for (uint32_t i = old_size; i < number_of_elements; ++i) {
+        m_bits.append_uint_64(value, m_width);
+    }
+}
+
+
+/**
+ * Allocate enough memory for @a number_of_elements elements
+ */
+inline void packed_int_vector::reserve(uint32_t number_of_elements) {
+    m_bits.reserve(uint64_t(number_of_elements) * m_width);
+}
+
+
+/**
+ * Erases all the elements.
+ * @note This does not actually clear the memory allocated
+ */
+inline void packed_int_vector::clear() {
+    m_bits.clear();
+}
+
+
+inline bool packed_int_vector::empty() const {
+    return m_bits.empty();
+}
+
+
+/**
+ * @return The number of elements
+ */
+inline uint32_t packed_int_vector::size() const {
+    return m_bits.size() / m_width;
+}
+
+
+/**
+ * @return The number of elements that can be stored without reallocation
+ */
+inline uint32_t packed_int_vector::capacity() const {
+    return m_bits.capacity() / m_width;
+}
+
+
+/**
+ * @return The number of bits of every element
+ */
+inline uint32_t packed_int_vector::width() const {
+    return m_width;
+}
+
+
+/**
+ * @return The largest value that fits in width() bits
+ */
+inline uint64_t packed_int_vector::max_value() const {
+    return ~uint64_t(0) >> (MAX_WIDTH - m_width);
+}
+
+
+/**
+ * @return The field of (64 - @a right_shift) bits starting at bit @a position of @a data, it must not cross the
+ *         64-bit word starting at the byte of @a position
+ */
+inline uint64_t packed_int_vector::load_field(const uint8_t* data, uint64_t position, uint32_t right_shift) {
+    const uint64_t word = msb_first::load_64(data + position / bit_string::BYTE);
+    return (word << (position % bit_string::BYTE)) >> right_shift;
+}
+
+
+/**
+ * @return True if the 8 bytes starting at the byte of bit @a position are inside the allocated buffer
+ */
+inline bool packed_int_vector::is_word_accessible(uint64_t position) const {
+    return position / bit_string::BYTE + sizeof(uint64_t) <= m_bits.capacity() / bit_string::BYTE;
+}
+
+
+/**
+ * @throw std::out_of_range if @a index is not less than size()
+ */
+inline void packed_int_vector::check_index(uint32_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("index " + std::to_string(index) + " is out of range of packed_int_vector of size " +
+                                std::to_string(size()));
+    }
+}
+
+
+/**
+ * @throw std::out_of_range if the range of @a number_of_elements starting at @a first exceeds size()
+ */
+inline void packed_int_vector::check_range(uint32_t first, uint32_t number_of_elements) const {
+    if (uint64_t(first) + number_of_elements > size()) {
+        throw std::out_of_range("range [" + std::to_string(first) + ", " +
+                                std::to_string(uint64_t(first) + number_of_elements) +
+                                ") is out of range of packed_int_vector of size " + std::to_string(size()));
+    }
+}
+
+#endif //PACKED_INT_VECTOR_H
@@ -0,0 +1,403 @@
+#ifndef SHARED_BIT_STRING_H
+#define SHARED_BIT_STRING_H
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "bit_string.h"
+
+/**
+ * Copy on write %basic_bit_string, whose buffer is reference counted and shared between copies. <br>
+ * Copies are O(1) and never allocate, a byte aligned substr() shares the buffer of its parent with an offset.
+ * The first mutation of a shared (or offset) string makes one deep copy of its bits, later mutations are done in
+ * place while the string is the only owner of its buffer.
+ *
+ * The shared buffer is never modified, so copies can be read from different threads at the same time. A single
+ * %shared_bit_string must not be modified while it is read, as a %bit_string.
+ *
+ * @note The bits after size() in the last byte of data() are not necessarily zeros, as the buffer may be longer
+ *
+ * @example shared_bit_string frame(std::move(bits));
+ *          shared_bit_string payload = frame.substr(32);  // Shares the buffer of frame
+ *          payload.push_back(1);  // Copies the payload once, frame is not changed
+ */
+template<typename BitOrder>
+class basic_shared_bit_string {
+
+public:
+
+    typedef basic_bit_string<BitOrder> string_type;
+    typedef typename string_type::const_iterator const_iterator;
+
+    static const uint32_t BYTE = 8;
+
+private:
+
+    std::shared_ptr<string_type> m_buffer;
+    uint32_t m_offset_in_bytes = 0;
+    uint32_t m_size_in_bits = 0;
+
+    string_type& unshare();
+
+    uint8_t last_byte_mask() const;
+
+public:
+
+    basic_shared_bit_string() = default;
+
+    explicit basic_shared_bit_string(string_type bits);
+
+/*===================================================================================================================*/
+
+    bool at(uint32_t position) const;
+
+    bool operator [](uint32_t position) const;
+
+    uint64_t get_bits(uint32_t position, uint32_t number_of_bits) const;
+
+    basic_shared_bit_string substr(uint32_t start) const;
+
+    basic_shared_bit_string substr(uint32_t start, uint32_t length) const;
+
+    string_type to_bit_string() const;
+
+    uint32_t count() const;
+
+    bool operator ==(const basic_shared_bit_string& other) const;
+
+    bool operator !=(const basic_shared_bit_string& other) const;
+
+    const uint8_t* data() const;
+
+    const_iterator begin() const;
+
+    const_iterator end() const;
+
+/*===================================================================================================================*/
+
+    void push_back(bool bit);
+
+    void pop_back(uint32_t number_of_bits = 1);
+
+    void append(const string_type& bits);
+
+    void append(const basic_shared_bit_string& bits);
+
+    void append_uint_64(uint64_t value, uint32_t number_of_bits = sizeof(uint64_t) * BYTE);
+
+    void set(uint32_t position, uint32_t length, bool bit = true);
+
+    void reset(uint32_t position, uint32_t length);
+
+    void flip(uint32_t position, uint32_t length);
+
+    void set_bits(uint32_t position, uint32_t number_of_bits, uint64_t value);
+
+    void clear();
+
+/*===================================================================================================================*/
+
+    bool is_shared() const;
+
+    bool empty() const;
+
+    uint32_t size() const;
+
+    uint32_t length() const;
+
+    uint32_t size_in_bytes() const;
+};
+
+typedef basic_shared_bit_string<msb_first> shared_bit_string;
+typedef basic_shared_bit_string<lsb_first> lsb_shared_bit_string;
+
+
+/**
+ * @param bits The bits of the string, moved (or copied) into a new shared buffer
+ */
+template<typename BitOrder>
+basic_shared_bit_string<BitOrder>::basic_shared_bit_string(string_type bits)
+        : m_buffer(std::make_shared<string_type>(std::move(bits))), m_offset_in_bytes(0),
+          m_size_in_bits(m_buffer->size()) {}
+
+
+/*===================================================================================================================*/
+/*--------------------------------------------------- Access --------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @throw std::out_of_range if @a position is not less than size()
+ */
+template<typename BitOrder>
+bool basic_shared_bit_string<BitOrder>::at(uint32_t position) const {
+    if (position >= m_size_in_bits) {
+        throw std::out_of_range("position " + std::to_string(position) + " is out of range of bit_string of size " +
+                                std::to_string(m_size_in_bits));
+    }
+    return m_buffer->at(m_offset_in_bytes * BYTE + position);
+}
+
+template<typename BitOrder>
+bool basic_shared_bit_string<BitOrder>::operator [](uint32_t position) const {
+    return at(position);
+}
+
+/**
+ * Read a field of @a number_of_bits starting at @a position without allocating, as bit_string::get_bits()
+ *
+ * @throw std::length_error if number_of_bits is greater than 64
+ * @throw std::out_of_range if the field exceeds size()
+ */
+template<typename BitOrder>
+uint64_t basic_shared_bit_string<BitOrder>::get_bits(uint32_t position, uint32_t number_of_bits) const {
+    string_type::check_field_size(number_of_bits);
+    if (uint64_t(position) + number_of_bits > m_size_in_bits) {
+        throw std::out_of_range("range [" + std::to_string(position) + ", " +
+                                std::to_string(uint64_t(position) + number_of_bits) +
+                                ") is out of range of bit_string of size " + std::to_string(m_size_in_bits));
+    }
+    if (number_of_bits == 0)
+        return 0;
+    return m_buffer->get_bits(m_offset_in_bytes * BYTE + position, number_of_bits);
+}
+
+/**
+ * @param start Index of first bit.
+ * @return A new string starting at @a start to the end
+ */
+template<typename BitOrder>
+basic_shared_bit_string<BitOrder> basic_shared_bit_string<BitOrder>::substr(uint32_t start) const {
+    if (start > m_size_in_bits) {
+        throw std::out_of_range("position " + std::to_string(start) + " is out of range of bit_string of size " +
+                                std::to_string(m_size_in_bits));
+    }
+    return substr(start, m_size_in_bits - start);
+}
+
+/**
+ * If @a start is a multiple of 8 the new string shares the buffer of this one in O(1), otherwise its bits are copied
+ * into a new buffer.
+ *
+ * @param start Index of first bit.
+ * @param length The number of bits to take.
+ * @return A new string starting at @a start with length of @a length.
+ * @throw std::out_of_range if the range exceeds size()
+ */
+template<typename BitOrder>
+basic_shared_bit_string<BitOrder>
+basic_shared_bit_string<BitOrder>::substr(uint32_t start, uint32_t length) const {
+    if (uint64_t(start) + length > m_size_in_bits) {
+        throw std::out_of_range("range [" + std::to_string(start) + ", " + std::to_string(uint64_t(start) + length) +
+                                ") is out of range of bit_string of size " + std::to_string(m_size_in_bits));
+    }
+    if (length == 0)
+        return basic_shared_bit_string();
+    if (start % BYTE != 0)
+        return basic_shared_bit_string(m_buffer->substr(m_offset_in_bytes * BYTE + start, length));
+
+    basic_shared_bit_string _bit_string;
+    _bit_string.m_buffer = m_buffer;
+    _bit_string.m_offset_in_bytes = m_offset_in_bytes + start / BYTE;
+    _bit_string.m_size_in_bits = length;
+    return _bit_string;
+}
+
+/**
+ * @return A %bit_string with a copy of the bits
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder> basic_shared_bit_string<BitOrder>::to_bit_string() const {
+    if (m_size_in_bits == 0)
+        return string_type();
+    return m_buffer->substr(m_offset_in_bytes * BYTE, m_size_in_bits);
+}
+
+/**
+ * @return Number of bits set to 1
+ */
+template<typename BitOrder>
+uint32_t basic_shared_bit_string<BitOrder>::count() const {
+    if (m_size_in_bits == 0)
+        return 0;
+    const uint32_t complete_bytes = m_size_in_bits / BYTE;
+    uint32_t ones = uint32_t(bit_kernels::get().popcount(data(), complete_bytes));
+    if (m_size_in_bits % BYTE)
+        ones += uint32_t(scalar_kernels::popcount_64(data()[complete_bytes] & last_byte_mask()));
+    return ones;
+}
+
+template<typename BitOrder>
+bool basic_shared_bit_string<BitOrder>::operator ==(const basic_shared_bit_string& other) const {
+    if (m_size_in_bits != other.m_size_in_bits)
+        return false;
+    if (m_size_in_bits == 0 || (m_buffer == other.m_buffer && m_offset_in_bytes == other.m_offset_in_bytes))
+        return true;
+
+    const uint32_t complete_bytes = m_size_in_bits / BYTE;
+    if (!bit_kernels::get().equal(data(), other.data(), complete_bytes))
+        return false;
+    return m_size_in_bits % BYTE == 0 ||
+           ((data()[complete_bytes] ^ other.data()[complete_bytes]) & last_byte_mask()) == 0;
+}
+
+template<typename BitOrder>
+bool basic_shared_bit_string<BitOrder>::operator !=(const basic_shared_bit_string& other) const {
+    return !(other == *this);
+}
+
+/**
+ * @return Pointer to the first byte of the string in the shared buffer, or nullptr if it has no buffer
+ */
+template<typename BitOrder>
+const uint8_t* basic_shared_bit_string<BitOrder>::data() const {
+    return m_buffer ? m_buffer->data() + m_offset_in_bytes : nullptr;
+}
+
+template<typename BitOrder>
+typename basic_shared_bit_string<BitOrder>::const_iterator basic_shared_bit_string<BitOrder>::begin() const {
+    return {0, const_cast<uint8_t*>(data())};
+}
+
+template<typename BitOrder>
+typename basic_shared_bit_string<BitOrder>::const_iterator basic_shared_bit_string<BitOrder>::end() const {
+    return {m_size_in_bits, const_cast<uint8_t*>(data())};
+}
+
+
+/*===================================================================================================================*/
+/*-------------------------------------------------- Modifiers ------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+template<typename BitOrder>
+void basic_shared_bit_string<BitOrder>::push_back(bool bit) {
+    string_type& bits = unshare();
+    bits.push_back(bit);
+    m_size_in_bits = bits.size();
+}
+
+template<typename BitOrder>
+void basic_shared_bit_string<BitOrder>::pop_back(uint32_t number_of_bits) {
+    string_type& bits = unshare();
+    bits.pop_back(number_of_bits);
+    m_size_in_bits = bits.size();
+}
+
+template<typename BitOrder>
+void basic_shared_bit_string<BitOrder>::append(const string_type& bits) {
+    string_type& own = unshare();
+    own.append(bits);
+    m_size_in_bits = own.size();
+}
+
+template<typename BitOrder>
+void basic_shared_bit_string<BitOrder>::append(const basic_shared_bit_string& bits) {
+    append(bits.to_bit_string());
+}
+
+template<typename BitOrder>
+void basic_shared_bit_string<BitOrder>::append_uint_64(uint64_t value, uint32_t number_of_bits) {
+    string_type& bits = unshare();
+    bits.append_uint_64(value, number_of_bits);
+    m_size_in_bits = bits.size();
+}
+
+template<typename BitOrder>
+void basic_shared_bit_string<BitOrder>::set(uint32_t position, uint32_t length, bool bit) {
+    unshare().set(position, length, bit);
+}
+
+template<typename BitOrder>
+void basic_shared_bit_string<BitOrder>::reset(uint32_t position, uint32_t length) {
+    unshare().reset(position, length);
+}
+
+template<typename BitOrder>
+void basic_shared_bit_string<BitOrder>::flip(uint32_t position, uint32_t length) {
+    unshare().flip(position, length);
+}
+
+template<typename BitOrder>
+void basic_shared_bit_string<BitOrder>::set_bits(uint32_t position, uint32_t number_of_bits, uint64_t value) {
+    unshare().set_bits(position, number_of_bits, value);
+}
+
+/**
+ * Remove all bits, the shared buffer is released and not copied
+ */
+template<typename BitOrder>
+void basic_shared_bit_string<BitOrder>::clear() {
+    m_buffer.reset();
+    m_offset_in_bytes = 0;
+    m_size_in_bits = 0;
+}
+
+
+/*===================================================================================================================*/
+/*-------------------------------------------------- Capacity -------------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * @return true if the buffer is shared with other strings, so the next mutation will copy it
+ */
+template<typename BitOrder>
+bool basic_shared_bit_string<BitOrder>::is_shared() const {
+    return m_buffer && m_buffer.use_count() > 1;
+}
+
+template<typename BitOrder>
+bool basic_shared_bit_string<BitOrder>::empty() const {
+    return m_size_in_bits == 0;
+}
+
+template<typename BitOrder>
+uint32_t basic_shared_bit_string<BitOrder>::size() const {
+    return m_size_in_bits;
+}
+
+template<typename BitOrder>
+uint32_t basic_shared_bit_string<BitOrder>::length() const {
+    return m_size_in_bits;
+}
+
+template<typename BitOrder>
+uint32_t basic_shared_bit_string<BitOrder>::size_in_bytes() const {
+    return string_type::convert_size_to_bytes(m_size_in_bits);
+}
+
+
+/*===================================================================================================================*/
+/*---------------------------------------------- Private Helpers ----------------------------------------------------*/
+/*===================================================================================================================*/
+
+
+/**
+ * Make this string the only owner of a buffer holding exactly its bits, copying them once if the buffer is shared
+ * or holds other bits too
+ *
+ * @return The buffer, which may be modified in place
+ */
+template<typename BitOrder>
+basic_bit_string<BitOrder>& basic_shared_bit_string<BitOrder>::unshare() {
+    if (!m_buffer) {
+        m_buffer = std::make_shared<string_type>();
+    } else if (m_buffer.use_count() > 1 || m_offset_in_bytes != 0 || m_size_in_bits != m_buffer->size()) {
+        m_buffer = std::make_shared<string_type>(to_bit_string());
+        m_offset_in_bytes = 0;
+    }
+    return *m_buffer;
+}
+
+/**
+ * @return Mask of the bits of the last byte of data() which are part of the string
+ */
+template<typename BitOrder>
+uint8_t basic_shared_bit_string<BitOrder>::last_byte_mask() const {
+    return BitOrder::head_mask(m_size_in_bits % BYTE);
+}
+
+#endif //SHARED_BIT_STRING_H
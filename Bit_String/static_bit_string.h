@@ -0,0 +1,653 @@
+#ifndef STATIC_BIT_STRING_H
+#define STATIC_BIT_STRING_H
+
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+
+#include "bit_string.h"
+
+// C++11 constexpr functions are restricted to a single return statement, so loops are only constexpr since C++14
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define BIT_STRING_CONSTEXPR constexpr
+#else
+#define BIT_STRING_CONSTEXPR
+#endif
+
+/**
+ * Tag to select the constructor taking the raw bytes, used by the compile time literals.
+ */
+struct static_bit_string_bytes_tag {};
+
+/**
+ * Fixed capacity bit string with inline storage of @a N bits, it never allocates on the heap. <br>
+ * It has the same memory layout and a similar interface to %bit_string, and all the functions that do not return
+ * iterators or references are @a constexpr under C++14 and later, so lookup tables can be built at compile time.
+ * Under C++11 only the accessors (size(), at(), data(), ...) and the literals are @a constexpr.
+ *
+ * Bits after size() are always kept zeros, exceeding the capacity @a N throws std::length_error
+ * (which is a compile error in constant expressions).
+ *
+ * @example constexpr auto header = static_bit_string<16>::from_string("1010");
+ */
+template<uint32_t N>
+class static_bit_string {
+
+public:
+    typedef bit_iterator                            iterator;
+    typedef const_bit_iterator                      const_iterator;
+    typedef std::reverse_iterator<iterator>         reverse_iterator;
+    typedef std::reverse_iterator<const_iterator>   const_reverse_iterator;
+
+    static const uint32_t BYTE = 8;
+    static const uint32_t CAPACITY_IN_BYTES = (N + BYTE - 1) / BYTE;
+
+private:
+
+    uint32_t m_size_in_bits = 0;
+
+    // At least one byte, zero sized arrays are not allowed
+    uint8_t m_data[CAPACITY_IN_BYTES ? CAPACITY_IN_BYTES : 1] = {};
+
+public:
+
+/*------------------------------------------ Constructors , Factory methods ------------------------------------------*/
+
+    BIT_STRING_CONSTEXPR static_bit_string() = default;
+
+    /**
+     * Constructs %static_bit_string of @a size_in_bits from its raw @a bytes, constexpr even under C++11.
+     * @note The bits after @a size_in_bits in @a bytes must be zeros
+     */
+    template<typename... Bytes>
+    constexpr static_bit_string(static_bit_string_bytes_tag, uint32_t size_in_bits, Bytes... bytes)
+            : m_size_in_bits(size_in_bits), m_data{uint8_t(bytes)...} {}
+
+    /**
+     * Constructs %static_bit_string contains @a number_of_elements initialized with @a value.
+     * @throw std::length_error if @a number_of_elements is greater than N
+     */
+    BIT_STRING_CONSTEXPR static_bit_string(uint32_t number_of_elements, bool value) {
+        check_capacity(number_of_elements);
+        for (uint32_t i = 0; i < number_of_elements; ++i) {
+            push_back(value);
+        }
+    }
+
+    /**
+     * Copy the bits of @a bits.
+     * @throw std::length_error if @a bits has more than N bits
+     */
+    explicit static_bit_string(const bit_string& bits) {
+        check_capacity(bits.size());
+        for (uint32_t i = 0; i < bits.size_in_bytes(); ++i) {
+            m_data[i] = bits.at_byte(i);
+        }
+        m_size_in_bits = bits.size();
+        fill_extra_bits_with_zeros();
+    }
+
+    /**
+     * Converts C style string of '0's and '1's to %static_bit_string
+     * @throw std::logic_error if %str contains any char other than '0' and '1'
+     * @throw std::length_error if %str has more than N chars
+     */
+    BIT_STRING_CONSTEXPR static static_bit_string from_string(const char* str) {
+        static_bit_string _bit_string;
+        _bit_string.append(str);
+        return _bit_string;
+    }
+
+    /**
+     * Copy the raw bytes of @a data, each byte is 8 bits
+     * @throw std::length_error if @a length bytes does not fit in N bits
+     */
+    BIT_STRING_CONSTEXPR static static_bit_string from_data(const char* data, uint32_t length) {
+        static_bit_string _bit_string;
+        for (uint32_t i = 0; i < length; ++i) {
+            _bit_string.append_byte(uint8_t(data[i]));
+        }
+        return _bit_string;
+    }
+
+    BIT_STRING_CONSTEXPR static static_bit_string from_uint_64(uint64_t value, uint8_t number_of_bits = 64) {
+        static_bit_string _bit_string;
+        _bit_string.append_uint_64(value, number_of_bits);
+        return _bit_string;
+    }
+
+/*---------------------------------------------------- Insertions ----------------------------------------------------*/
+
+    /**
+     * Append a single bit to the end of the %static_bit_string.
+     * @throw std::length_error if the %static_bit_string is full
+     */
+    BIT_STRING_CONSTEXPR void push_back(bool bit) {
+        check_capacity(m_size_in_bits + 1);
+        if (bit) {
+            m_data[m_size_in_bits / BYTE] |= uint8_t(1u << (BYTE - m_size_in_bits % BYTE - 1));
+        }
+        m_size_in_bits++;
+    }
+
+    /**
+     * Remove last @a number_of_bits from the %static_bit_string
+     */
+    BIT_STRING_CONSTEXPR void pop_back(uint32_t number_of_bits = 1) {
+        m_size_in_bits = number_of_bits < m_size_in_bits ? m_size_in_bits - number_of_bits : 0;
+        fill_extra_bits_with_zeros();
+        for (uint32_t i = size_in_bytes(); i < CAPACITY_IN_BYTES; ++i) {
+            m_data[i] = 0;
+        }
+    }
+
+    /**
+     * Push @a bits to the end of this %static_bit_string
+     * @throw std::length_error if the result exceeds N bits
+     */
+    template<uint32_t M>
+    BIT_STRING_CONSTEXPR void append(const static_bit_string<M>& bits) {
+        // The size is read once as bits may be *this, which grows while appending
+        const uint32_t size = bits.size();
+        check_capacity(m_size_in_bits + size);
+        for (uint32_t i = 0; i < size; i += BYTE) {
+            uint32_t number_of_bits = size - i < BYTE ? size - i : BYTE;
+            append_uint_unchecked(bits.at_byte(i / BYTE) >> (BYTE - number_of_bits), number_of_bits);
+        }
+    }
+
+    /**
+     * Push @a bits to the end of this %static_bit_string
+     * @throw std::length_error if the result exceeds N bits
+     */
+    void append(const bit_string& bits) {
+        check_capacity(m_size_in_bits + bits.size());
+        for (uint32_t i = 0; i < bits.size(); i += BYTE) {
+            uint32_t number_of_bits = bits.size() - i < BYTE ? bits.size() - i : BYTE;
+            append_uint_unchecked(bits.at_byte(i / BYTE) >> (BYTE - number_of_bits), number_of_bits);
+        }
+    }
+
+    /**
+     * Append bits to the end of the %static_bit_string
+     *
+     * @param bits C style string of '0's and '1's
+     * @throw std::logic_error any char in bits is not '0' or '1'
+     * @throw std::length_error if the result exceeds N bits
+     */
+    BIT_STRING_CONSTEXPR void append(const char* bits) {
+        for (uint32_t i = 0; bits[i] != '\0'; ++i) {
+            if (bits[i] != '0' && bits[i] != '1') {
+                throw std::logic_error(R"(bit_string accepts only '0' and '1')");
+            }
+            push_back(bits[i] == '1');
+        }
+    }
+
+    BIT_STRING_CONSTEXPR void append_byte(uint8_t byte) {
+        append_uint_64(byte, BYTE);
+    }
+
+    /**
+     * Append the actual bits of %value with length of %number_of_bits starting from the LSB
+     * @throw std::length_error if number_of_bits is greater than 16 or the result exceeds N bits
+     */
+    BIT_STRING_CONSTEXPR void append_uint_16(uint16_t value, uint32_t number_of_bits = sizeof(uint16_t) * BYTE) {
+        append_uint(value, number_of_bits, sizeof(value));
+    }
+
+    /**
+     * Append the actual bits of %value with length of %number_of_bits starting from the LSB
+     * @throw std::length_error if number_of_bits is greater than 32 or the result exceeds N bits
+     */
+    BIT_STRING_CONSTEXPR void append_uint_32(uint32_t value, uint32_t number_of_bits = sizeof(uint32_t) * BYTE) {
+        append_uint(value, number_of_bits, sizeof(value));
+    }
+
+    /**
+     * Append the actual bits of %value with length of %number_of_bits starting from the LSB
+     * @throw std::length_error if number_of_bits is greater than 64 or the result exceeds N bits
+     */
+    BIT_STRING_CONSTEXPR void append_uint_64(uint64_t value, uint32_t number_of_bits = sizeof(uint64_t) * BYTE) {
+        append_uint(value, number_of_bits, sizeof(value));
+    }
+
+/*--------------------------------------------------- Data Access ---------------------------------------------------*/
+
+    /**
+     * @return A new %static_bit_string starting at @a start with length of @a length.
+     * @throw std::out_of_range if the range exceeds size()
+     */
+    BIT_STRING_CONSTEXPR static_bit_string substr(uint32_t start, uint32_t length) const {
+        check_range(start, length);
+        static_bit_string _bit_string;
+        const uint32_t shift = start % BYTE;
+        const uint32_t first_byte = start / BYTE;
+        for (uint32_t i = 0; i < (length + BYTE - 1) / BYTE && first_byte + i < CAPACITY_IN_BYTES; ++i) {
+            uint8_t value = m_data[first_byte + i] << shift;
+            if (shift != 0 && first_byte + i + 1 < CAPACITY_IN_BYTES) {
+                value |= m_data[first_byte + i + 1] >> (BYTE - shift);
+            }
+            _bit_string.m_data[i] = value;
+        }
+        _bit_string.m_size_in_bits = length;
+        _bit_string.fill_extra_bits_with_zeros();
+        return _bit_string;
+    }
+
+    /**
+     * @return A new %static_bit_string from @a start to the end.
+     * @throw std::out_of_range if @a start is greater than size()
+     */
+    BIT_STRING_CONSTEXPR static_bit_string substr(uint32_t start) const {
+        return substr(check_range(start, 0), m_size_in_bits - start);
+    }
+
+    /**
+     * @throw std::out_of_range if @a position is not less than size()
+     */
+    constexpr bool at(uint32_t position) const {
+        return (m_data[check_range(position, 1) / BYTE] >> (BYTE - position % BYTE - 1)) & 1u;
+    }
+
+    /**
+     * @throw std::out_of_range if @a position is not less than size()
+     */
+    bit_reference at(uint32_t position) {
+        return {check_range(position, 1), m_data};
+    }
+
+    constexpr bool operator [](uint32_t position) const {
+        return at(position);
+    }
+
+    bit_reference operator [](uint32_t position) {
+        return at(position);
+    }
+
+    constexpr uint8_t at_byte(uint32_t position) const {
+        return m_data[position];
+    }
+
+    constexpr bool front() const {
+        return at(0);
+    }
+
+    constexpr bool back() const {
+        return at(m_size_in_bits - 1);
+    }
+
+    constexpr const uint8_t* data() const {
+        return m_data;
+    }
+
+/*---------------------------------------------------- Convertors ----------------------------------------------------*/
+
+    BIT_STRING_CONSTEXPR uint64_t to_uint_64() const {
+        return to_uint(sizeof(uint64_t));
+    }
+
+    BIT_STRING_CONSTEXPR uint32_t to_uint_32() const {
+        return to_uint(sizeof(uint32_t));
+    }
+
+    BIT_STRING_CONSTEXPR uint16_t to_uint_16() const {
+        return to_uint(sizeof(uint16_t));
+    }
+
+    BIT_STRING_CONSTEXPR uint8_t to_uint_8() const {
+        return to_uint(sizeof(uint8_t));
+    }
+
+    /**
+     * @return Heap allocated %bit_string with the same bits
+     */
+    bit_string to_bit_string() const {
+        bit_string _bit_string = bit_string::from_data(m_data, size_in_bytes());
+        _bit_string.pop_back(extra_bits_size());
+        return _bit_string;
+    }
+
+    explicit operator bit_string() const {
+        return to_bit_string();
+    }
+
+    std::string to_string(char one = '1', char zero = '0') const {
+        std::string str;
+        str.reserve(m_size_in_bits);
+        for (uint32_t i = 0; i < m_size_in_bits; ++i) {
+            str.push_back(at(i) ? one : zero);
+        }
+        return str;
+    }
+
+/*---------------------------------------------------- Iterators ----------------------------------------------------*/
+
+    iterator begin() {
+        return {0, m_data};
+    }
+
+    const_iterator begin() const {
+        return {0, const_cast<uint8_t*>(m_data)};
+    }
+
+    iterator end() {
+        return {m_size_in_bits, m_data};
+    }
+
+    const_iterator end() const {
+        return {m_size_in_bits, const_cast<uint8_t*>(m_data)};
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+/*------------------------------------------------------ Other ------------------------------------------------------*/
+
+    BIT_STRING_CONSTEXPR bool operator ==(const static_bit_string& other) const {
+        if (m_size_in_bits != other.m_size_in_bits)
+            return false;
+        for (uint32_t i = 0; i < size_in_bytes(); ++i) {
+            if (m_data[i] != other.m_data[i])
+                return false;
+        }
+        return true;
+    }
+
+    BIT_STRING_CONSTEXPR bool operator !=(const static_bit_string& other) const {
+        return !(*this == other);
+    }
+
+    BIT_STRING_CONSTEXPR void clear() {
+        pop_back(m_size_in_bits);
+    }
+
+    constexpr bool empty() const {
+        return m_size_in_bits == 0;
+    }
+
+    constexpr bool fit_in_bytes() const {
+        return m_size_in_bits % BYTE == 0;
+    }
+
+    constexpr uint32_t capacity() const {
+        return N;
+    }
+
+    constexpr uint32_t size() const {
+        return m_size_in_bits;
+    }
+
+    constexpr uint32_t length() const {
+        return m_size_in_bits;
+    }
+
+    constexpr uint32_t size_in_bytes() const {
+        return (m_size_in_bits + BYTE - 1) / BYTE;
+    }
+
+    constexpr uint8_t extra_bits_size() const {
+        return size_in_bytes() * BYTE - m_size_in_bits;
+    }
+
+private:
+
+    /**
+     * A single conditional expression so it is usable in the C++11 constexpr accessors.
+     * @return @a position if the range [position, position + length) is within size()
+     * @throw std::out_of_range otherwise (which is a compile error in constant expressions)
+     */
+    constexpr uint32_t check_range(uint32_t position, uint32_t length) const {
+        return uint64_t(position) + length <= m_size_in_bits ? position :
+               throw std::out_of_range("range [" + std::to_string(position) + ", " +
+                                       std::to_string(uint64_t(position) + length) +
+                                       ") is out of range of static_bit_string of size " +
+                                       std::to_string(m_size_in_bits));
+    }
+
+    BIT_STRING_CONSTEXPR void check_capacity(uint64_t size_in_bits) const {
+        if (size_in_bits > N) {
+            throw std::length_error("static_bit_string capacity is " + std::to_string(N) + " bits");
+        }
+    }
+
+    BIT_STRING_CONSTEXPR void append_uint(uint64_t value, uint32_t number_of_bits, uint32_t size_of_value) {
+        if (number_of_bits > size_of_value * BYTE) {
+            throw std::length_error("number_of_bits Must be between 0 and " + std::to_string(size_of_value * BYTE));
+        }
+        check_capacity(m_size_in_bits + number_of_bits);
+        append_uint_unchecked(value, number_of_bits);
+    }
+
+    /**
+     * Append @a number_of_bits of @a value, filling up to one byte in each step
+     */
+    BIT_STRING_CONSTEXPR void append_uint_unchecked(uint64_t value, uint32_t number_of_bits) {
+        while (number_of_bits > 0) {
+            const uint32_t free_bits = BYTE - m_size_in_bits % BYTE;
+            const uint32_t count = number_of_bits < free_bits ? number_of_bits : free_bits;
+            number_of_bits -= count;
+            const uint8_t chunk = (value >> number_of_bits) & ((1u << count) - 1);
+            m_data[m_size_in_bits / BYTE] |= uint8_t(chunk << (free_bits - count));
+            m_size_in_bits += count;
+        }
+    }
+
+    BIT_STRING_CONSTEXPR uint64_t to_uint(uint32_t number_of_bytes) const {
+        if (size_in_bytes() > number_of_bytes) {
+            throw std::overflow_error("bit_string does not fit in " + std::to_string(number_of_bytes) + " bytes");
+        }
+        uint64_t value = 0;
+        for (uint32_t i = 0; i < size_in_bytes(); ++i) {
+            value = (value << BYTE) | m_data[i];
+        }
+        return value >> extra_bits_size();
+    }
+
+    BIT_STRING_CONSTEXPR void fill_extra_bits_with_zeros() {
+        if (!fit_in_bytes()) {
+            m_data[m_size_in_bits / BYTE] &= uint8_t(0xFF << extra_bits_size());
+        }
+    }
+};
+
+/*====================================================================================================================*/
+/*---------------------------------------------- User Defined Literals -----------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * Characters of a numeric literal, after removing digit separators.
+ */
+template<char... chars>
+struct bit_literal_chars {
+    static constexpr uint32_t size = sizeof...(chars);
+    static constexpr char value[sizeof...(chars) + 1] = {chars..., '\0'};
+};
+
+template<char... chars>
+constexpr char bit_literal_chars<chars...>::value[];
+
+template<uint32_t... indices>
+struct bit_literal_indices {};
+
+/**
+ * Generates bit_literal_indices<0, 1, ..., N - 1> (std::index_sequence is not available in C++11)
+ */
+template<uint32_t N, uint32_t... indices>
+struct make_bit_literal_indices : make_bit_literal_indices<N - 1, N - 1, indices...> {};
+
+template<uint32_t... indices>
+struct make_bit_literal_indices<0, indices...> {
+    typedef bit_literal_indices<indices...> type;
+};
+
+template<char...>
+struct bit_literal_always_false {
+    static const bool value = false;
+};
+
+
+/**
+ * Validates the chars of a binary literal at compile time and removes the digit separators (').
+ */
+template<typename Parsed, char... rest>
+struct binary_literal;
+
+template<char... parsed>
+struct binary_literal<bit_literal_chars<parsed...>> {
+    typedef bit_literal_chars<parsed...> chars;
+};
+
+template<char... parsed, char... rest>
+struct binary_literal<bit_literal_chars<parsed...>, '\'', rest...>
+        : binary_literal<bit_literal_chars<parsed...>, rest...> {
+};
+
+template<char... parsed, char c, char... rest>
+struct binary_literal<bit_literal_chars<parsed...>, c, rest...>
+        : binary_literal<bit_literal_chars<parsed..., c>, rest...> {
+    static_assert(c == '0' || c == '1', R"(_b literals accept only '0' and '1', i.e. 101101_b)");
+};
+
+
+/**
+ * Validates the chars of a hexadecimal literal at compile time and removes the 0x prefix and digit separators (').
+ */
+template<typename Parsed, char... rest>
+struct hex_literal_digits;
+
+template<char... parsed>
+struct hex_literal_digits<bit_literal_chars<parsed...>> {
+    typedef bit_literal_chars<parsed...> chars;
+};
+
+template<char... parsed, char... rest>
+struct hex_literal_digits<bit_literal_chars<parsed...>, '\'', rest...>
+        : hex_literal_digits<bit_literal_chars<parsed...>, rest...> {
+};
+
+template<char... parsed, char c, char... rest>
+struct hex_literal_digits<bit_literal_chars<parsed...>, c, rest...>
+        : hex_literal_digits<bit_literal_chars<parsed..., c>, rest...> {
+    static_assert((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'),
+                  "_d literals accept only hexadecimal digits, i.e. 0x616263_d");
+};
+
+template<char... digits>
+struct hex_literal {
+    static_assert(bit_literal_always_false<digits...>::value, "_d literals must start with 0x, i.e. 0x616263_d");
+    typedef bit_literal_chars<'0'> chars;
+};
+
+template<char... rest>
+struct hex_literal<'0', 'x', rest...> : hex_literal_digits<bit_literal_chars<>, rest...> {};
+
+template<char... rest>
+struct hex_literal<'0', 'X', rest...> : hex_literal_digits<bit_literal_chars<>, rest...> {};
+
+
+/**
+ * @return The byte starting at char @a first of a binary literal, missing chars are zeros
+ */
+constexpr uint8_t binary_literal_byte(const char* chars, uint32_t length, uint32_t first, uint32_t bit = 0) {
+    return (bit == 8 || first + bit >= length) ? 0 :
+           uint8_t((chars[first + bit] == '1' ? 0x80u >> bit : 0u) |
+                   binary_literal_byte(chars, length, first, bit + 1));
+}
+
+constexpr uint8_t hex_literal_digit(char c) {
+    return (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : c - 'A' + 10;
+}
+
+/**
+ * @return The byte made of digits @a first and @a first + 1 of a hexadecimal literal, a missing digit is zero
+ */
+constexpr uint8_t hex_literal_byte(const char* chars, uint32_t length, uint32_t first) {
+    return uint8_t((hex_literal_digit(chars[first]) << 4) |
+                   (first + 1 < length ? hex_literal_digit(chars[first + 1]) : 0));
+}
+
+template<typename chars, uint32_t... indices>
+constexpr static_bit_string<chars::size> make_binary_literal(bit_literal_indices<indices...>) {
+    return static_bit_string<chars::size>(static_bit_string_bytes_tag(), chars::size,
+                                          binary_literal_byte(chars::value, chars::size, indices * 8)...);
+}
+
+template<typename chars, uint32_t... indices>
+constexpr static_bit_string<chars::size * 4> make_hex_literal(bit_literal_indices<indices...>) {
+    return static_bit_string<chars::size * 4>(static_bit_string_bytes_tag(), chars::size * 4,
+                                              hex_literal_byte(chars::value, chars::size, indices * 2)...);
+}
+
+
+/**
+ * User Defined Literal (UDL) to convert a numeric literal of bits to %static_bit_string at compile time. <br>
+ * Each digit is a bit, so only '0' and '1' are accepted, any other digit is a compile error.<br>
+ * Digit separators (C++14) are ignored.<br>
+ *
+ * @example constexpr auto bits = 101010_b ;
+ * @example static_assert((1010'0110_b).size() == 8, "") ;
+ */
+template<char... digits>
+constexpr static_bit_string<binary_literal<bit_literal_chars<>, digits...>::chars::size> operator "" _b() {
+    typedef typename binary_literal<bit_literal_chars<>, digits...>::chars literal;
+    return make_binary_literal<literal>(typename make_bit_literal_indices<(literal::size + 7) / 8>::type());
+}
+
+
+/**
+ * User Defined Literal (UDL) to convert a numeric literal of bits to %static_bit_string at compile time.
+ * @see operator "" _b()
+ */
+template<char... digits>
+constexpr static_bit_string<binary_literal<bit_literal_chars<>, digits...>::chars::size> operator "" _B() {
+    return operator "" _b<digits...>();
+}
+
+
+/**
+ * User Defined Literal (UDL) to convert a hexadecimal literal of data to %static_bit_string at compile time. <br>
+ * Each hexadecimal digit is 4 bits, and leading zeros are kept.<br>
+ * i.e. 0x616263_d is [01100001 01100010 01100011] which is the same as "abc"_d.<br>
+ *
+ * @example constexpr auto bits = 0x616263_d ;
+ * @example static_assert((0x0F_d).size() == 8, "") ;
+ */
+template<char... digits>
+constexpr static_bit_string<hex_literal<digits...>::chars::size * 4> operator "" _d() {
+    typedef typename hex_literal<digits...>::chars literal;
+    return make_hex_literal<literal>(typename make_bit_literal_indices<(literal::size + 1) / 2>::type());
+}
+
+
+/**
+ * User Defined Literal (UDL) to convert a hexadecimal literal of data to %static_bit_string at compile time.
+ * @see operator "" _d()
+ */
+template<char... digits>
+constexpr static_bit_string<hex_literal<digits...>::chars::size * 4> operator "" _D() {
+    return operator "" _d<digits...>();
+}
+
+#endif //STATIC_BIT_STRING_H
@@ -0,0 +1,1237 @@
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "atomic_bit_string.h"
+#include "bit_matrix.h"
+#include "bit_rope.h"
+#include "bit_string.h"
+#include "bit_string_sort.h"
+#include "bloom_filter.h"
+#include "crc.h"
+#include "elias_fano.h"
+#include "fingerprint_search.h"
+#include "gf2.h"
+#include "huffman_code.h"
+#include "integer_codes.h"
+#include "packed_int_vector.h"
+#include "shared_bit_string.h"
+#include "static_bit_string.h"
+
+/*====================================================================================================================*/
+/*----------------------------------------------------- Harness ------------------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * Prevent the compiler from optimizing away a computed value
+ */
+template<typename T>
+void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct benchmark_result {
+    std::string name;
+    std::string implementation;
+    uint64_t size_in_bits;
+    uint32_t offset;
+    uint64_t iterations;
+    double ns_per_op;
+    double gb_per_second;
+};
+
+struct benchmark_options {
+    uint64_t max_bits = 1ull << 30;
+    double min_time_in_seconds = 0.2;
+    std::string filter;
+    std::string json_path;
+    std::string simd_level;
+};
+
+static benchmark_options options;
+static std::vector<benchmark_result> results;
+
+/**
+ * Runs @a operation repeatedly, doubling the number of iterations until the total time exceeds the minimum time.
+ *
+ * @param name Name of the measured operation (i.e. "substr")
+ * @param implementation Name of the container under test (i.e. "bit_string", "std::vector<bool>")
+ * @param size_in_bits Number of bits processed by a single operation
+ * @param offset Bit offset of the operation (0 for byte aligned operations)
+ * @param operation The operation to measure, it is called once per iteration
+ */
+void run_benchmark(const std::string& name, const std::string& implementation, uint64_t size_in_bits, uint32_t offset,
+                   const std::function<void()>& operation) {
+    if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+        return;
+
+    typedef std::chrono::steady_clock clock;
+
+    operation(); // Warm up caches and allocator
+
+    uint64_t iterations = 1;
+    double elapsed_ns = 0;
+    while (true) {
+        auto start = clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            operation();
+        }
+        auto end = clock::now();
+        elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+        if (elapsed_ns >= options.min_time_in_seconds * 1e9 || iterations >= (1ull << 40))
+            break;
+
+        // Estimate the required iterations to reach the minimum time, but do not grow too fast
+        double estimate = options.min_time_in_seconds * 1e9 / std::max(elapsed_ns, 1.0) * iterations * 1.2;
+        iterations = std::max<uint64_t>(iterations * 2, std::min<double>(estimate, iterations * 100.0));
+    }
+
+    benchmark_result result;
+    result.name = name;
+    result.implementation = implementation;
+    result.size_in_bits = size_in_bits;
+    result.offset = offset;
+    result.iterations = iterations;
+    result.ns_per_op = elapsed_ns / iterations;
+    result.gb_per_second = (size_in_bits / 8.0) / result.ns_per_op; // bytes per ns == GB/s
+    results.push_back(result);
+
+    fprintf(stderr, "%-16s %-20s %12llu bits  offset %u  %14.2f ns/op  %8.3f GB/s\n", name.c_str(),
+            implementation.c_str(), (unsigned long long) size_in_bits, offset, result.ns_per_op, result.gb_per_second);
+}
+
+void write_json(FILE* output) {
+    fprintf(output, "{\n  \"simd_level\": \"%s\",\n  \"benchmarks\": [\n",
+            cpu_features::level_name(bit_kernels::active_level()));
+    for (size_t i = 0; i < results.size(); ++i) {
+        const benchmark_result& r = results[i];
+        fprintf(output, "    {\"name\": \"%s\", \"implementation\": \"%s\", \"size_in_bits\": %llu, \"offset\": %u, "
+                        "\"iterations\": %llu, \"ns_per_op\": %.3f, \"gb_per_second\": %.6f}%s\n",
+                r.name.c_str(), r.implementation.c_str(), (unsigned long long) r.size_in_bits, r.offset,
+                (unsigned long long) r.iterations, r.ns_per_op, r.gb_per_second, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(output, "  ]\n}\n");
+}
+
+/*====================================================================================================================*/
+/*------------------------------------------------------ Inputs ------------------------------------------------------*/
+/*====================================================================================================================*/
+
+std::string random_bits_string(uint64_t size_in_bits) {
+    std::mt19937_64 generator(size_in_bits);
+    std::string str(size_in_bits, '0');
+    for (uint64_t i = 0; i < size_in_bits; i += 64) {
+        uint64_t value = generator();
+        for (uint64_t j = i; j < std::min(size_in_bits, i + 64); ++j, value >>= 1) {
+            str[j] = (value & 1u) ? '1' : '0';
+        }
+    }
+    return str;
+}
+
+/*====================================================================================================================*/
+/*---------------------------------------------- bit_string benchmarks -----------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_bit_string(uint64_t size_in_bits) {
+    const std::string name = "bit_string";
+    const std::string str = random_bits_string(size_in_bits + bit_string::BYTE);
+    const bit_string source = bit_string::from_string(str);
+    const bit_string operand = source.substr(0, size_in_bits);
+
+    run_benchmark("push_back", name, size_in_bits, 0, [&]() {
+        bit_string bits;
+        for (uint64_t i = 0; i < size_in_bits; ++i) {
+            bits.push_back(i & 1u);
+        }
+        do_not_optimize(bits.data());
+    });
+
+    run_benchmark("append_uint", name, size_in_bits, 0, [&]() {
+        bit_string bits;
+        for (uint64_t i = 0; i + 13 <= size_in_bits; i += 13) {
+            bits.append_uint_32(uint32_t(i), 13);
+        }
+        do_not_optimize(bits.data());
+    });
+
+    for (uint32_t offset : {0u, 3u}) {
+        run_benchmark("append", name, size_in_bits, offset, [&]() {
+            bit_string bits(offset);
+            bits.append(operand);
+            do_not_optimize(bits.data());
+        });
+
+        run_benchmark("substr", name, size_in_bits, offset, [&]() {
+            bit_string bits = source.substr(offset, size_in_bits);
+            do_not_optimize(bits.data());
+        });
+    }
+
+    run_benchmark("to_string", name, size_in_bits, 0, [&]() {
+        std::string result = operand.to_string();
+        do_not_optimize(result.data());
+    });
+
+    run_benchmark("from_string", name, size_in_bits, 0, [&]() {
+        bit_string bits = bit_string::from_string(str, 0, size_in_bits);
+        do_not_optimize(bits.data());
+    });
+
+    run_benchmark("hash", name, size_in_bits, 0, [&]() {
+        size_t hash = std::hash<bit_string>()(operand);
+        do_not_optimize(hash);
+    });
+
+    run_benchmark("iterate", name, size_in_bits, 0, [&]() {
+        uint64_t count = 0;
+        for (bool bit : operand) {
+            count += bit;
+        }
+        do_not_optimize(count);
+    });
+
+    run_benchmark("count", name, size_in_bits, 0, [&]() {
+        do_not_optimize(operand.count());
+    });
+
+    bit_string result = operand;
+    run_benchmark("xor", name, size_in_bits, 0, [&]() {
+        result ^= operand;
+        do_not_optimize(result.data());
+    });
+
+    run_benchmark("reverse", name, size_in_bits, 0, [&]() {
+        result.reverse();
+        do_not_optimize(result.data());
+    });
+
+    run_benchmark("hamming_distance", name, size_in_bits, 0, [&]() {
+        do_not_optimize(hamming_distance(result, operand));
+    });
+
+    const bit_string sync_word = bit_string::from_uint_64(0xA5F00F5AC33Cull, 48);
+    run_benchmark("find", name, size_in_bits, 0, [&]() {
+        do_not_optimize(source.find(sync_word));
+    });
+}
+
+/*====================================================================================================================*/
+/*------------------------------------------- std::vector<bool> benchmarks -------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_vector_bool(uint64_t size_in_bits) {
+    const std::string name = "std::vector<bool>";
+    const std::string str = random_bits_string(size_in_bits + bit_string::BYTE);
+    std::vector<bool> source(str.size());
+    for (size_t i = 0; i < str.size(); ++i) {
+        source[i] = str[i] == '1';
+    }
+    const std::vector<bool> operand(source.begin(), source.begin() + size_in_bits);
+
+    run_benchmark("push_back", name, size_in_bits, 0, [&]() {
+        std::vector<bool> bits;
+        for (uint64_t i = 0; i < size_in_bits; ++i) {
+            bits.push_back(i & 1u);
+        }
+        do_not_optimize(bits.size());
+    });
+
+    for (uint32_t offset : {0u, 3u}) {
+        run_benchmark("append", name, size_in_bits, offset, [&]() {
+            std::vector<bool> bits(offset);
+            bits.insert(bits.end(), operand.begin(), operand.end());
+            do_not_optimize(bits.size());
+        });
+
+        run_benchmark("substr", name, size_in_bits, offset, [&]() {
+            std::vector<bool> bits(source.begin() + offset, source.begin() + offset + size_in_bits);
+            do_not_optimize(bits.size());
+        });
+    }
+
+    run_benchmark("to_string", name, size_in_bits, 0, [&]() {
+        std::string result;
+        result.reserve(operand.size());
+        for (bool bit : operand) {
+            result.push_back(bit ? '1' : '0');
+        }
+        do_not_optimize(result.data());
+    });
+
+    run_benchmark("from_string", name, size_in_bits, 0, [&]() {
+        std::vector<bool> bits;
+        bits.reserve(size_in_bits);
+        for (uint64_t i = 0; i < size_in_bits; ++i) {
+            bits.push_back(str[i] == '1');
+        }
+        do_not_optimize(bits.size());
+    });
+
+    run_benchmark("hash", name, size_in_bits, 0, [&]() {
+        size_t hash = std::hash<std::vector<bool>>()(operand);
+        do_not_optimize(hash);
+    });
+
+    run_benchmark("iterate", name, size_in_bits, 0, [&]() {
+        uint64_t count = 0;
+        for (bool bit : operand) {
+            count += bit;
+        }
+        do_not_optimize(count);
+    });
+
+    run_benchmark("count", name, size_in_bits, 0, [&]() {
+        do_not_optimize(std::count(operand.begin(), operand.end(), true));
+    });
+
+    std::vector<bool> result = operand;
+    run_benchmark("reverse", name, size_in_bits, 0, [&]() {
+        std::reverse(result.begin(), result.end());
+        do_not_optimize(result.size());
+    });
+}
+
+/*====================================================================================================================*/
+/*---------------------------------------------- std::bitset benchmarks ----------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * std::bitset has a fixed size, so only the operations that make sense for a fixed size container are measured.
+ */
+template<size_t N>
+void benchmark_bitset() {
+    if (N > options.max_bits)
+        return;
+
+    const std::string name = "std::bitset";
+    const std::string str = random_bits_string(N);
+    std::unique_ptr<std::bitset<N>> operand(new std::bitset<N>(str));
+
+    run_benchmark("push_back", name, N, 0, [&]() {
+        std::unique_ptr<std::bitset<N>> bits(new std::bitset<N>());
+        for (uint64_t i = 0; i < N; ++i) {
+            bits->set(i, i & 1u);
+        }
+        do_not_optimize(bits->count());
+    });
+
+    run_benchmark("to_string", name, N, 0, [&]() {
+        std::string result = operand->to_string();
+        do_not_optimize(result.data());
+    });
+
+    run_benchmark("from_string", name, N, 0, [&]() {
+        std::unique_ptr<std::bitset<N>> bits(new std::bitset<N>(str));
+        do_not_optimize(bits->count());
+    });
+
+    run_benchmark("hash", name, N, 0, [&]() {
+        size_t hash = std::hash<std::bitset<N>>()(*operand);
+        do_not_optimize(hash);
+    });
+
+    run_benchmark("iterate", name, N, 0, [&]() {
+        uint64_t count = 0;
+        for (size_t i = 0; i < N; ++i) {
+            count += (*operand)[i];
+        }
+        do_not_optimize(count);
+    });
+
+    run_benchmark("count", name, N, 0, [&]() {
+        do_not_optimize(operand->count());
+    });
+
+    std::unique_ptr<std::bitset<N>> result(new std::bitset<N>(*operand));
+    run_benchmark("xor", name, N, 0, [&]() {
+        *result ^= *operand;
+        do_not_optimize(result->count());
+    });
+}
+
+/*====================================================================================================================*/
+/*------------------------------------------- static_bit_string benchmarks -------------------------------------------*/
+/*====================================================================================================================*/
+
+template<uint32_t N>
+void benchmark_static_bit_string() {
+    if (N > options.max_bits)
+        return;
+
+    const std::string name = "static_bit_string";
+
+    run_benchmark("push_back", name, N, 0, [&]() {
+        static_bit_string<N> bits;
+        for (uint64_t i = 0; i < N; ++i) {
+            bits.push_back(i & 1u);
+        }
+        do_not_optimize(bits.data());
+    });
+
+    run_benchmark("append_uint", name, N, 0, [&]() {
+        static_bit_string<N> bits;
+        for (uint64_t i = 0; i + 13 <= N; i += 13) {
+            bits.append_uint_32(uint32_t(i), 13);
+        }
+        do_not_optimize(bits.data());
+    });
+}
+
+/*====================================================================================================================*/
+/*------------------------------------------- packed_int_vector benchmarks -------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_packed_int_vector(uint64_t size_in_bits) {
+    const std::string name = "packed_int_vector";
+    const uint32_t width = 13;
+    const uint32_t number_of_elements = size_in_bits / width;
+
+    std::vector<uint64_t> values(number_of_elements);
+    std::mt19937_64 generator(size_in_bits);
+    for (uint64_t& value : values) {
+        value = generator() & ((1u << width) - 1);
+    }
+
+    packed_int_vector vector(width);
+    vector.append(values.data(), number_of_elements);
+
+    bit_string bits;
+    for (uint64_t value : values) {
+        bits.append_uint_32(uint32_t(value), width);
+    }
+
+    run_benchmark("push_back", name, size_in_bits, 0, [&]() {
+        packed_int_vector packed(width);
+        for (uint64_t value : values) {
+            packed.push_back(value);
+        }
+        do_not_optimize(packed.bits().data());
+    });
+
+    run_benchmark("get", name, size_in_bits, 0, [&]() {
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < number_of_elements; ++i) {
+            sum += vector[i];
+        }
+        do_not_optimize(sum);
+    });
+
+    run_benchmark("get", "bit_string substr to_uint", size_in_bits, 0, [&]() {
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < number_of_elements; ++i) {
+            sum += bits.substr(i * width, width).to_uint_32();
+        }
+        do_not_optimize(sum);
+    });
+
+    run_benchmark("unpack", name, size_in_bits, 0, [&]() {
+        std::vector<uint64_t> out(number_of_elements);
+        vector.unpack(0, number_of_elements, out.data());
+        do_not_optimize(out.data());
+    });
+
+    run_benchmark("pack", name, size_in_bits, 0, [&]() {
+        vector.pack(0, number_of_elements, values.data());
+        do_not_optimize(vector.bits().data());
+    });
+}
+
+/*====================================================================================================================*/
+/*----------------------------------------------- Bit rope benchmarks ------------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_bit_rope(uint64_t size_in_bits) {
+    const std::string name = "bit_rope";
+    const uint32_t number_of_fragments = 64;
+    const uint32_t fragment_bits = uint32_t(size_in_bits / number_of_fragments) - 3; // Not byte aligned
+
+    std::mt19937_64 generator(size_in_bits);
+    std::vector<std::shared_ptr<const bit_string>> fragments;
+    for (uint32_t i = 0; i < number_of_fragments; ++i) {
+        bit_string fragment;
+        for (uint32_t bit = 0; bit < fragment_bits; bit += 64) {
+            fragment.append_uint_64(generator(), std::min<uint32_t>(64, fragment_bits - bit));
+        }
+        fragments.push_back(std::make_shared<const bit_string>(std::move(fragment)));
+    }
+    const uint64_t total_bits = uint64_t(fragment_bits) * number_of_fragments;
+
+    run_benchmark("assemble", name + " append flatten", total_bits, 0, [&]() {
+        bit_rope rope;
+        for (const std::shared_ptr<const bit_string>& fragment : fragments) {
+            rope.append(fragment);
+        }
+        do_not_optimize(rope.flatten().data());
+    });
+
+    run_benchmark("assemble", "bit_string append", total_bits, 0, [&]() {
+        bit_string bits;
+        for (const std::shared_ptr<const bit_string>& fragment : fragments) {
+            bits.append(*fragment);
+        }
+        do_not_optimize(bits.data());
+    });
+
+    bit_rope rope;
+    for (const std::shared_ptr<const bit_string>& fragment : fragments) {
+        rope.append(fragment);
+    }
+    const uint64_t middle = total_bits / 2 + 5;
+
+    run_benchmark("substr", name, 64, 5, [&]() {
+        do_not_optimize(rope.substr(middle, 64).number_of_chunks());
+    });
+}
+
+/*====================================================================================================================*/
+/*------------------------------------------- Shared bit string benchmarks -------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_shared_bit_string(uint64_t size_in_bits) {
+    const std::string name = "shared_bit_string";
+
+    std::mt19937_64 generator(size_in_bits);
+    bit_string bits;
+    for (uint64_t i = 0; i < size_in_bits; i += 64) {
+        bits.append_uint_64(generator(), 64);
+    }
+    const shared_bit_string shared(bits);
+    const uint32_t start = uint32_t(size_in_bits / 4) & ~7u;
+    const uint32_t length = uint32_t(size_in_bits / 2);
+
+    run_benchmark("copy", name, size_in_bits, 0, [&]() {
+        shared_bit_string copy = shared;
+        do_not_optimize(copy.data());
+    });
+
+    run_benchmark("copy", "bit_string", size_in_bits, 0, [&]() {
+        bit_string copy = bits;
+        do_not_optimize(copy.data());
+    });
+
+    run_benchmark("substr", name, length, 0, [&]() {
+        do_not_optimize(shared.substr(start, length).data());
+    });
+}
+
+/*====================================================================================================================*/
+/*------------------------------------------- Atomic bit string benchmarks -------------------------------------------*/
+/*====================================================================================================================*/
+
+/**
+ * Runs @a work(thread_index) on @a number_of_threads threads and waits for all of them
+ */
+template<typename Work>
+void run_threads(uint32_t number_of_threads, Work work) {
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < number_of_threads; ++i) {
+        threads.emplace_back(work, i);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void benchmark_atomic_bit_string(uint64_t size_in_bits) {
+    const std::string name = "atomic_bit_string";
+    const uint32_t number_of_threads = std::max(1u, std::min(8u, std::thread::hardware_concurrency()));
+    const uint64_t operations_per_thread = std::max<uint64_t>(size_in_bits / number_of_threads, 1024);
+
+    // Every thread visits random nodes, about a third of them are visited twice
+    std::mt19937_64 generator(size_in_bits);
+    std::vector<std::vector<uint32_t>> positions(number_of_threads);
+    for (std::vector<uint32_t>& thread_positions : positions) {
+        for (uint64_t i = 0; i < operations_per_thread; ++i) {
+            thread_positions.push_back(uint32_t(generator() % size_in_bits));
+        }
+    }
+    const uint64_t total_operations = operations_per_thread * number_of_threads;
+    const std::string threads = " " + std::to_string(number_of_threads) + " threads";
+
+    atomic_bit_string visited(static_cast<uint32_t>(size_in_bits));
+    run_benchmark("test_and_set", name + threads, total_operations, 0, [&]() {
+        visited.clear(std::memory_order_relaxed);
+        run_threads(number_of_threads, [&](uint32_t thread) {
+            uint64_t first_visits = 0;
+            for (uint32_t position : positions[thread]) {
+                first_visits += !visited.test_and_set(position, std::memory_order_relaxed);
+            }
+            do_not_optimize(first_visits);
+        });
+    });
+
+    bit_string locked_visited(static_cast<uint32_t>(size_in_bits), false);
+    std::mutex mutex;
+    run_benchmark("test_and_set", "bit_string mutex" + threads, total_operations, 0, [&]() {
+        locked_visited.reset();
+        run_threads(number_of_threads, [&](uint32_t thread) {
+            uint64_t first_visits = 0;
+            for (uint32_t position : positions[thread]) {
+                std::lock_guard<std::mutex> lock(mutex);
+                first_visits += !locked_visited[position];
+                locked_visited[position] = true;
+            }
+            do_not_optimize(first_visits);
+        });
+    });
+}
+
+/*====================================================================================================================*/
+/*-------------------------------------------- Bloom filter benchmarks -----------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_bloom_filter(uint64_t size_in_bits) {
+    const std::string name = "blocked_bloom_filter";
+    const uint32_t number_of_hashes = 7;
+    const uint64_t number_of_keys = size_in_bits / 10;
+    const uint64_t number_of_lookups = 1u << 16;
+
+    std::mt19937_64 generator(size_in_bits);
+    std::vector<uint64_t> keys(number_of_keys);
+    std::vector<uint64_t> lookups(number_of_lookups);
+    for (uint64_t& key : keys) {
+        key = generator();
+    }
+    for (uint64_t i = 0; i < number_of_lookups; ++i) {
+        lookups[i] = i % 2 ? keys[generator() % number_of_keys] : generator();
+    }
+    std::unique_ptr<bool[]> results(new bool[number_of_lookups]);
+
+    blocked_bloom_filter filter(size_in_bits, number_of_hashes);
+    filter.insert(keys.data(), keys.size());
+    run_benchmark("bloom_contains", name, number_of_lookups * 64, 0, [&]() {
+        do_not_optimize(filter.contains(lookups.data(), number_of_lookups, results.get()));
+    });
+
+    // A classic filter probing k random bits of the whole bit_string with double hashing
+    bit_string bits(static_cast<uint32_t>(size_in_bits), false);
+    auto probe = [&](uint64_t key, bool insert) {
+        const uint64_t hash = std::hash<uint64_t>()(key) * 0x9E3779B97F4A7C15ull;
+        const uint64_t step = (hash >> 32) | 1;
+        bool found = true;
+        for (uint32_t i = 0; i < number_of_hashes; ++i) {
+            const uint32_t position = uint32_t((uint32_t(hash) + i * step) % size_in_bits);
+            if (insert)
+                bits[position] = true;
+            else
+                found = found && bits[position];
+        }
+        return found;
+    };
+    for (uint64_t key : keys) {
+        probe(key, true);
+    }
+    run_benchmark("bloom_contains", "bit_string operator[]", number_of_lookups * 64, 0, [&]() {
+        uint64_t found = 0;
+        for (uint64_t key : lookups) {
+            found += probe(key, false);
+        }
+        do_not_optimize(found);
+    });
+}
+
+/*====================================================================================================================*/
+/*--------------------------------------------- Elias-Fano benchmarks ------------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_elias_fano(uint64_t size_in_bits) {
+    const std::string name = "elias_fano_sequence";
+    const uint64_t number_of_queries = 1u << 12;
+
+    // Sorted ids of a universe of size_in_bits with densities 1/16 and 1/256, as the posting lists of two terms
+    std::mt19937_64 generator(size_in_bits);
+    std::vector<uint64_t> dense;
+    std::vector<uint64_t> sparse;
+    for (uint64_t id = 0; id < size_in_bits; ++id) {
+        if (generator() % 16 == 0)
+            dense.push_back(id);
+        if (generator() % 256 == 0)
+            sparse.push_back(id);
+    }
+    std::vector<uint64_t> queries(number_of_queries);
+    for (uint64_t& query : queries) {
+        query = generator() % size_in_bits;
+    }
+
+    const elias_fano_sequence dense_sequence(dense.data(), dense.size(), size_in_bits);
+    const elias_fano_sequence sparse_sequence(sparse.data(), sparse.size(), size_in_bits);
+
+    run_benchmark("elias_fano_access", name, number_of_queries * 64, 0, [&]() {
+        uint64_t sum = 0;
+        for (uint64_t query : queries) {
+            sum += dense_sequence.access(query % dense.size());
+        }
+        do_not_optimize(sum);
+    });
+    run_benchmark("elias_fano_next_geq", name, number_of_queries * 64, 0, [&]() {
+        uint64_t sum = 0;
+        for (uint64_t query : queries) {
+            sum += dense_sequence.next_geq(query);
+        }
+        do_not_optimize(sum);
+    });
+    run_benchmark("elias_fano_next_geq", "std::vector std::lower_bound", number_of_queries * 64, 0, [&]() {
+        uint64_t sum = 0;
+        for (uint64_t query : queries) {
+            const auto it = std::lower_bound(dense.begin(), dense.end(), query);
+            sum += it == dense.end() ? elias_fano_sequence::npos : *it;
+        }
+        do_not_optimize(sum);
+    });
+    run_benchmark("elias_fano_iterate", name, dense.size() * 64, 0, [&]() {
+        uint64_t sum = 0;
+        for (uint64_t value : dense_sequence) {
+            sum += value;
+        }
+        do_not_optimize(sum);
+    });
+    run_benchmark("elias_fano_intersection", name, (dense.size() + sparse.size()) * 64, 0, [&]() {
+        do_not_optimize(intersection(dense_sequence, sparse_sequence).size());
+    });
+    run_benchmark("elias_fano_intersection", "std::vector std::set_intersection", (dense.size() + sparse.size()) * 64,
+                  0, [&]() {
+        std::vector<uint64_t> common;
+        std::set_intersection(dense.begin(), dense.end(), sparse.begin(), sparse.end(), std::back_inserter(common));
+        do_not_optimize(common.size());
+    });
+}
+
+/*====================================================================================================================*/
+/*--------------------------------------------- Bit matrix benchmarks ------------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_bit_matrix(uint64_t size_in_bits) {
+    const std::string name = "bit_matrix";
+    uint32_t n = 1;
+    while (uint64_t(n) * n * 4 <= size_in_bits) {
+        n *= 2;
+    }
+
+    std::mt19937_64 generator(size_in_bits);
+    bit_matrix matrix(n, n);
+    std::vector<bit_string> rows(n, bit_string(n, false));
+    for (uint32_t r = 0; r < n; ++r) {
+        for (uint32_t c = 0; c < n; c += 64) {
+            const uint32_t length = n - c < 64 ? n - c : 64;
+            const uint64_t bits = generator();
+            matrix.row(r).set_bits(c, length, bits);
+            rows[r].set_bits(c, length, bits);
+        }
+    }
+
+    run_benchmark("matrix_transpose", name, uint64_t(n) * n, 0, [&]() {
+        do_not_optimize(matrix.transposed().count());
+    });
+    run_benchmark("matrix_transpose", "std::vector<bit_string>", uint64_t(n) * n, 0, [&]() {
+        std::vector<bit_string> columns(n, bit_string(n, false));
+        for (uint32_t r = 0; r < n; ++r) {
+            for (uint32_t c = 0; c < n; ++c) {
+                columns[c][r] = rows[r].at(c);
+            }
+        }
+        do_not_optimize(columns[n - 1].count());
+    });
+
+    run_benchmark("matrix_column", name, n, 0, [&]() {
+        do_not_optimize(matrix.column(n / 2).count());
+    });
+    run_benchmark("matrix_column", "std::vector<bit_string>", n, 0, [&]() {
+        bit_string column;
+        column.reserve(n);
+        for (const bit_string& row : rows) {
+            column.push_back(row.at(n / 2));
+        }
+        do_not_optimize(column.count());
+    });
+}
+
+/*====================================================================================================================*/
+/*------------------------------------------------- GF(2) benchmarks -------------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_gf2(uint64_t size_in_bits) {
+    const std::string name = "gf2";
+    uint32_t n = 1;
+    while (uint64_t(n) * n * 4 <= size_in_bits) {
+        n *= 2;
+    }
+
+    std::mt19937_64 generator(size_in_bits);
+    bit_matrix a(n, n);
+    bit_matrix b(n, n);
+    for (uint32_t r = 0; r < n; ++r) {
+        for (uint32_t c = 0; c < n; c += 64) {
+            const uint32_t length = n - c < 64 ? n - c : 64;
+            a.row(r).set_bits(c, length, generator());
+            b.row(r).set_bits(c, length, generator());
+        }
+    }
+    std::vector<bit_string> a_rows(n);
+    std::vector<bit_string> b_rows(n);
+    for (uint32_t r = 0; r < n; ++r) {
+        a_rows[r] = a.row(r).to_bit_string();
+        b_rows[r] = b.row(r).to_bit_string();
+    }
+
+    run_benchmark("gf2_multiply", name, uint64_t(n) * n, 0, [&]() {
+        do_not_optimize(gf2::multiply(a, b).count());
+    });
+    run_benchmark("gf2_multiply", "std::vector<bit_string> ^=", uint64_t(n) * n, 0, [&]() {
+        std::vector<bit_string> product(n, bit_string(n, false));
+        for (uint32_t i = 0; i < n; ++i) {
+            for (uint32_t k = 0; k < n; ++k) {
+                if (a_rows[i][k])
+                    product[i] ^= b_rows[k];
+            }
+        }
+        do_not_optimize(product[n - 1].count());
+    });
+
+    run_benchmark("gf2_row_reduce", name, uint64_t(n) * n, 0, [&]() {
+        do_not_optimize(gf2::rank(a));
+    });
+    run_benchmark("gf2_row_reduce", "std::vector<bit_string> ^=", uint64_t(n) * n, 0, [&]() {
+        std::vector<bit_string> rows = a_rows;
+        uint32_t rank = 0;
+        for (uint32_t column = 0; column < n && rank < n; ++column) {
+            uint32_t pivot = rank;
+            while (pivot < n && !rows[pivot][column]) {
+                ++pivot;
+            }
+            if (pivot == n)
+                continue;
+            std::swap(rows[pivot], rows[rank]);
+            for (uint32_t i = 0; i < n; ++i) {
+                if (i != rank && rows[i][column])
+                    rows[i] ^= rows[rank];
+            }
+            ++rank;
+        }
+        do_not_optimize(rank);
+    });
+}
+
+/*====================================================================================================================*/
+/*-------------------------------------------------- CRC benchmarks --------------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_crc(uint64_t size_in_bits) {
+    const std::string name = "crc_engine";
+    std::mt19937_64 generator(size_in_bits);
+    bit_string bits;
+    lsb_bit_string lsb_bits;
+    bits.reserve(uint32_t(size_in_bits));
+    lsb_bits.reserve(uint32_t(size_in_bits));
+    for (uint64_t i = 0; i < size_in_bits; i += 64) {
+        const uint64_t word = generator();
+        bits.append_uint_64(word, 64);
+        lsb_bits.append_uint_64(word, 64);
+    }
+    const crc_engine crc32(CRC_32_ISO_HDLC);
+    const crc_engine crc64(CRC_64_ECMA_182);
+
+    run_benchmark("crc32", name, size_in_bits, 0, [&]() {
+        do_not_optimize(crc32.compute(lsb_bits));
+    });
+    run_benchmark("crc32", "crc_engine slicing-by-8", size_in_bits, 0, [&]() {
+        const simd_level level = bit_kernels::active_level();
+        bit_kernels::force_level(simd_level::scalar);
+        do_not_optimize(crc32.compute(lsb_bits));
+        bit_kernels::force_level(level);
+    });
+    run_benchmark("crc32", "crc_engine bit unaligned", size_in_bits, 0, [&]() {
+        do_not_optimize(crc32.finish(crc32.update(crc32.initial(), lsb_bits, 3, lsb_bits.size() - 8)));
+    });
+    run_benchmark("crc32", "bit by bit", size_in_bits, 0, [&]() {
+        uint64_t crc_register = crc32.initial();
+        for (bool bit : lsb_bits) {
+            crc_register = crc32.update_bit(crc_register, bit);
+        }
+        do_not_optimize(crc32.finish(crc_register));
+    });
+
+    run_benchmark("crc64", name, size_in_bits, 0, [&]() {
+        do_not_optimize(crc64.compute(bits));
+    });
+    run_benchmark("crc64", "crc_engine slicing-by-8", size_in_bits, 0, [&]() {
+        const simd_level level = bit_kernels::active_level();
+        bit_kernels::force_level(simd_level::scalar);
+        do_not_optimize(crc64.compute(bits));
+        bit_kernels::force_level(level);
+    });
+}
+
+/*====================================================================================================================*/
+/*--------------------------------------------- bit_string sort benchmarks -------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_bit_string_sort(uint64_t size_in_bits) {
+    const std::string name = "bit_string_sort";
+    const uint64_t count = size_in_bits / 64;
+
+    // Keys of 16 to 143 bits sharing one of 64 prefixes of 24 bits, as the keys of a trie
+    std::mt19937_64 generator(size_in_bits);
+    std::vector<bit_string> keys(count);
+    for (bit_string& key : keys) {
+        const uint32_t length = 16 + generator() % 128;
+        key.append_uint_64(generator() % 64, 24);
+        while (key.size() < length) {
+            key.append_uint_64(generator(), length - key.size() < 64 ? length - key.size() : 64);
+        }
+    }
+    const uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    run_benchmark("sort_bit_strings", name, size_in_bits, 0, [&]() {
+        std::vector<bit_string> sorted = keys;
+        bit_string_sort::sort(sorted);
+        do_not_optimize(sorted.front().size());
+    });
+    run_benchmark("sort_bit_strings", name + " " + std::to_string(threads) + " threads", size_in_bits, 0, [&]() {
+        std::vector<bit_string> sorted = keys;
+        bit_string_sort::sort(sorted, threads);
+        do_not_optimize(sorted.front().size());
+    });
+    run_benchmark("sort_bit_strings", "std::sort bit_string_sort::less", size_in_bits, 0, [&]() {
+        std::vector<bit_string> sorted = keys;
+        std::sort(sorted.begin(), sorted.end(), bit_string_sort::less());
+        do_not_optimize(sorted.front().size());
+    });
+    run_benchmark("sort_bit_strings", "std::sort bit by bit", size_in_bits, 0, [&]() {
+        std::vector<bit_string> sorted = keys;
+        std::sort(sorted.begin(), sorted.end(), [](const bit_string& a, const bit_string& b) {
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+        });
+        do_not_optimize(sorted.front().size());
+    });
+
+    std::vector<bit_string> sorted = keys;
+    bit_string_sort::sort(sorted);
+    run_benchmark("group_by_prefix", name, size_in_bits, 0, [&]() {
+        do_not_optimize(bit_string_sort::group_by_prefix(sorted, 32).size());
+    });
+}
+
+/*====================================================================================================================*/
+/*------------------------------------------ Fingerprint search benchmarks -------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_fingerprint_search(uint64_t size_in_bits) {
+    const std::string name = "nearest_fingerprints";
+    const uint32_t fingerprint_bits = 256;
+    const uint32_t fingerprint_bytes = fingerprint_bits / bit_string::BYTE;
+    const uint64_t number_of_fingerprints = size_in_bits / fingerprint_bits;
+    const uint32_t k = 10;
+
+    std::mt19937_64 generator(size_in_bits);
+    std::vector<bit_string> fingerprints(number_of_fingerprints);
+    std::vector<uint8_t> database(number_of_fingerprints * fingerprint_bytes);
+    for (uint64_t i = 0; i < number_of_fingerprints; ++i) {
+        for (uint32_t word = 0; word < fingerprint_bits / 64; ++word) {
+            fingerprints[i].append_uint_64(generator(), 64);
+        }
+        memcpy(&database[i * fingerprint_bytes], fingerprints[i].data(), fingerprint_bytes);
+    }
+    bit_string query;
+    for (uint32_t word = 0; word < fingerprint_bits / 64; ++word) {
+        query.append_uint_64(generator(), 64);
+    }
+
+    run_benchmark("top_k", name, size_in_bits, 0, [&]() {
+        do_not_optimize(nearest_fingerprints(query, database.data(), number_of_fingerprints, k).data());
+    });
+
+    run_benchmark("top_k", "bit_string hamming_distance sort", size_in_bits, 0, [&]() {
+        std::vector<fingerprint_match> matches(number_of_fingerprints);
+        for (uint64_t i = 0; i < number_of_fingerprints; ++i) {
+            matches[i] = {i, hamming_distance(query, fingerprints[i])};
+        }
+        std::partial_sort(matches.begin(), matches.begin() + std::min<uint64_t>(k, matches.size()), matches.end());
+        do_not_optimize(matches.data());
+    });
+}
+
+/*====================================================================================================================*/
+/*-------------------------------------------- Integer codes benchmarks ----------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_integer_codes(uint64_t size_in_bits) {
+    const std::string name = "integer_codes";
+    const elias_gamma_code gamma;
+    const rice_code rice(4);
+    const leb128_code leb128;
+
+    // Gaps of a posting list, mostly small with a long tail
+    std::mt19937_64 generator(size_in_bits);
+    std::vector<uint64_t> values;
+    bit_string encoded;
+    while (encoded.size() < size_in_bits) {
+        const uint64_t value = 1 + (generator() >> (50 + generator() % 14));
+        values.push_back(value);
+        gamma.append(encoded, value);
+    }
+    const uint64_t count = values.size();
+    const uint64_t encoded_bits = encoded.size();
+
+    bit_string rice_encoded;
+    append_codes(rice, rice_encoded, values.data(), count);
+    bit_string leb128_encoded;
+    append_codes(leb128, leb128_encoded, values.data(), count);
+
+    run_benchmark("gamma_encode", name, encoded_bits, 0, [&]() {
+        bit_string bits;
+        append_codes(gamma, bits, values.data(), count);
+        do_not_optimize(bits.data());
+    });
+
+    run_benchmark("gamma_encode", "bit_string append_uint_32", encoded_bits, 0, [&]() {
+        bit_string bits;
+        for (uint64_t value : values) {
+            const uint32_t n = 63 - scalar_kernels::leading_zeros_64(value);
+            for (uint32_t i = 0; i < n; ++i) {
+                bits.push_back(false);
+            }
+            bits.append_uint_32(uint32_t(value), n + 1);
+        }
+        do_not_optimize(bits.data());
+    });
+
+    std::vector<uint64_t> decoded(count);
+
+    run_benchmark("gamma_decode", name, encoded_bits, 0, [&]() {
+        bit_reader reader(encoded);
+        read_codes(gamma, reader, decoded.data(), count);
+        do_not_optimize(decoded.data());
+    });
+
+    run_benchmark("gamma_decode", "bit_string at", encoded_bits, 0, [&]() {
+        uint32_t position = 0;
+        for (uint64_t i = 0; i < count; ++i) {
+            uint32_t n = 0;
+            while (!encoded.at(position++)) {
+                n++;
+            }
+            uint64_t value = 1;
+            for (uint32_t j = 0; j < n; ++j) {
+                value = (value << 1) | encoded.at(position++);
+            }
+            decoded[i] = value;
+        }
+        do_not_optimize(decoded.data());
+    });
+
+    run_benchmark("rice_decode", name, rice_encoded.size(), 0, [&]() {
+        bit_reader reader(rice_encoded);
+        read_codes(rice, reader, decoded.data(), count);
+        do_not_optimize(decoded.data());
+    });
+
+    run_benchmark("leb128_decode", name, leb128_encoded.size(), 0, [&]() {
+        bit_reader reader(leb128_encoded);
+        read_codes(leb128, reader, decoded.data(), count);
+        do_not_optimize(decoded.data());
+    });
+}
+
+/*====================================================================================================================*/
+/*---------------------------------------------- Huffman benchmarks --------------------------------------------------*/
+/*====================================================================================================================*/
+
+void benchmark_huffman(uint64_t size_in_bits) {
+    const std::string name = "huffman_code";
+    const uint32_t number_of_symbols = 256;
+    const uint64_t count = size_in_bits / 8;
+
+    // Bytes with a skewed distribution, about 4.5 bits of entropy per byte
+    std::mt19937_64 generator(size_in_bits);
+    std::vector<uint8_t> text(count);
+    for (uint8_t& symbol : text) {
+        symbol = uint8_t(std::min<uint64_t>(std::geometric_distribution<uint32_t>(0.08)(generator), 255));
+    }
+
+    const huffman_code code = huffman_code::from_frequencies(
+            huffman_code::count_frequencies(text.data(), count, number_of_symbols));
+    const huffman_encoder encoder(code);
+    const huffman_decoder decoder(code);
+    bit_string encoded;
+    encoder.encode(text.data(), count, encoded);
+
+    // Code tree walked a bit at a time, a node is a pair of children, leaves are ~symbol
+    std::vector<int32_t> tree(2, 0);
+    for (uint32_t symbol = 0; symbol < number_of_symbols; ++symbol) {
+        uint32_t node = 0;
+        const uint32_t length = code.code_length(symbol);
+        for (uint32_t i = 0; i < length; ++i) {
+            const uint32_t child = node + ((code.code(symbol) >> (length - 1 - i)) & 1u);
+            if (i + 1 == length) {
+                tree[child] = ~int32_t(symbol);
+            } else {
+                if (tree[child] == 0) {
+                    tree[child] = int32_t(tree.size());
+                    tree.resize(tree.size() + 2, 0);
+                }
+                node = uint32_t(tree[child]);
+            }
+        }
+    }
+
+    run_benchmark("huffman_encode", name, size_in_bits, 0, [&]() {
+        bit_string bits;
+        encoder.encode(text.data(), count, bits);
+        do_not_optimize(bits.data());
+    });
+
+    run_benchmark("huffman_encode", "bit_string append_uint_32", size_in_bits, 0, [&]() {
+        bit_string bits;
+        for (uint8_t symbol : text) {
+            bits.append_uint_32(code.code(symbol), code.code_length(symbol));
+        }
+        do_not_optimize(bits.data());
+    });
+
+    std::vector<uint8_t> decoded(count);
+
+    run_benchmark("huffman_decode", name, size_in_bits, 0, [&]() {
+        bit_reader reader(encoded);
+        decoder.read(reader, decoded.data(), count);
+        do_not_optimize(decoded.data());
+    });
+
+    run_benchmark("huffman_decode", "const_bit_iterator tree", size_in_bits, 0, [&]() {
+        bit_string::const_iterator it = encoded.cbegin();
+        for (uint64_t i = 0; i < count; ++i) {
+            int32_t node = 0;
+            do {
+                node = tree[node + *it++];
+            } while (node > 0);
+            decoded[i] = uint8_t(~node);
+        }
+        do_not_optimize(decoded.data());
+    });
+}
+
+/*====================================================================================================================*/
+/*------------------------------------------------------- Main -------------------------------------------------------*/
+/*====================================================================================================================*/
+
+void print_usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--max-bits=N] [--min-time=SECONDS] [--filter=NAME] [--json=PATH] [--simd=LEVEL]\n"
+                    "  --max-bits   Largest size to benchmark in bits (default 1073741824, i.e. 1 Gbit)\n"
+                    "  --min-time   Minimum measured time per benchmark in seconds (default 0.2)\n"
+                    "  --filter     Only run benchmarks whose name contains NAME\n"
+                    "  --json       Write JSON results to PATH instead of stdout\n"
+                    "  --simd       Force SIMD level of the bulk kernels (scalar, sse4.2, avx2 or avx512)\n", program);
+}
+
+bool parse_arguments(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        std::string value = argument.substr(argument.find('=') + 1);
+        if (argument.find("--max-bits=") == 0) {
+            options.max_bits = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (argument.find("--min-time=") == 0) {
+            options.min_time_in_seconds = std::strtod(value.c_str(), nullptr);
+        } else if (argument.find("--filter=") == 0) {
+            options.filter = value;
+        } else if (argument.find("--json=") == 0) {
+            options.json_path = value;
+        } else if (argument.find("--simd=") == 0) {
+            options.simd_level = value;
+        } else {
+            print_usage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (!parse_arguments(argc, argv))
+        return 1;
+
+    if (!options.simd_level.empty()) {
+        simd_level level;
+        if (!cpu_features::parse_level(options.simd_level.c_str(), level)) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        bit_kernels::force_level(level);
+    }
+
+    const uint64_t sizes[] = {8, 64, 512, 4096, 1ull << 16, 1ull << 20, 1ull << 24, 1ull << 30};
+
+    for (uint64_t size : sizes) {
+        if (size > options.max_bits)
+            break;
+        benchmark_bit_string(size);
+        benchmark_vector_bool(size);
+        if (size <= (1u << 24))
+            benchmark_packed_int_vector(size);
+        if (size >= 4096)
+            benchmark_bit_rope(size);
+        benchmark_shared_bit_string(size);
+        if (size >= (1u << 16) && size <= (1u << 24))
+            benchmark_atomic_bit_string(size);
+        if (size >= (1u << 16))
+            benchmark_bloom_filter(size);
+        if (size >= 4096 && size <= (1u << 24))
+            benchmark_elias_fano(size);
+        if (size >= 4096 && size <= (1u << 24))
+            benchmark_bit_matrix(size);
+        if (size >= 4096 && size <= (1u << 24))
+            benchmark_gf2(size);
+        if (size >= 4096 && size <= (1u << 24))
+            benchmark_crc(size);
+        if (size >= (1u << 16) && size <= (1u << 24))
+            benchmark_bit_string_sort(size);
+        if (size >= 4096 && size <= (1u << 24))
+            benchmark_fingerprint_search(size);
+        if (size >= 4096 && size <= (1u << 24))
+            benchmark_integer_codes(size);
+        if (size >= 4096 && size <= (1u << 24))
+            benchmark_huffman(size);
+    }
+
+    benchmark_static_bit_string<64>();
+    benchmark_static_bit_string<512>();
+    benchmark_static_bit_string<4096>();
+
+    benchmark_bitset<8>();
+    benchmark_bitset<64>();
+    benchmark_bitset<512>();
+    benchmark_bitset<4096>();
+    benchmark_bitset<(1u << 16)>();
+    benchmark_bitset<(1u << 20)>();
+    benchmark_bitset<(1u << 24)>();
+
+    if (options.json_path.empty()) {
+        write_json(stdout);
+    } else {
+        FILE* output = fopen(options.json_path.c_str(), "w");
+        if (!output) {
+            fprintf(stderr, "Can not open %s\n", options.json_path.c_str());
+            return 1;
+        }
+        write_json(output);
+        fclose(output);
+    }
+
+    return 0;
+}
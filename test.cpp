@@ -1,4 +1,1787 @@
-int main(){
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
+#include "bit_string.h"
+#include "atomic_bit_string.h"
+#include "bit_kernels.h"
+#include "bit_matrix.h"
+#include "bit_reader.h"
+#include "bit_rope.h"
+#include "bit_string_sort.h"
+#include "bloom_filter.h"
+#include "crc.h"
+#include "elias_fano.h"
+#include "fingerprint_search.h"
+#include "gf2.h"
+#include "huffman_code.h"
+#include "integer_codes.h"
+#include "packed_int_vector.h"
+#include "shared_bit_string.h"
+#include "static_bit_string.h"
+
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                    \
+    do {                                                                                    \
+        if (!(condition)) {                                                                 \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+            ++failures;                                                                     \
+        }                                                                                   \
+    } while (false)
+
+
+template<typename Exception, typename Function>
+static bool throws(Function function) {
+    try {
+        function();
+    } catch (const Exception&) {
+        return true;
+    } catch (...) {
+        return false;
+    }
+    return false;
+}
+
+
+/*====================================================================================================================*/
+/*------------------------------------------------- Integer Codes ----------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+template<typename Code>
+static std::string encoding_of(const Code& code, uint64_t value) {
+    bit_string bits;
+    code.append(bits, value);
+    return bits.to_string();
+}
+
+template<typename Code, typename BitOrder>
+static void check_round_trip(const Code& code, const std::vector<uint64_t>& values) {
+    basic_bit_string<BitOrder> bits;
+    append_codes(code, bits, values.data(), values.size());
+
+    uint64_t total = 0;
+    for (uint64_t value : values) {
+        total += code.length(value);
+    }
+    CHECK(bits.size() == total);
+
+    std::vector<uint64_t> decoded(values.size());
+    basic_bit_reader<BitOrder> reader(bits);
+    read_codes(code, reader, decoded.data(), decoded.size());
+    CHECK(decoded == values);
+    CHECK(reader.at_end());
+
+    basic_bit_reader<BitOrder> one_at_a_time(bits);
+    bool same = true;
+    for (uint64_t value : values) {
+        same = same && code.read(one_at_a_time) == value;
+    }
+    CHECK(same);
+}
+
+template<typename Code>
+static void check_round_trip(const Code& code, const std::vector<uint64_t>& values) {
+    check_round_trip<Code, msb_first>(code, values);
+    check_round_trip<Code, lsb_first>(code, values);
+}
+
+static void test_integer_codes() {
+    CHECK(encoding_of(elias_gamma_code(), 1) == "1");
+    CHECK(encoding_of(elias_gamma_code(), 9) == "0001001");
+    CHECK(encoding_of(elias_delta_code(), 1) == "1");
+    CHECK(encoding_of(elias_delta_code(), 9) == "00100001");
+    CHECK(encoding_of(rice_code(2), 9) == "00101");
+    CHECK(encoding_of(leb128_code(), 300) == "1010110000000010");
+
+    lsb_bit_string leb128;
+    leb128_code().append(leb128, 300);
+    CHECK(leb128.size() == 16 && leb128.data()[0] == 0xAC && leb128.data()[1] == 0x02);
+
+    CHECK(throws<std::domain_error>([] { bit_string bits; elias_gamma_code().append(bits, 0); }));
+
+    std::mt19937_64 random(42);
+    std::vector<uint64_t> small(10000);
+    std::vector<uint64_t> wide(10000);
+    for (uint64_t i = 0; i < small.size(); ++i) {
+        small[i] = 1 + random() % 1000;
+        wide[i] = 1 + (random() >> (random() % 64));
+    }
+    wide.push_back(UINT64_MAX);
+
+    check_round_trip(elias_gamma_code(), small);
+    check_round_trip(elias_gamma_code(), wide);
+    check_round_trip(elias_delta_code(), small);
+    check_round_trip(elias_delta_code(), wide);
+    check_round_trip(rice_code(4), small);
+    check_round_trip(rice_code(0), std::vector<uint64_t>{0, 1, 2, 100, 3});
+    check_round_trip(leb128_code(), small);
+    check_round_trip(leb128_code(), wide);
+}
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------- Static Bit String --------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+static void test_static_bit_string() {
+    constexpr static_bit_string<16> constant(static_bit_string_bytes_tag(), 4, 0xA0);
+    static_assert(constant.at(0) && !constant.at(1) && constant[2], "constexpr at() of static_bit_string");
+
+    static_bit_string<8> bits = static_bit_string<8>::from_string("10110");
+    CHECK(bits.substr(1, 3).to_string() == "011");
+    CHECK(bits.substr(5).size() == 0);
+    CHECK(bits.at(4) == false && bits[2] == true);
+
+    CHECK(throws<std::out_of_range>([] { static_bit_string<8>().substr(0, 100); }));
+    CHECK(throws<std::out_of_range>([&] { bits.substr(3, 3); }));
+    CHECK(throws<std::out_of_range>([&] { bits.substr(6); }));
+    CHECK(throws<std::out_of_range>([&] { bits.at(5); }));
+    CHECK(throws<std::out_of_range>([&] { bits[5] = true; }));
+    CHECK(throws<std::out_of_range>([] { static_bit_string<8>().back(); }));
+
+    // Appending to itself copies the bits it had before
+    static_bit_string<64> twice = static_bit_string<64>::from_string("10110011101");
+    twice.append(twice);
+    CHECK(twice.to_string() == "1011001110110110011101");
+    twice.append(twice);
+    CHECK(twice.to_string() == "10110011101101100111011011001110110110011101");
+    CHECK(throws<std::length_error>([&] { twice.append(twice); }));
+    CHECK(twice.size() == 44);
+}
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------- Shared Bit String --------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+static void test_shared_bit_string() {
+    const shared_bit_string frame(bit_string::from_string("1010011100001111"));
+    const shared_bit_string view = frame.substr(8, 4);
+    CHECK(view.to_bit_string().to_string() == "0000");
+    CHECK(view.at(3) == false && frame.substr(4).at(3) == true);
+
+    CHECK(throws<std::out_of_range>([&] { view.at(6); }));
+    CHECK(throws<std::out_of_range>([&] { view[4]; }));
+    CHECK(throws<std::out_of_range>([] { shared_bit_string().at(0); }));
+    CHECK(throws<std::out_of_range>([&] { frame.substr(17); }));
+    CHECK(throws<std::out_of_range>([&] { view.substr(2, 3); }));
+}
+
+
+/*====================================================================================================================*/
+/*-------------------------------------------------- SIMD Kernels ----------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+/**
+ * Call @a function with the kernels of every SIMD level the CPU supports forced, then restore the active level
+ */
+template<typename Function>
+static void for_each_level(Function function) {
+    const simd_level previous = bit_kernels::active_level();
+    for (simd_level level : {simd_level::scalar, simd_level::sse4_2, simd_level::avx2, simd_level::avx512}) {
+        if (bit_kernels::force_level(level) == level)
+            function(bit_kernels::get());
+    }
+    bit_kernels::force_level(previous);
+}
+
+static std::vector<uint8_t> random_bytes(std::mt19937_64& random, uint64_t length) {
+    std::vector<uint8_t> bytes(length);
+    for (uint8_t& byte : bytes) {
+        byte = uint8_t(random());
+    }
+    return bytes;
+}
+
+static void test_kernels() {
+    // Lengths around the widths of the SSE, AVX2 and AVX-512 loops, at unaligned offsets
+    const uint64_t lengths[] = {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 255, 256, 1000};
+    std::mt19937_64 random(27);
+
+    for_each_level([&](const bit_kernels& kernels) {
+        bool same = true;
+        for (uint64_t length : lengths) {
+            const uint64_t offset = random() % 4;
+            const std::vector<uint8_t> a = random_bytes(random, length + offset + 1);
+            const std::vector<uint8_t> b = random_bytes(random, length + offset + 1);
+
+            typedef void (*binary_kernel)(uint8_t*, const uint8_t*, uint64_t);
+            const binary_kernel binary[][2] = {{kernels.bitwise_and, scalar_kernels::bitwise_and},
+                                               {kernels.bitwise_or, scalar_kernels::bitwise_or},
+                                               {kernels.bitwise_xor, scalar_kernels::bitwise_xor}};
+            for (const auto& pair : binary) {
+                std::vector<uint8_t> result = a;
+                std::vector<uint8_t> expected = a;
+                pair[0](result.data() + offset, b.data() + offset, length);
+                pair[1](expected.data() + offset, b.data() + offset, length);
+                same = same && result == expected;
+            }
+
+            std::vector<uint8_t> result = a;
+            std::vector<uint8_t> expected = a;
+            kernels.bitwise_not(result.data() + offset, length);
+            scalar_kernels::bitwise_not(expected.data() + offset, length);
+            same = same && result == expected;
+
+            same = same && kernels.popcount(a.data() + offset, length) ==
+                           scalar_kernels::popcount(a.data() + offset, length);
+
+            for (uint32_t shift = 1; shift < 8; ++shift) {
+                std::vector<uint8_t> shifted(length + 1);
+                std::vector<uint8_t> expected_shifted(length + 1);
+                kernels.shift_copy(shifted.data(), a.data() + offset, length, shift);
+                scalar_kernels::shift_copy(expected_shifted.data(), a.data() + offset, length, shift);
+                same = same && shifted == expected_shifted;
+            }
+
+            std::string chars(8 * length, '0');
+            std::string expected_chars(8 * length, '0');
+            kernels.format(&chars[0], a.data() + offset, length, '1', '0');
+            scalar_kernels::format(&expected_chars[0], a.data() + offset, length, '1', '0');
+            same = same && chars == expected_chars;
+
+            std::vector<uint8_t> parsed(length);
+            same = same && kernels.parse(parsed.data(), chars.data(), length);
+            same = same && std::equal(parsed.begin(), parsed.end(), a.begin() + offset);
+            if (length) {
+                chars[random() % chars.size()] = '2';
+                same = same && !kernels.parse(parsed.data(), chars.data(), length);
+            }
+
+            same = same && kernels.equal(a.data() + offset, a.data() + offset, length);
+            same = same && kernels.equal(a.data() + offset, b.data() + offset, length) ==
+                           scalar_kernels::equal(a.data() + offset, b.data() + offset, length);
+            if (length) {
+                std::vector<uint8_t> other = a;
+                other[offset + random() % length] ^= uint8_t(1u << random() % 8);
+                same = same && !kernels.equal(a.data() + offset, other.data() + offset, length);
+            }
+
+            result = a;
+            expected = a;
+            kernels.reverse(result.data() + offset, length);
+            scalar_kernels::reverse(expected.data() + offset, length);
+            same = same && result == expected;
+
+            // Pairs taken from the data so some of them are found, and one that is likely not
+            uint8_t pairs[16];
+            for (uint32_t k = 0; k < 8; ++k) {
+                const uint64_t at = length ? offset + length / 2 + random() % (length / 2 + 1) : 0;
+                pairs[2 * k] = k == 0 ? uint8_t(random()) : a[at];
+                pairs[2 * k + 1] = k == 0 ? uint8_t(random()) : a[at + 1 < a.size() ? at + 1 : at];
+            }
+            same = same && kernels.find_any_pair(a.data() + offset, length, pairs) ==
+                           scalar_kernels::find_any_pair(a.data() + offset, length, pairs);
+
+            const uint64_t count = 5;
+            const std::vector<uint8_t> fingerprints = random_bytes(random, count * length);
+            uint32_t distances[count];
+            uint32_t expected_distances[count];
+            kernels.hamming_distances(a.data() + offset, fingerprints.data(), count, length, distances);
+            scalar_kernels::hamming_distances(a.data() + offset, fingerprints.data(), count, length,
+                                              expected_distances);
+            same = same && std::equal(distances, distances + count, expected_distances);
+        }
+
+        for (uint32_t i = 0; i < 1000; ++i) {
+            const uint64_t value = random();
+            const uint64_t mask = random() & random();
+            same = same && kernels.extract_bits(value, mask) == scalar_kernels::extract_bits(value, mask);
+            same = same && kernels.deposit_bits(value, mask) == scalar_kernels::deposit_bits(value, mask);
+        }
+
+        if (!same)
+            std::cerr << "kernels of level " << cpu_features::level_name(kernels.level) << " differ from scalar\n";
+        CHECK(same);
+    });
+}
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------- Insertion , Erasure ------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+static std::vector<bool> random_bits(std::mt19937_64& random, uint32_t size) {
+    std::vector<bool> bits(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        bits[i] = random() % 2 == 0;
+    }
+    return bits;
+}
+
+template<typename BitOrder>
+static basic_bit_string<BitOrder> from_bools(const std::vector<bool>& bools) {
+    basic_bit_string<BitOrder> bits;
+    for (bool bit : bools) {
+        bits.push_back(bit);
+    }
+    return bits;
+}
+
+template<typename BitOrder>
+static bool same_bits(const basic_bit_string<BitOrder>& bits, const std::vector<bool>& bools) {
+    if (bits.size() != bools.size())
+        return false;
+    for (uint32_t i = 0; i < bits.size(); ++i) {
+        if (bits.at(i) != bools[i])
+            return false;
+    }
+    // The bits after size() are kept zeros
+    return bits.size() % 8 == 0 || (bits.at_byte(bits.size() / 8) & ~BitOrder::head_mask(bits.size() % 8)) == 0;
+}
+
+template<typename BitOrder>
+static void test_insert_erase() {
+    typedef basic_bit_string<BitOrder> string_type;
+    std::mt19937_64 random(31);
+    const uint32_t sizes[] = {0, 1, 7, 8, 9, 63, 64, 65, 200};
+    const uint32_t counts[] = {0, 1, 7, 8, 9, 70};
+
+    bool same = true;
+    for (uint32_t size : sizes) {
+        const uint32_t positions[] = {0, size / 2, size > 3 ? 3u : 0u, size};
+        for (uint32_t position : positions) {
+            for (uint32_t count : counts) {
+                const std::vector<bool> reference = random_bits(random, size);
+                const std::vector<bool> inserted = random_bits(random, count);
+                const bool bit = random() % 2 == 0;
+
+                string_type bits = from_bools<BitOrder>(reference);
+                std::vector<bool> expected = reference;
+                bits.insert(position, from_bools<BitOrder>(inserted));
+                expected.insert(expected.begin() + position, inserted.begin(), inserted.end());
+                same = same && same_bits(bits, expected);
+
+                bits = from_bools<BitOrder>(reference);
+                expected = reference;
+                bits.insert(position, count, bit);
+                expected.insert(expected.begin() + position, count, bit);
+                same = same && same_bits(bits, expected);
+
+                // Erase the bits just inserted, then from the same position with the default length
+                bits.erase(position, count);
+                same = same && same_bits(bits, reference);
+                bits.erase(position);
+                same = same && same_bits(bits, std::vector<bool>(reference.begin(), reference.begin() + position));
+            }
+
+            string_type bits = from_bools<BitOrder>(random_bits(random, size));
+            std::vector<bool> expected;
+            for (uint32_t i = 0; i < size; ++i) {
+                expected.push_back(bits[i]);
+            }
+            bits.insert(position, true);
+            expected.insert(expected.begin() + position, true);
+            same = same && same_bits(bits, expected);
+
+            // Inserting a string into itself inserts a copy of the bits it had before
+            const std::vector<bool> before = expected;
+            bits.insert(position, bits);
+            expected.insert(expected.begin() + position, before.begin(), before.end());
+            same = same && same_bits(bits, expected);
+        }
+    }
+    CHECK(same);
+
+    string_type bits = string_type::from_string("10110");
+    bits.erase(1, 100);
+    CHECK(bits.to_string() == "1");
+    bits.erase(1);
+    CHECK(bits.to_string() == "1");
+    CHECK(throws<std::out_of_range>([&] { bits.insert(2, true); }));
+    CHECK(throws<std::out_of_range>([&] { bits.insert(2, 5, false); }));
+    CHECK(throws<std::out_of_range>([&] { bits.insert(2, string_type::from_string("11")); }));
+    CHECK(throws<std::out_of_range>([&] { bits.erase(2); }));
+    CHECK(bits.to_string() == "1");
+}
+
+static void test_insert_erase() {
+    test_insert_erase<msb_first>();
+    test_insert_erase<lsb_first>();
+}
+
+
+/*====================================================================================================================*/
+/*--------------------------------------------------- Bit Ranges -----------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+template<typename BitOrder>
+static void test_ranges() {
+    typedef basic_bit_string<BitOrder> string_type;
+    std::mt19937_64 random(32);
+    const uint32_t size = 300;
+
+    // Ranges within one byte, ending on a byte, across bytes and words, empty, and the whole string
+    std::vector<std::pair<uint32_t, uint32_t>> ranges = {{3, 4}, {1, 7}, {8, 8}, {5, 11}, {60, 10}, {3, 130},
+                                                         {64, 128}, {0, 0}, {17, 0}, {size, 0}, {0, size}};
+    for (uint32_t i = 0; i < 100; ++i) {
+        const uint32_t position = uint32_t(random() % size);
+        ranges.emplace_back(position, uint32_t(random() % (size - position + 1)));
+    }
+
+    bool same = true;
+    for (const std::pair<uint32_t, uint32_t>& range : ranges) {
+        const uint32_t position = range.first;
+        const uint32_t length = range.second;
+        const std::vector<bool> reference = random_bits(random, size);
+
+        for (int operation = 0; operation < 4; ++operation) {
+            string_type bits = from_bools<BitOrder>(reference);
+            std::vector<bool> expected = reference;
+            for (uint32_t i = position; i < position + length; ++i) {
+                expected[i] = operation == 3 ? !expected[i] : operation == 0;
+            }
+            if (operation == 0)
+                bits.set(position, length);
+            else if (operation == 1)
+                bits.reset(position, length);
+            else if (operation == 2)
+                bits.set(position, length, false);
+            else
+                bits.flip(position, length);
+            same = same && same_bits(bits, expected);
+        }
+    }
+    CHECK(same);
+
+    // The bits after size() stay zeros when a range ends at size()
+    string_type bits(13, false);
+    bits.set(5, 8);
+    CHECK(bits.to_string() == "0000011111111" && bits.count() == 8);
+    bits.flip(0, 13);
+    CHECK(bits.to_string() == "1111100000000" && bits.count() == 5);
+
+    CHECK(throws<std::out_of_range>([&] { bits.set(10, 4); }));
+    CHECK(throws<std::out_of_range>([&] { bits.reset(14, 0); }));
+    CHECK(throws<std::out_of_range>([&] { bits.flip(0, 14); }));
+    CHECK(throws<std::out_of_range>([&] { bits.set(UINT32_MAX, 2); }));
+    CHECK(bits.to_string() == "1111100000000");
+}
+
+static void test_ranges() {
+    test_ranges<msb_first>();
+    test_ranges<lsb_first>();
+}
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------------- Fields -------------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+/**
+ * @return The field of @a number_of_bits at @a position read a bit at a time, its first bit is the most significant
+ *         one for msb_first and the least significant one for lsb_first
+ */
+template<typename BitOrder>
+static uint64_t field_of(const std::vector<bool>& bits, uint32_t position, uint32_t number_of_bits) {
+    uint64_t value = 0;
+    for (uint32_t k = 0; k < number_of_bits; ++k) {
+        const uint32_t shift = std::is_same<BitOrder, msb_first>::value ? number_of_bits - 1 - k : k;
+        value |= uint64_t(bits[position + k]) << shift;
+    }
+    return value;
+}
+
+template<typename BitOrder>
+static void test_fields() {
+    typedef basic_bit_string<BitOrder> string_type;
+    std::mt19937_64 random(33);
+    const uint32_t widths[] = {0, 1, 2, 7, 8, 9, 31, 32, 33, 57, 63, 64};
+
+    bool same = true;
+    for (uint32_t size : {64u, 65u, 71u, 200u}) {
+        for (uint32_t width : widths) {
+            // Fields at every offset within a byte, straddling bytes and ending exactly at size()
+            std::vector<uint32_t> positions = {0, 1, 7, 8, 13, size - width};
+            for (uint32_t i = 0; i < 20; ++i) {
+                positions.push_back(uint32_t(random() % (size - width + 1)));
+            }
+            for (uint32_t position : positions) {
+                if (position + width > size)
+                    continue;
+                std::vector<bool> reference = random_bits(random, size);
+                string_type bits = from_bools<BitOrder>(reference);
+                same = same && bits.get_bits(position, width) == field_of<BitOrder>(reference, position, width);
+
+                // The bits of value above the width are ignored
+                const uint64_t value = random();
+                bits.set_bits(position, width, value);
+                for (uint32_t k = 0; k < width; ++k) {
+                    const uint32_t shift = std::is_same<BitOrder, msb_first>::value ? width - 1 - k : k;
+                    reference[position + k] = (value >> shift) & 1u;
+                }
+                same = same && same_bits(bits, reference);
+                same = same && bits.get_bits(position, width) == (width == 64 ? value : value & ((1ull << width) - 1));
+            }
+        }
+    }
+    CHECK(same);
+
+    string_type bits = string_type::from_string("10100111");
+    CHECK(bits.get_bits(8, 0) == 0);
+    CHECK(throws<std::length_error>([&] { bits.get_bits(0, 65); }));
+    CHECK(throws<std::length_error>([&] { bits.set_bits(0, 65, 0); }));
+    CHECK(throws<std::out_of_range>([&] { bits.get_bits(5, 4); }));
+    CHECK(throws<std::out_of_range>([&] { bits.set_bits(9, 0, 0); }));
+    CHECK(throws<std::out_of_range>([&] { bits.set_bits(1, 8, 0); }));
+    CHECK(bits.to_string() == "10100111");
+}
+
+static void test_fields() {
+    // The examples of the documentation
+    bit_string bits = bit_string::from_string("10100111");
+    CHECK(bits.get_bits(2, 4) == 9);
+    bits.set_bits(2, 4, 6);
+    CHECK(bits.to_string() == "10011011");
+
+    test_fields<msb_first>();
+    test_fields<lsb_first>();
+}
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------- Packed Int Vector --------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+static bool same_elements(const packed_int_vector& vector, const std::vector<uint64_t>& reference) {
+    if (vector.size() != reference.size())
+        return false;
+    bit_string storage;
+    for (uint32_t i = 0; i < reference.size(); ++i) {
+        if (vector[i] != reference[i] || vector.at(i) != reference[i])
+            return false;
+        storage.append_uint_64(reference[i], vector.width());
+    }
+    // The storage is the elements appended with append_uint_64()
+    return vector.bits() == storage;
+}
+
+static void test_packed_int_vector() {
+    std::mt19937_64 random(34);
+
+    // Widths up to 57 are read by a single load, the wider ones through get_bits()
+    bool same = true;
+    for (uint32_t width : {1u, 7u, 13u, 57u, 58u, 63u, 64u}) {
+        const uint64_t max_value = width == 64 ? UINT64_MAX : (1ull << width) - 1;
+        packed_int_vector vector(width);
+        CHECK(vector.max_value() == max_value && vector.empty());
+        std::vector<uint64_t> reference;
+
+        for (uint32_t i = 0; i < 300; ++i) {
+            const uint64_t value = random();
+            vector.push_back(value);
+            reference.push_back(value & max_value);
+        }
+        same = same && same_elements(vector, reference);
+
+        for (uint32_t i = 0; i < 100; ++i) {
+            const uint32_t index = uint32_t(random() % reference.size());
+            const uint64_t value = random();
+            if (i % 2)
+                vector.set(index, value);
+            else
+                vector[index] = value;
+            reference[index] = value & max_value;
+        }
+        same = same && same_elements(vector, reference);
+        same = same && vector.front() == reference.front() && vector.back() == reference.back();
+        same = same && std::equal(vector.begin(), vector.end(), reference.begin());
+
+        // Ranges of every alignment, up to the last element
+        for (uint32_t i = 0; i < 50; ++i) {
+            const uint32_t first = i < 5 ? uint32_t(reference.size()) - i : uint32_t(random() % reference.size());
+            const uint32_t count = uint32_t(random() % (reference.size() - first + 1));
+            std::vector<uint64_t> values(count);
+            vector.unpack(first, count, values.data());
+            same = same && std::equal(values.begin(), values.end(), reference.begin() + first);
+
+            for (uint64_t& value : values) {
+                value = random();
+            }
+            vector.pack(first, count, values.data());
+            for (uint32_t k = 0; k < count; ++k) {
+                reference[first + k] = values[k] & max_value;
+            }
+            same = same && same_elements(vector, reference);
+        }
+
+        std::vector<uint64_t> values(77);
+        for (uint64_t& value : values) {
+            value = random();
+        }
+        vector.append(values.data(), uint32_t(values.size()));
+        for (uint64_t value : values) {
+            reference.push_back(value & max_value);
+        }
+        same = same && same_elements(vector, reference);
+
+        for (uint32_t i = 0; i < 10; ++i) {
+            vector.pop_back();
+            reference.pop_back();
+        }
+        same = same && same_elements(vector, reference);
+
+        const uint64_t fill = random() & max_value;
+        vector.resize(uint32_t(reference.size()) + 45, fill);
+        reference.resize(reference.size() + 45, fill);
+        same = same && same_elements(vector, reference);
+        vector.resize(uint32_t(reference.size()) + 9, max_value);
+        reference.resize(reference.size() + 9, max_value);
+        same = same && same_elements(vector, reference);
+        vector.resize(3);
+        reference.resize(3);
+        same = same && same_elements(vector, reference);
+
+        same = same && same_elements(packed_int_vector(width, 70, fill), std::vector<uint64_t>(70, fill));
+
+        CHECK(throws<std::out_of_range>([&] { vector.at(3); }));
+        CHECK(throws<std::out_of_range>([&] { vector.set(3, 0); }));
+        CHECK(throws<std::out_of_range>([&] { vector.unpack(2, 2, values.data()); }));
+        CHECK(throws<std::out_of_range>([&] { vector.pack(4, 0, values.data()); }));
+        if (!same)
+            std::cerr << "packed_int_vector of width " << width << " differs from std::vector\n";
+    }
+    CHECK(same);
+
+    CHECK(throws<std::length_error>([] { packed_int_vector(0); }));
+    CHECK(throws<std::length_error>([] { packed_int_vector(65); }));
+}
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------- Extract , Deposit --------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+template<typename BitOrder>
+static void test_extract_deposit() {
+    typedef basic_bit_string<BitOrder> string_type;
+    std::mt19937_64 random(35);
+
+    bool same = true;
+    for (uint32_t size : {0u, 1u, 7u, 8u, 63u, 64u, 65u, 130u, 1000u}) {
+        // Empty, sparse, half, dense and full masks
+        for (uint32_t ones_in_16 : {0u, 1u, 8u, 15u, 16u}) {
+            const std::vector<bool> value = random_bits(random, size);
+            const std::vector<bool> target = random_bits(random, size);
+            std::vector<bool> mask(size);
+            for (uint32_t i = 0; i < size; ++i) {
+                mask[i] = random() % 16 < ones_in_16;
+            }
+
+            std::vector<bool> extracted;
+            for (uint32_t i = 0; i < size; ++i) {
+                if (mask[i])
+                    extracted.push_back(value[i]);
+            }
+            const string_type mask_bits = from_bools<BitOrder>(mask);
+            same = same && same_bits(from_bools<BitOrder>(value).extract(mask_bits), extracted);
+
+            const std::vector<bool> deposited_bits = random_bits(random, uint32_t(extracted.size()));
+            std::vector<bool> deposited = target;
+            for (uint32_t i = 0, j = 0; i < size; ++i) {
+                if (mask[i])
+                    deposited[i] = deposited_bits[j++];
+            }
+            string_type bits = from_bools<BitOrder>(target);
+            bits.deposit(mask_bits, from_bools<BitOrder>(deposited_bits));
+            same = same && same_bits(bits, deposited);
+        }
+    }
+    CHECK(same);
+}
+
+static void test_extract_deposit() {
+    // The examples of the documentation
+    const bit_string mask = bit_string::from_string("11000011");
+    CHECK(bit_string::from_string("10110010").extract(mask).to_string() == "1010");
+    bit_string bits(8, false);
+    bits.deposit(mask, bit_string::from_string("1010"));
+    CHECK(bits.to_string() == "10000010");
+
+    CHECK(throws<std::length_error>([&] { bits.extract(bit_string(9, true)); }));
+    CHECK(throws<std::length_error>([&] { bits.deposit(mask, bit_string(3, true)); }));
+    CHECK(throws<std::length_error>([&] { bits.deposit(bit_string(7, true), bit_string(7, true)); }));
+
+    // The scalar kernels, and the PEXT / PDEP ones from the AVX2 level when the CPU has BMI2
+    for_each_level([](const bit_kernels&) {
+        test_extract_deposit<msb_first>();
+        test_extract_deposit<lsb_first>();
+    });
+}
+
+
+/*====================================================================================================================*/
+/*---------------------------------------------------- Reverse -------------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+template<typename BitOrder>
+static void test_reverse() {
+    std::mt19937_64 random(36);
+
+    bool same = true;
+    for (uint32_t size : {0u, 1u, 7u, 8u, 9u, 63u, 64u, 65u, 127u, 4099u, 32768u}) {
+        const std::vector<bool> reference = random_bits(random, size);
+        const std::vector<bool> expected(reference.rbegin(), reference.rend());
+
+        const basic_bit_string<BitOrder> bits = from_bools<BitOrder>(reference);
+        same = same && same_bits(bits.reversed(), expected) && same_bits(bits, reference);
+
+        basic_bit_string<BitOrder> in_place = bits;
+        in_place.reverse();
+        same = same && same_bits(in_place, expected);
+        in_place.reverse();
+        same = same && in_place == bits;
+    }
+    CHECK(same);
+}
+
+static void test_reverse() {
+    CHECK(bit_string::from_string("1101001").reversed().to_string() == "1001011");
+
+    for_each_level([](const bit_kernels&) {
+        test_reverse<msb_first>();
+        test_reverse<lsb_first>();
+    });
+}
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------------- Search -------------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+static std::vector<uint32_t> naive_find_all(const std::vector<bool>& text, const std::vector<bool>& pattern) {
+    std::vector<uint32_t> positions;
+    for (uint64_t position = 0; position + pattern.size() <= text.size(); ++position) {
+        if (std::equal(pattern.begin(), pattern.end(), text.begin() + position))
+            positions.push_back(uint32_t(position));
+    }
+    return positions;
+}
+
+template<typename BitOrder>
+static void test_find() {
+    typedef basic_bit_string<BitOrder> string_type;
+    std::mt19937_64 random(37);
+
+    // Patterns matched by match_block() (under 23 bits), through the pairs of bytes, and longer than a word
+    const uint32_t lengths[] = {1, 2, 5, 8, 13, 22, 23, 24, 31, 40, 64, 65, 100, 200};
+    bool same = true;
+    for (uint32_t length : lengths) {
+        for (uint32_t trial = 0; trial < 6; ++trial) {
+            // Random texts, and texts of runs of zeros with a few ones where the pattern has many occurrences
+            std::vector<bool> text(3000 + random() % 100);
+            for (uint32_t i = 0; i < text.size(); ++i) {
+                text[i] = trial % 2 ? random() % 2 == 0 : random() % 50 == 0;
+            }
+            std::vector<bool> pattern(length);
+            const uint32_t from = uint32_t(random() % (text.size() - length));
+            for (uint32_t i = 0; i < length; ++i) {
+                pattern[i] = trial < 4 ? bool(text[from + i]) : random() % 2 == 0;
+            }
+
+            const string_type bits = from_bools<BitOrder>(text);
+            const string_type pattern_bits = from_bools<BitOrder>(pattern);
+            const std::vector<uint32_t> expected = naive_find_all(text, pattern);
+            same = same && bits.find_all(pattern_bits) == expected;
+
+            for (uint32_t start : {0u, 1u, from, from + 1, uint32_t(random() % text.size()), uint32_t(text.size())}) {
+                const std::vector<uint32_t>::const_iterator next =
+                        std::lower_bound(expected.begin(), expected.end(), start);
+                same = same && bits.find(pattern_bits, start) == (next == expected.end() ? bits.npos : *next);
+
+                const std::vector<uint32_t>::const_iterator previous =
+                        std::upper_bound(expected.begin(), expected.end(), start);
+                same = same && bits.rfind(pattern_bits, start) ==
+                               (previous == expected.begin() ? bits.npos : *(previous - 1));
+            }
+            same = same && bits.rfind(pattern_bits) == (expected.empty() ? bits.npos : expected.back());
+        }
+    }
+    CHECK(same);
+
+    const string_type bits = string_type::from_string("01101101");
+    CHECK(bits.find(string_type::from_string("111111111")) == bits.npos);
+    CHECK(bits.rfind(string_type::from_string("111111111")) == bits.npos);
+    CHECK(bits.find_all(string_type::from_string("111111111")).empty());
+    CHECK(bits.find(bits) == 0 && bits.rfind(bits) == 0 && bits.find_all(bits) == std::vector<uint32_t>{0});
+}
+
+static void test_find() {
+    // The examples of the documentation
+    const bit_string bits = bit_string::from_string("01101101");
+    CHECK(bits.find(bit_string::from_string("11")) == 1 && bits.find(bit_string::from_string("11"), 2) == 4);
+    CHECK(bit_string::from_string("11110").find_all(bit_string::from_string("11")) == std::vector<uint32_t>({0, 1, 2}));
+
+    // The pairs of bytes of the long patterns are searched by the find_any_pair kernel of every level
+    for_each_level([](const bit_kernels&) {
+        test_find<msb_first>();
+        test_find<lsb_first>();
+    });
+}
+
+
+/*====================================================================================================================*/
+/*------------------------------------------------ Hamming , Jaccard -------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+static uint32_t naive_distance(const std::vector<bool>& a, const std::vector<bool>& b) {
+    uint32_t distance = 0;
+    for (uint32_t i = 0; i < a.size(); ++i) {
+        distance += a[i] != b[i];
+    }
+    return distance;
+}
+
+template<typename BitOrder>
+static void test_hamming() {
+    typedef basic_bit_string<BitOrder> string_type;
+    std::mt19937_64 random(38);
+
+    bool same = true;
+    for (uint32_t size : {0u, 1u, 7u, 64u, 65u, 1000u, 2048u * 8 + 3}) {
+        const std::vector<bool> a = random_bits(random, size);
+        std::vector<bool> b = a;
+        for (uint32_t i = 0; size && i < 40; ++i) {
+            b[random() % size] = random() % 2 == 0;
+        }
+        const string_type a_bits = from_bools<BitOrder>(a);
+        const string_type b_bits = from_bools<BitOrder>(b);
+        const uint32_t distance = naive_distance(a, b);
+        same = same && hamming_distance(a_bits, b_bits) == distance;
+        same = same && hamming_distance_at_most(a_bits, b_bits, distance);
+        same = same && (distance == 0 || !hamming_distance_at_most(a_bits, b_bits, distance - 1));
+
+        uint32_t intersection = 0;
+        uint32_t union_count = 0;
+        for (uint32_t i = 0; i < size; ++i) {
+            intersection += a[i] && b[i];
+            union_count += a[i] || b[i];
+        }
+        const double expected = union_count ? double(intersection) / union_count : 1.0;
+        same = same && std::abs(jaccard_similarity(a_bits, b_bits) - expected) < 1e-12;
+    }
+    CHECK(same);
+
+    // Differences on both sides of the edges of the blocks of 256 bytes
+    string_type a(600 * 8, false);
+    string_type b(600 * 8, false);
+    for (uint32_t byte : {255u, 256u, 511u, 512u}) {
+        b.set(byte * 8 + 3, 1);
+    }
+    CHECK(hamming_distance(a, b) == 4);
+    CHECK(hamming_distance_at_most(a, b, 4) && !hamming_distance_at_most(a, b, 3));
+    b.reset(512 * 8 + 3, 1);
+    b.reset(511 * 8 + 3, 1);
+    CHECK(hamming_distance_at_most(a, b, 2) && !hamming_distance_at_most(a, b, 1));
+    b.reset(256 * 8 + 3, 1);
+    CHECK(hamming_distance_at_most(a, b, 1) && !hamming_distance_at_most(a, b, 0));
+    b.reset(255 * 8 + 3, 1);
+    CHECK(hamming_distance_at_most(a, b, 0));
+
+    CHECK(jaccard_similarity(string_type(), string_type()) == 1.0);
+    CHECK(jaccard_similarity(string_type(9, false), string_type(9, false)) == 1.0);
+    CHECK(jaccard_similarity(string_type::from_string("1100"), string_type::from_string("0110")) == 1.0 / 3);
+    CHECK(throws<std::length_error>([] { hamming_distance(string_type(3, false), string_type(4, false)); }));
+    CHECK(throws<std::length_error>([] { hamming_distance_at_most(string_type(3, false), string_type(4, false), 9); }));
+    CHECK(throws<std::length_error>([] { jaccard_similarity(string_type(3, false), string_type(4, false)); }));
+}
+
+template<typename BitOrder>
+static void test_nearest_fingerprints() {
+    std::mt19937_64 random(380);
+    const uint32_t bits = 77;
+    const uint64_t count = 1000;
+
+    // Fingerprints near the query so distances repeat and ties are sorted by index, across batches of 256
+    const std::vector<bool> query = random_bits(random, bits);
+    std::vector<uint8_t> database;
+    std::vector<fingerprint_match> expected;
+    for (uint64_t index = 0; index < count; ++index) {
+        std::vector<bool> fingerprint = query;
+        for (uint32_t i = 0, changes = uint32_t(random() % 12); i < changes; ++i) {
+            fingerprint[random() % bits] = random() % 2 == 0;
+        }
+        const basic_bit_string<BitOrder> fingerprint_bits = from_bools<BitOrder>(fingerprint);
+        const uint8_t* data = fingerprint_bits.data();
+        database.insert(database.end(), data, data + fingerprint_bits.size_in_bytes());
+        expected.push_back({index, naive_distance(query, fingerprint)});
+    }
+    std::sort(expected.begin(), expected.end());
+
+    bool same = true;
+    for (uint32_t k : {0u, 1u, 10u, 300u, 1000u, 5000u}) {
+        const std::vector<fingerprint_match> matches =
+                nearest_fingerprints(from_bools<BitOrder>(query), database.data(), count, k);
+        const uint64_t expected_count = std::min<uint64_t>(k, count);
+        same = same && matches.size() == expected_count;
+        for (uint64_t i = 0; same && i < expected_count; ++i) {
+            same = matches[i].index == expected[i].index && matches[i].distance == expected[i].distance;
+        }
+    }
+    same = same && nearest_fingerprints(from_bools<BitOrder>(query), database.data(), 0, 10).empty();
+    CHECK(same);
+}
+
+static void test_hamming() {
+    for_each_level([](const bit_kernels&) {
+        test_hamming<msb_first>();
+        test_hamming<lsb_first>();
+        test_nearest_fingerprints<msb_first>();
+        test_nearest_fingerprints<lsb_first>();
+    });
+}
+
+
+/*====================================================================================================================*/
+/*--------------------------------------------------- Bit Orders -----------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+static void test_bit_orders() {
+    // The first bit of a byte is its least significant one, and integers are appended least significant bit first
+    lsb_bit_string lsb;
+    lsb.append_uint_16(6, 3);
+    CHECK(lsb.to_string() == "011" && lsb.data()[0] == 0x06);
+    bit_string msb;
+    msb.append_uint_16(6, 3);
+    CHECK(msb.to_string() == "110" && msb.data()[0] == 0xC0);
+
+    const uint8_t bytes[] = {0xAC, 0x02, 0xF0};
+    const lsb_bit_string from_bytes = lsb_bit_string::from_data(bytes, 3);
+    CHECK(from_bytes.to_string() == "001101010100000000001111");
+    CHECK(from_bytes.get_bits(0, 16) == 0x02AC && from_bytes.get_bits(4, 8) == 0x2A);
+    CHECK(from_bytes.get_bits(20, 4) == 0xF && from_bytes.get_bits(3, 1) == 1);
+    CHECK(bit_string::from_data(bytes, 3).get_bits(0, 16) == 0xAC02);
+
+    lsb_bit_string bits = lsb_bit_string::from_string("0110100111");
+    const lsb_bit_string sub = bits.substr(2, 5);
+    CHECK(sub.to_string() == "10100" && sub.data()[0] == 0x05);
+    CHECK(bits.substr(3).to_string() == "0100111" && bits.substr(3).data()[0] == 0x72);
+
+    lsb_bit_string zeros(10, false);
+    zeros.insert(3, lsb_bit_string::from_string("11"));
+    CHECK(zeros.to_string() == "000110000000" && zeros.data()[0] == 0x18 && zeros.data()[1] == 0x00);
+    zeros.insert(0, true);
+    CHECK(zeros.data()[0] == 0x31 && zeros.get_bits(0, 6) == 0x31);
+    zeros.set_bits(8, 5, 0x1F);
+    CHECK(zeros.data()[1] == 0x1F && zeros.to_string() == "1000110011111");
+}
+
+
+/*====================================================================================================================*/
+/*------------------------------------------------- Huffman Code -----------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+template<typename BitOrder>
+static void check_huffman_round_trip(const huffman_code& code, const std::vector<uint16_t>& text) {
+    // The codes start at a bit which is not the first of a byte
+    basic_bit_string<BitOrder> bits = basic_bit_string<BitOrder>::from_string("101");
+    basic_huffman_encoder<BitOrder> encoder(code);
+    encoder.encode(text.data(), text.size(), bits);
+    CHECK(bits.size() == 3 + encoder.encoded_size(text.data(), text.size()));
+
+    std::vector<uint16_t> decoded(text.size());
+    basic_bit_reader<BitOrder> reader(bits, 3);
+    basic_huffman_decoder<BitOrder>(code).read(reader, decoded.data(), decoded.size());
+    CHECK(decoded == text);
+    CHECK(reader.at_end());
+}
+
+static void test_huffman_code() {
+    const uint32_t symbols = 300;
+    std::mt19937_64 random(7);
+    std::geometric_distribution<uint32_t> skewed(0.05);
+    std::vector<uint16_t> text(50000);
+    for (uint16_t& symbol : text) {
+        symbol = uint16_t(std::min(skewed(random), symbols - 1));
+    }
+
+    const std::vector<uint64_t> frequencies = huffman_code::count_frequencies(text.data(), text.size(), symbols);
+    for (uint32_t max_code_length : {9u, 15u, 32u}) {
+        const huffman_code code = huffman_code::from_frequencies(frequencies, max_code_length);
+        CHECK(code.max_code_length() <= max_code_length);
+
+        const huffman_code rebuilt = huffman_code::from_code_lengths(code.code_lengths());
+        bool same = true;
+        for (uint32_t symbol = 0; symbol < symbols; ++symbol) {
+            same = same && rebuilt.code(symbol) == code.code(symbol);
+        }
+        CHECK(same);
+
+        check_huffman_round_trip<msb_first>(code, text);
+        check_huffman_round_trip<lsb_first>(code, text);
+    }
+
+    const huffman_code single = huffman_code::from_frequencies(std::vector<uint64_t>{0, 5, 0});
+    CHECK(single.code_length(1) == 1);
+    check_huffman_round_trip<msb_first>(single, std::vector<uint16_t>(10, 1));
+
+    // An incomplete code, [11] is not a code: the symbols before it are decoded and its slot is left untouched
+    const huffman_code incomplete = huffman_code::from_code_lengths(std::vector<uint8_t>{2, 2});
+    bit_string bits;
+    for (uint32_t i = 0; i < 100; ++i) {
+        bits.append_uint_64(i % 2, 2);
+    }
+    bits.append_uint_64(3, 2);
+    bits.append_uint_64(0, 64);
+    std::vector<uint16_t> decoded(101, 7);
+    bit_reader reader(bits);
+    CHECK(throws<std::logic_error>([&] { huffman_decoder(incomplete).read(reader, decoded.data(), decoded.size()); }));
+    CHECK(decoded[99] == 1 && decoded[100] == 7);
+
+    // The largest alphabet, whose sub tables are at offsets of more than 24 bits
+    const huffman_code largest = huffman_code::from_code_lengths(std::vector<uint8_t>(huffman_code::MAX_SYMBOLS, 24));
+    check_huffman_round_trip<msb_first>(largest, std::vector<uint16_t>{0, 1, 65535});
+    const huffman_decoder largest_decoder(largest);
+    for (uint32_t symbol : {0u, 16000000u, 16777214u, 16777215u}) {
+        bit_string code;
+        code.append_uint_64(largest.code(symbol), 24);
+        bit_reader code_reader(code);
+        CHECK(largest_decoder.read(code_reader) == symbol);
+    }
+}
+
+
+/*====================================================================================================================*/
+/*---------------------------------------------------- Bit Rope ------------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+template<typename BitOrder>
+static bool same_bits(const basic_bit_rope<BitOrder>& rope, const basic_bit_string<BitOrder>& bits) {
+    if (rope.size() != bits.size())
+        return false;
+    for (uint32_t i = 0; i < bits.size(); ++i) {
+        if (rope.at(i) != bits[i] || rope[i] != bits[i])
+            return false;
+    }
+    return rope.flatten() == bits;
+}
+
+template<typename BitOrder>
+static void test_bit_rope() {
+    typedef basic_bit_string<BitOrder> string_type;
+    typedef basic_bit_rope<BitOrder> rope_type;
+    std::mt19937_64 random(42);
+
+    // Every kind of append, the same bits appended to a plain bit_string
+    rope_type rope;
+    string_type expected;
+    for (uint32_t i = 0; i < 60; ++i) {
+        const string_type bits = from_bools<BitOrder>(random_bits(random, uint32_t(random() % 100)));
+        const uint32_t start = uint32_t(random() % (bits.size() + 1));
+        const uint32_t length = uint32_t(random() % (bits.size() - start + 1));
+        switch (i % 5) {
+            case 0:
+                rope.append(bits);
+                expected.append(bits);
+                break;
+            case 1:
+                rope += string_type(bits);
+                expected += bits;
+                break;
+            case 2:
+                rope.append(std::make_shared<const string_type>(bits), start, length);
+                expected.append(bits.substr(start, length));
+                break;
+            case 3:
+                rope += rope_type(bits);
+                expected.append(bits);
+                break;
+            default:
+                // A range of the rope itself
+                const uint32_t first = uint32_t(expected.size() / 3);
+                const uint32_t count = std::min(length, expected.size() - first);
+                rope.append(rope.substr(first, count));
+                expected.append(expected.substr(first, count));
+        }
+    }
+    CHECK(same_bits(rope, expected));
+
+    // Substrings starting and ending inside, on the edges of and across chunks
+    bool same = true;
+    for (uint32_t i = 0; i < 200; ++i) {
+        const uint64_t start = random() % (rope.size() + 1);
+        const uint64_t length = i % 10 ? random() % (rope.size() - start + 1) : rope.size() - start;
+        same = same && same_bits(rope.substr(start, length), expected.substr(uint32_t(start), uint32_t(length)));
+        same = same && (i % 20 || same_bits(rope.substr(start), expected.substr(uint32_t(start))));
+    }
+    CHECK(same);
+
+    // Appending a rope to itself doubles it
+    const string_type before = rope.flatten();
+    rope.append(rope);
+    expected = before;
+    expected.append(before);
+    CHECK(same_bits(rope, expected));
+    rope += rope;
+    expected.append(expected);
+    CHECK(same_bits(rope, expected));
+
+    // A shared range is not copied, the rope only refers to it
+    const std::shared_ptr<const string_type> shared = std::make_shared<const string_type>(string_type(64, true));
+    rope_type ranges;
+    ranges.append(shared, 3, 5);
+    ranges.append(shared, 60, 4);
+    CHECK(ranges.number_of_chunks() == 2 && &ranges.chunk_at(1).bits() == shared.get());
+    CHECK(same_bits(ranges, string_type::from_string("111111111")));
+
+    CHECK(throws<std::out_of_range>([&] { ranges.at(9); }));
+    CHECK(throws<std::out_of_range>([&] { ranges.substr(10); }));
+    CHECK(throws<std::out_of_range>([&] { ranges.substr(4, 6); }));
+    CHECK(throws<std::out_of_range>([&] { ranges.append(shared, 60, 5); }));
+    CHECK(same_bits(rope_type(), string_type()) && rope_type().substr(0, 0).empty());
+}
+
+static void test_bit_rope() {
+    test_bit_rope<msb_first>();
+    test_bit_rope<lsb_first>();
+}
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------- Atomic Bit String --------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+template<typename BitOrder>
+static void test_atomic_bit_string() {
+    typedef basic_atomic_bit_string<BitOrder> atomic_type;
+    const uint32_t size = 200;  // 3 full words and 8 bits of a 4th one
+
+    atomic_type bits(size);
+    CHECK(bits.number_of_words() == 4 && bits.count() == 0);
+    CHECK(!bits.test_and_set(70) && bits.test_and_set(70) && bits.test(70));
+    CHECK(bits.test_and_reset(70) && !bits.test_and_reset(70) && !bits.test(70));
+    CHECK(!bits.test_and_set(size - 1) && bits.count() == 1);
+    CHECK(throws<std::out_of_range>([&] { bits.test_and_set(size); }));
+    CHECK(throws<std::out_of_range>([&] { bits.test_and_reset(size); }));
+
+    // The last word holds the bits [192, 200), a mask may not select the bits after them
+    const uint64_t first_bit = BitOrder::head_mask_64(1);
+    const uint64_t last_word = BitOrder::head_mask_64(8);
+    CHECK(bits.fetch_or(3, last_word) == BitOrder::delay(first_bit, 7));
+    CHECK(bits.load_word(3) == last_word && bits.count() == 8);
+    CHECK(throws<std::out_of_range>([&] { bits.fetch_or(3, BitOrder::delay(first_bit, 8)); }));
+    CHECK(throws<std::out_of_range>([&] { bits.fetch_or(4, first_bit); }));
+    CHECK(bits.fetch_or(0, UINT64_MAX) == 0 && bits.count() == 72);
+
+    // An AND can only reset bits, any mask is accepted
+    CHECK(bits.fetch_and(3, UINT64_MAX) == last_word && bits.load_word(3) == last_word);
+    CHECK(bits.fetch_and(3, first_bit) == last_word && bits.load_word(3) == first_bit);
+    CHECK(throws<std::out_of_range>([&] { bits.fetch_and(4, 0); }));
+
+    CHECK(bits.count(0, 1) == 64 && bits.count(1, 3) == 0 && bits.count(3, 4) == 1 && bits.count(2, 2) == 0);
+    CHECK(bits.count(0, 4) == bits.count() && bits.count() == bits.to_bit_string().count());
+    CHECK(throws<std::out_of_range>([&] { bits.count(0, 5); }));
+    CHECK(throws<std::out_of_range>([&] { bits.count(3, 2); }));
+    bits.clear();
+    CHECK(bits.count() == 0 && atomic_type().count() == 0);
+
+    // Threads setting overlapping positions, two threads per sequence of positions
+    const uint32_t number_of_threads = 4;
+    const uint32_t concurrent_size = 100000;
+    atomic_type concurrent(concurrent_size);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < number_of_threads; ++t) {
+        threads.emplace_back([&concurrent, t] {
+            std::mt19937_64 random(t / 2);
+            for (uint32_t i = 0; i < concurrent_size / 2; ++i) {
+                const uint32_t position = uint32_t(random() % concurrent_size);
+                if (i % 2)
+                    concurrent.set(position, std::memory_order_relaxed);
+                else
+                    concurrent.test_and_set(position, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<bool> reference(concurrent_size);
+    for (uint32_t t = 0; t < number_of_threads; t += 2) {
+        std::mt19937_64 random(t / 2);
+        for (uint32_t i = 0; i < concurrent_size / 2; ++i) {
+            reference[random() % concurrent_size] = true;
+        }
+    }
+    const uint32_t distinct = uint32_t(std::count(reference.begin(), reference.end(), true));
+    CHECK(concurrent.count() == distinct && same_bits(concurrent.to_bit_string(), reference));
+}
+
+static void test_atomic_bit_string() {
+    test_atomic_bit_string<msb_first>();
+    test_atomic_bit_string<lsb_first>();
+}
+
+
+/*====================================================================================================================*/
+/*-------------------------------------------------- Bloom Filter ----------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+static bool contains_all(const blocked_bloom_filter& filter, const std::vector<uint64_t>& keys) {
+    for (uint64_t key : keys) {
+        if (!filter.contains(key))
+            return false;
+    }
+    std::unique_ptr<bool[]> results(new bool[keys.size()]);
+    return filter.contains(keys.data(), keys.size(), results.get()) == keys.size() &&
+           std::all_of(results.get(), results.get() + keys.size(), [](bool result) { return result; });
+}
+
+static void test_bloom_filter() {
+    std::mt19937_64 random(45);
+    std::vector<uint64_t> keys(5000);
+    for (uint64_t& key : keys) {
+        key = random();
+    }
+
+    // No false negatives, with the keys inserted one by one or in batches (not a multiple of the batch size)
+    blocked_bloom_filter single = blocked_bloom_filter::for_keys(keys.size(), 0.01);
+    blocked_bloom_filter batched = blocked_bloom_filter::for_keys(keys.size(), 0.01);
+    for (uint64_t key : keys) {
+        single.insert(key);
+    }
+    batched.insert(keys.data(), keys.size() - 7);
+    batched.insert(keys.data() + keys.size() - 7, 7);
+    CHECK(contains_all(single, keys) && contains_all(batched, keys));
+    CHECK(single.serialize() == batched.serialize() && single.count() > 0);
+
+    // The false positive rate is close to the requested one
+    uint64_t false_positives = 0;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        false_positives += single.contains(random());
+    }
+    CHECK(false_positives < 2000);
+
+    // Copies are at other addresses, their blocks are moved to be aligned again
+    std::vector<blocked_bloom_filter> copies;
+    for (uint32_t i = 0; i < 8; ++i) {
+        copies.push_back(single);
+    }
+    blocked_bloom_filter assigned(64);
+    assigned = copies.back();
+    copies.push_back(std::move(assigned));
+    bool same = true;
+    for (const blocked_bloom_filter& copy : copies) {
+        same = same && contains_all(copy, keys) && copy.serialize() == single.serialize();
+    }
+    CHECK(same);
+
+    const bit_string serialized = single.serialize();
+    const blocked_bloom_filter deserialized = blocked_bloom_filter::deserialize(serialized);
+    CHECK(deserialized.size() == single.size() && deserialized.number_of_hashes() == single.number_of_hashes());
+    CHECK(deserialized.count() == single.count() && contains_all(deserialized, keys));
+
+    CHECK(throws<std::logic_error>([&] { blocked_bloom_filter::deserialize(serialized.substr(0, 39)); }));
+    CHECK(throws<std::logic_error>([&] { blocked_bloom_filter::deserialize(serialized.substr(0, 40)); }));
+    CHECK(throws<std::logic_error>([&] {
+        blocked_bloom_filter::deserialize(serialized.substr(0, serialized.size() - 8));
+    }));
+    bit_string no_blocks = serialized;
+    no_blocks.set_bits(0, 32, 0);
+    CHECK(throws<std::logic_error>([&] { blocked_bloom_filter::deserialize(no_blocks); }));
+    bit_string no_hashes = serialized;
+    no_hashes.set_bits(32, 8, 0);
+    CHECK(throws<std::logic_error>([&] { blocked_bloom_filter::deserialize(no_hashes); }));
+    bit_string too_many_hashes = serialized;
+    too_many_hashes.set_bits(32, 8, blocked_bloom_filter::MAX_HASHES + 1);
+    CHECK(throws<std::logic_error>([&] { blocked_bloom_filter::deserialize(too_many_hashes); }));
+
+    single.clear();
+    CHECK(single.count() == 0 && !single.contains(keys[0]));
+    CHECK(throws<std::length_error>([] { blocked_bloom_filter(512, 0); }));
+    CHECK(throws<std::length_error>([] { blocked_bloom_filter(512, 17); }));
+    CHECK(throws<std::domain_error>([] { blocked_bloom_filter::for_keys(10, 1.0); }));
+}
+
+
+/*====================================================================================================================*/
+/*-------------------------------------------------- Elias-Fano ------------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+static void check_next_geq(const std::vector<uint64_t>& values, uint64_t universe, uint64_t queries_end) {
+    const elias_fano_sequence sequence(values.data(), values.size(), universe);
+    CHECK(sequence.size() == values.size());
+
+    bool same = true;
+    for (uint64_t i = 0; i < values.size(); ++i) {
+        same = same && sequence[i] == values[i];
+    }
+    CHECK(same);
+
+    std::mt19937_64 random(values.size());
+    same = true;
+    for (uint32_t i = 0; i < 20000; ++i) {
+        const uint64_t value = random() % queries_end;
+        const std::vector<uint64_t>::const_iterator expected =
+                std::lower_bound(values.begin(), values.end(), value);
+        const uint64_t next = sequence.next_geq(value);
+        same = same && (expected == values.end() ? next == elias_fano_sequence::npos : next == *expected);
+    }
+    CHECK(same);
+
+    // skip_to() with increasing values, from near and far buckets
+    elias_fano_sequence::const_iterator it = sequence.begin();
+    same = true;
+    for (uint64_t value = 0; value < queries_end; value += 1 + random() % (queries_end / 1000 + 1)) {
+        it.skip_to(value);
+        const std::vector<uint64_t>::const_iterator expected =
+                std::lower_bound(values.begin(), values.end(), value);
+        same = same && (expected == values.end() ? it == sequence.end() : *it == *expected);
+    }
+    CHECK(same);
+
+    std::vector<uint64_t> walked;
+    for (elias_fano_sequence::const_iterator it = sequence.begin(); it != sequence.end(); ++it) {
+        walked.push_back(*it);
+    }
+    CHECK(walked == values);
+}
+
+static void test_elias_fano() {
+    std::mt19937_64 random(3);
+    std::vector<uint64_t> values(20000);
+    for (uint64_t& value : values) {
+        value = random() % 1000000;
+    }
+    std::sort(values.begin(), values.end());
+
+    check_next_geq(values, 0, values.back() + 10);
+    check_next_geq(values, 1ull << 40, 1ull << 40);
+    check_next_geq(values, values.back() + 1000, values.back() + 1000);
+    check_next_geq(std::vector<uint64_t>(), 0, 10);
+    check_next_geq(std::vector<uint64_t>(), 1000, 1000);
+    check_next_geq(std::vector<uint64_t>(100, 5), 0, 10);
+    check_next_geq(std::vector<uint64_t>{0, 1, 2, 3, 4, 5, 6, 7}, 0, 10);
+
+    // The buckets after the one of the last value have no zero in the high bits
+    std::vector<uint64_t> dense;
+    for (uint64_t value = 0; value < 1000; ++value) {
+        dense.push_back(value);
+    }
+    const elias_fano_sequence sparse_universe(dense.data(), dense.size(), 1000000);
+    CHECK(sparse_universe.next_geq(900000) == elias_fano_sequence::npos);
+    CHECK(sparse_universe.next_geq(999) == 999);
+    elias_fano_sequence::const_iterator it = sparse_universe.begin();
+    it.skip_to(500);
+    CHECK(*it == 500);
+    it.skip_to(900000);
+    CHECK(it == sparse_universe.end());
+    check_next_geq(dense, 1000000, 1000000);
+
+    std::vector<uint64_t> evens;
+    std::vector<uint64_t> thirds;
+    for (uint64_t value = 0; value < 30000; value += 2) {
+        evens.push_back(value);
+    }
+    for (uint64_t value = 0; value < 30000; value += 3) {
+        thirds.push_back(value);
+    }
+    std::vector<uint64_t> sixths;
+    for (uint64_t value = 0; value < 30000; value += 6) {
+        sixths.push_back(value);
+    }
+    CHECK(intersection(elias_fano_sequence(evens.data(), evens.size()),
+                       elias_fano_sequence(thirds.data(), thirds.size())) == sixths);
+}
+
+
+/*====================================================================================================================*/
+/*--------------------------------------------------- Bit Matrix -----------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+/**
+ * @return true if the bits (row, column) of @a matrix are @a bits[row][column], and the padding bits of the rows are
+ *         zeros
+ */
+template<typename BitOrder>
+static bool same_bits(const basic_bit_matrix<BitOrder>& matrix, const std::vector<std::vector<bool>>& bits,
+                      uint32_t columns) {
+    if (matrix.number_of_rows() != bits.size() || matrix.number_of_columns() != columns)
+        return false;
+    for (uint32_t row = 0; row < bits.size(); ++row) {
+        for (uint32_t column = 0; column < columns; ++column) {
+            if (matrix.at(row, column) != bits[row][column])
+                return false;
+        }
+        const uint8_t* data = matrix.row(row).data();
+        const uint32_t row_bytes = matrix.words_per_row() * 8;
+        if (columns % 8 && (data[columns / 8] & ~BitOrder::head_mask(columns % 8)))
+            return false;
+        for (uint32_t byte = (columns + 7) / 8; byte < row_bytes; ++byte) {
+            if (data[byte])
+                return false;
+        }
+    }
+    return true;
+}
+
+template<typename BitOrder>
+static void test_bit_matrix() {
+    typedef basic_bit_matrix<BitOrder> matrix_type;
+    std::mt19937_64 random(47);
+
+    bool same = true;
+    for (uint32_t rows : {0u, 1u, 63u, 64u, 65u, 130u}) {
+        for (uint32_t columns : {0u, 1u, 7u, 64u, 100u, 129u}) {
+            std::vector<std::vector<bool>> bits(rows);
+            matrix_type matrix(rows, columns);
+            for (uint32_t row = 0; row < rows; ++row) {
+                bits[row] = random_bits(random, columns);
+                for (uint32_t column = 0; column < columns; ++column) {
+                    matrix.set(row, column, bits[row][column]);
+                }
+            }
+            same = same && same_bits(matrix, bits, columns);
+
+            std::vector<std::vector<bool>> transposed(columns, std::vector<bool>(rows));
+            for (uint32_t row = 0; row < rows; ++row) {
+                for (uint32_t column = 0; column < columns; ++column) {
+                    transposed[column][row] = bits[row][column];
+                }
+            }
+            same = same && same_bits(matrix.transposed(), transposed, rows);
+            same = same && matrix.transposed().transposed() == matrix;
+            for (uint32_t column = 0; column < columns; ++column) {
+                same = same && same_bits(matrix.column(column), transposed[column]);
+            }
+
+            // Slices starting inside a word, ending on the edge of the matrix, empty
+            for (uint32_t first : {0u, 3u, columns / 2, columns}) {
+                if (first > columns)
+                    continue;
+                for (uint32_t count : {0u, 1u, (columns - first) / 2, columns - first}) {
+                    if (first + count > columns)
+                        continue;
+                    std::vector<std::vector<bool>> slice(rows);
+                    for (uint32_t row = 0; row < rows; ++row) {
+                        slice[row].assign(bits[row].begin() + first, bits[row].begin() + first + count);
+                    }
+                    same = same && same_bits(matrix.column_slice(first, count), slice, count);
+                }
+            }
+            if (!same) {
+                std::cerr << "bit_matrix of " << rows << " x " << columns << " differs from the reference\n";
+                break;
+            }
+        }
+    }
+    CHECK(same);
+
+    // Fields of a row up to its last bit leave the padding and the next row unchanged
+    matrix_type matrix(3, 100);
+    std::vector<std::vector<bool>> bits(3, std::vector<bool>(100));
+    for (uint32_t position : {0u, 36u, 50u, 70u, 99u, 100u}) {
+        for (uint32_t width : {0u, 1u, 13u, 30u, 64u}) {
+            if (position + width > 100)
+                continue;
+            const uint64_t value = random();
+            matrix.row(1).set_bits(position, width, value);
+            for (uint32_t k = 0; k < width; ++k) {
+                const uint32_t shift = std::is_same<BitOrder, msb_first>::value ? width - 1 - k : k;
+                bits[1][position + k] = (value >> shift) & 1u;
+            }
+            same = same && matrix.row(1).get_bits(position, width) == field_of<BitOrder>(bits[1], position, width);
+            same = same && same_bits(matrix, bits, 100);
+        }
+    }
+    CHECK(same);
+    CHECK(throws<std::out_of_range>([&] { matrix.row(1).set_bits(90, 11, 0); }));
+    CHECK(throws<std::out_of_range>([&] { matrix.row(1).get_bits(37, 64); }));
+    CHECK(throws<std::out_of_range>([&] { matrix.column(100); }));
+    CHECK(throws<std::out_of_range>([&] { matrix.column_slice(99, 2); }));
+    CHECK(matrix_type(0, 5).transposed().number_of_rows() == 5 && matrix_type(5, 0).column_slice(0, 0).empty());
+}
+
+static void test_bit_matrix() {
+    test_bit_matrix<msb_first>();
+    test_bit_matrix<lsb_first>();
+}
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------------- GF(2) --------------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+typedef std::vector<std::vector<bool>> naive_matrix;
+
+static uint32_t naive_rank(naive_matrix rows) {
+    uint32_t rank = 0;
+    const uint32_t columns = rows.empty() ? 0 : uint32_t(rows[0].size());
+    for (uint32_t column = 0; column < columns && rank < rows.size(); ++column) {
+        uint32_t pivot = rank;
+        while (pivot < rows.size() && !rows[pivot][column]) {
+            ++pivot;
+        }
+        if (pivot == rows.size())
+            continue;
+        std::swap(rows[rank], rows[pivot]);
+        for (uint32_t row = 0; row < rows.size(); ++row) {
+            if (row != rank && rows[row][column]) {
+                for (uint32_t c = 0; c < columns; ++c) {
+                    rows[row][c] = rows[row][c] != rows[rank][c];
+                }
+            }
+        }
+        ++rank;
+    }
+    return rank;
+}
+
+static naive_matrix random_matrix(std::mt19937_64& random, uint32_t rows, uint32_t columns, bit_matrix& matrix) {
+    naive_matrix naive(rows, std::vector<bool>(columns));
+    matrix = bit_matrix(rows, columns);
+    // Sparse rows make dependent rows, and so singular systems, likely
+    const uint64_t density = random() % 4 + 2;
+    for (uint32_t row = 0; row < rows; ++row) {
+        for (uint32_t column = 0; column < columns; ++column) {
+            if (random() % density == 0) {
+                naive[row][column] = true;
+                matrix.set(row, column);
+            }
+        }
+    }
+    return naive;
+}
+
+static void test_gf2() {
+    std::mt19937_64 random(5);
+    const uint32_t sizes[] = {1, 7, 8, 63, 64, 65, 130};
+    for (uint32_t rows : sizes) {
+        for (uint32_t columns : sizes) {
+            bit_matrix a;
+            naive_matrix naive = random_matrix(random, rows, columns, a);
+            CHECK(gf2::rank(a) == naive_rank(naive));
+
+            bit_string b(rows, false);
+            for (uint32_t row = 0; row < rows; ++row) {
+                b[row] = random() % 2 == 0;
+            }
+            naive_matrix augmented = naive;
+            for (uint32_t row = 0; row < rows; ++row) {
+                augmented[row].push_back(b[row]);
+            }
+            const bool solvable = naive_rank(augmented) == naive_rank(naive);
+
+            bit_string x;
+            CHECK(gf2::solve(a, b, x) == solvable);
+            if (solvable) {
+                CHECK(gf2::multiply(a, x) == b);
+            }
+
+            bit_matrix c;
+            random_matrix(random, columns, 9, c);
+            const bit_matrix product = gf2::multiply(a, c);
+            bool same = product.number_of_rows() == rows && product.number_of_columns() == 9;
+            for (uint32_t row = 0; same && row < rows; ++row) {
+                for (uint32_t column = 0; column < 9; ++column) {
+                    bool bit = false;
+                    for (uint32_t k = 0; k < columns; ++k) {
+                        bit = bit != (a.at(row, k) && c.at(k, column));
+                    }
+                    same = same && product.at(row, column) == bit;
+                }
+            }
+            CHECK(same);
+        }
+    }
+
+    // Matrices without columns or rows
+    const bit_matrix tall(5, 0);
+    const bit_matrix product = gf2::multiply(bit_matrix(3, 5), tall);
+    CHECK(product.number_of_rows() == 3 && product.number_of_columns() == 0);
+    CHECK(gf2::multiply(bit_matrix(0, 5), bit_matrix(5, 4)).number_of_rows() == 0);
+    CHECK(gf2::multiply(tall, bit_string()) == bit_string(5, false));
+    CHECK(gf2::rank(tall) == 0 && gf2::rank(bit_matrix(0, 9)) == 0);
+
+    bit_string x = bit_string::from_string("1");
+    CHECK(gf2::solve(tall, bit_string(5, false), x) && x.empty());
+    CHECK(!gf2::solve(tall, bit_string::from_string("00100"), x));
+}
+
+
+/*====================================================================================================================*/
+/*------------------------------------------------------ CRC ---------------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+static void test_crc() {
+    const char* check = "123456789";
+    CHECK(crc_engine(CRC_8_SMBUS).compute(check, 9) == 0xF4);
+    CHECK(crc_engine(CRC_16_ARC).compute(check, 9) == 0xBB3D);
+    CHECK(crc_engine(CRC_16_IBM_3740).compute(check, 9) == 0x29B1);
+    CHECK(crc_engine(CRC_16_KERMIT).compute(check, 9) == 0x2189);
+    CHECK(crc_engine(CRC_32_ISO_HDLC).compute(check, 9) == 0xCBF43926);
+    CHECK(crc_engine(CRC_32_ISCSI).compute(check, 9) == 0xE3069283);
+    CHECK(crc_engine(CRC_32_BZIP2).compute(check, 9) == 0xFC891918);
+    CHECK(crc_engine(CRC_64_ECMA_182).compute(check, 9) == 0x6C40DF5F0B497347ull);
+    CHECK(crc_engine(CRC_64_XZ).compute(check, 9) == 0x995DC9BBDF1939FAull);
+
+    // Long buffers are folded, compare them with the same bytes fed one at a time through the tables
+    std::mt19937_64 random(11);
+    std::vector<uint8_t> data(1000);
+    for (uint8_t& byte : data) {
+        byte = uint8_t(random());
+    }
+    for (const crc_parameters& parameters : {CRC_32_ISO_HDLC, CRC_32_BZIP2, CRC_64_XZ, CRC_16_IBM_3740}) {
+        const crc_engine crc(parameters);
+        uint64_t crc_register = crc.initial();
+        for (uint8_t byte : data) {
+            crc_register = crc.update(crc_register, &byte, 1);
+        }
+        CHECK(crc.compute(data.data(), data.size()) == crc.finish(crc_register));
+    }
+
+    // Bits of a bit_string that is not a whole number of bytes
+    const crc_engine crc(CRC_32_BZIP2);
+    bit_string bits = bit_string::from_string("1011001110001111010");
+    uint64_t crc_register = crc.initial();
+    for (uint32_t i = 0; i < bits.size(); ++i) {
+        crc_register = crc.update_bit(crc_register, bits[i]);
+    }
+    CHECK(crc.compute(bits) == crc.finish(crc_register));
+}
+
+
+/*====================================================================================================================*/
+/*----------------------------------------------------- Sorting ------------------------------------------------------*/
+/*====================================================================================================================*/
+
+
+template<typename BitOrder>
+static void test_bit_string_sort() {
+    typedef basic_bit_string<BitOrder> string_type;
+    std::mt19937_64 random(50);
+
+    // Prefixes of 0, 64 and 128 bits shared by many strings, whose keys are equal for one or two words, and strings
+    // which are prefixes of others
+    std::vector<string_type> prefixes;
+    for (uint32_t length : {0u, 64u, 64u, 128u, 128u, 3u}) {
+        prefixes.push_back(from_bools<BitOrder>(random_bits(random, length)));
+    }
+    std::vector<string_type> strings;
+    for (uint32_t i = 0; i < 20000; ++i) {
+        string_type bits = prefixes[random() % prefixes.size()];
+        bits.append(from_bools<BitOrder>(random_bits(random, uint32_t(random() % (i % 10 ? 20 : 150)))));
+        strings.push_back(bits);
+        if (i % 7 == 0)
+            strings.push_back(bits.substr(0, uint32_t(random() % (bits.size() + 1))));
+    }
+    strings.insert(strings.end(), prefixes.begin(), prefixes.end());
+
+    std::vector<string_type> expected = strings;
+    std::stable_sort(expected.begin(), expected.end(), bit_string_sort::less());
+    for (uint32_t threads : {1u, 4u, 0u}) {
+        std::vector<string_type> sorted = strings;
+        bit_string_sort::sort(sorted, threads);
+        CHECK(sorted == expected);
+    }
+
+    bool same = true;
+    const std::vector<uint32_t> prefix_lengths = bit_string_sort::longest_common_prefixes(expected);
+    for (uint32_t i = 1; i < expected.size(); ++i) {
+        uint32_t length = 0;
+        while (length < expected[i].size() && length < expected[i - 1].size() &&
+               expected[i][length] == expected[i - 1][length]) {
+            ++length;
+        }
+        same = same && prefix_lengths[i] == length;
+    }
+    CHECK(same && prefix_lengths[0] == 0);
+
+    // The example of the documentation
+    std::vector<string_type> keys;
+    for (const char* key : {"1", "011", "00", "010", "0"}) {
+        keys.push_back(string_type::from_string(key));
+    }
+    bit_string_sort::sort(keys);
+    std::vector<std::string> texts;
+    for (const string_type& key : keys) {
+        texts.push_back(key.to_string());
+    }
+    CHECK(texts == std::vector<std::string>({"0", "00", "010", "011", "1"}));
+    CHECK(bit_string_sort::longest_common_prefixes(keys) == std::vector<uint32_t>({0, 1, 1, 2, 0}));
+
+    const std::vector<prefix_group> groups = bit_string_sort::group_by_prefix(keys, 2);
+    const uint64_t firsts[] = {0, 1, 2, 4};
+    const uint64_t counts[] = {1, 1, 2, 1};
+    const uint32_t lengths[] = {1, 2, 2, 1};
+    CHECK(groups.size() == 4);
+    for (uint32_t i = 0; i < groups.size() && i < 4; ++i) {
+        CHECK(groups[i].first == firsts[i] && groups[i].count == counts[i] && groups[i].prefix_length == lengths[i]);
+    }
+
+    std::swap(keys[1], keys[2]);
+    CHECK(throws<std::domain_error>([&] { bit_string_sort::longest_common_prefixes(keys); }));
+    CHECK(throws<std::domain_error>([&] { bit_string_sort::group_by_prefix(keys, 2); }));
+}
+
+static void test_bit_string_sort() {
+    test_bit_string_sort<msb_first>();
+    test_bit_string_sort<lsb_first>();
+}
+
+
+/*====================================================================================================================*/
+
+
+int main() {
+    test_integer_codes();
+    test_static_bit_string();
+    test_shared_bit_string();
+    test_kernels();
+    test_insert_erase();
+    test_ranges();
+    test_fields();
+    test_packed_int_vector();
+    test_extract_deposit();
+    test_reverse();
+    test_find();
+    test_hamming();
+    test_bit_orders();
+    test_huffman_code();
+    test_bit_rope();
+    test_atomic_bit_string();
+    test_bloom_filter();
+    test_elias_fano();
+    test_bit_matrix();
+    test_gf2();
+    test_crc();
+    test_bit_string_sort();
+
+    if (failures) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "All checks passed\n";
     return 0;
-}
\ No newline at end of file
+}